@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+Benchmark driver for the clique finding toolkit.
+
+Runs the program over a grid of datasets, worker counts, help request thresholds and engines, repeats every
+configuration, and checks the total number of cliques of every run against the reference counts in bench/reference.tsv.
+The median and variance of the running time of every configuration are written as CSV or JSON, together with the
+speedup and parallel efficiency.
+
+Workers are either MPI processes (-n), run under mpirun, or threads of a single process (-T), run with the threads
+transport.
+
+Strong scaling (default): every dataset is run with every worker count, and speedup is relative to the smallest worker
+count of the same dataset, transport, threshold and engine.
+
+Weak scaling (--weak): the i-th dataset is run with the i-th worker count of each transport only, so that the problem
+size grows with the number of workers, and efficiency is the time of the first dataset divided by the time of each other
+dataset.
+
+Example:
+	python3 bench/bench.py -d hamsterster caida -n 1 2 4 -T 1 2 4 -e master:"-b master" rma:"-b rma" -r 5 -o log/bench.csv
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import time
+
+BENCH_DIR = os.path.dirname( os.path.abspath( __file__ ) )
+ROOT_DIR = os.path.dirname( BENCH_DIR )
+
+
+def read_references( path ):
+	"""
+	Read the reference clique counts per dataset, as tab-separated dataset ID and total number of cliques.
+	"""
+	references = {}
+
+	with open( path ) as fh:
+		for line in fh:
+			line = line.strip()
+
+			if line == "" or line.startswith( "#" ):
+				continue
+
+			dataset, count = line.split( "\t" )[:2]
+			references[ dataset ] = int( count )
+
+	return references
+
+
+def parse_engine( spec ):
+	"""
+	Parse an engine specification "name:arguments" into its name and list of program arguments.
+	"""
+	name, _, args = spec.partition( ":" )
+
+	return name, args.split()
+
+
+def run_once( args, dataset, transport, num_workers, threshold, engine_args ):
+	"""
+	Run the program once with the given number of MPI processes or threads and return the total number of cliques and
+	the running time it reports.
+	"""
+	command = [ args.program, "-d", dataset, "-v", "0", "-t", str( threshold ) ] + engine_args
+
+	if transport == "threads":
+		command += [ "-transport", "threads", "-threads", str( num_workers ) ]
+	else:
+		command = args.mpirun.split() + [ "-np", str( num_workers ) ] + command
+
+	start = time.time()
+	result = subprocess.run( command, cwd=ROOT_DIR, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True, timeout=args.timeout )
+	wall_time = time.time() - start
+
+	count = re.search( r"Total number of cliques: (\d+)", result.stdout )
+	seconds = re.search( r"([\d.]+) seconds past", result.stdout )
+
+	if result.returncode != 0 or count is None:
+		raise RuntimeError( "Run failed: %s\n%s" % ( " ".join( command ), result.stdout ) )
+
+	return int( count.group( 1 ) ), float( seconds.group( 1 ) ) if seconds else wall_time
+
+
+def main():
+	parser = argparse.ArgumentParser( description="Benchmark the clique finding toolkit." )
+	parser.add_argument( "-d", "--datasets", nargs="+", default=[ "lesmis", "hamsterster", "caida" ], help="dataset IDs in data/input" )
+	parser.add_argument( "-n", "--processes", nargs="*", type=int, default=[ 1, 2, 4 ], help="numbers of MPI processes, none to only run threads" )
+	parser.add_argument( "-T", "--threads", nargs="*", type=int, default=[], help="numbers of threads of a single process with the threads transport" )
+	parser.add_argument( "-t", "--thresholds", nargs="+", type=int, default=[ 0 ], help="help request thresholds (0: automatic)" )
+	parser.add_argument( "-e", "--engines", nargs="+", default=[ "default:" ], help="engines as name:\"program arguments\", e.g. edge:\"-r edge\"" )
+	parser.add_argument( "-r", "--repeats", type=int, default=3, help="number of runs per configuration" )
+	parser.add_argument( "-w", "--weak", action="store_true", help="weak scaling: pair the i-th dataset with the i-th process count" )
+	parser.add_argument( "-o", "--output", default="log/bench.csv", help="output file, written as JSON if it ends in .json and as CSV otherwise" )
+	parser.add_argument( "--reference", default=os.path.join( BENCH_DIR, "reference.tsv" ), help="reference clique counts" )
+	parser.add_argument( "--program", default="./main", help="program to benchmark" )
+	parser.add_argument( "--mpirun", default="mpirun --oversubscribe", help="MPI launcher command" )
+	parser.add_argument( "--timeout", type=int, default=3600, help="timeout per run in seconds" )
+	args = parser.parse_args()
+
+	transports = [ ( transport, counts ) for transport, counts in [ ( "mpi", args.processes ), ( "threads", args.threads ) ] if len( counts ) > 0 ]
+
+	if len( transports ) == 0:
+		parser.error( "no process or thread counts given" )
+
+	if args.weak and any( len( args.datasets ) != len( counts ) for transport, counts in transports ):
+		parser.error( "weak scaling requires as many datasets as process or thread counts" )
+
+	references = read_references( args.reference )
+	engines = [ parse_engine( spec ) for spec in args.engines ]
+
+	runs = []
+
+	for transport, counts in transports:
+		if args.weak:
+			runs += [ ( dataset, transport, num_workers ) for dataset, num_workers in zip( args.datasets, counts ) ]
+		else:
+			runs += [ ( dataset, transport, num_workers ) for dataset in args.datasets for num_workers in counts ]
+
+	rows = []
+	num_failed = 0
+
+	for engine_name, engine_args in engines:
+		for threshold in args.thresholds:
+			for dataset, transport, num_workers in runs:
+				times = []
+				counts = set()
+
+				for repeat in range( args.repeats ):
+					count, seconds = run_once( args, dataset, transport, num_workers, threshold, engine_args )
+					times.append( seconds )
+					counts.add( count )
+
+				# Check the clique counts of all runs against the reference, if there is one
+				if dataset not in references:
+					check = "unknown"
+				elif counts == { references[ dataset ] }:
+					check = "ok"
+				else:
+					check = "FAILED"
+					num_failed += 1
+
+				row = {
+					"engine": engine_name,
+					"dataset": dataset,
+					"transport": transport,
+					"workers": num_workers,
+					"threshold": threshold,
+					"repeats": args.repeats,
+					"cliques": max( counts ),
+					"check": check,
+					"time_median": statistics.median( times ),
+					"time_variance": statistics.variance( times ) if len( times ) > 1 else 0.0,
+					"time_min": min( times ),
+					"time_max": max( times ),
+				}
+				rows.append( row )
+
+				print( "%-10s %-16s %-7s n=%-3d t=%-4d %10.5f s (var %.5f) %s" % ( engine_name, dataset, transport, num_workers, threshold, row[ "time_median" ], row[ "time_variance" ], check ) )
+				sys.stdout.flush()
+
+	# Speedup and efficiency relative to the run with the fewest workers in the same series, in which only the number of
+	# processes or threads varies
+	for row in rows:
+		series = [ other for other in rows if other[ "engine" ] == row[ "engine" ] and other[ "transport" ] == row[ "transport" ] and other[ "threshold" ] == row[ "threshold" ] and ( args.weak or other[ "dataset" ] == row[ "dataset" ] ) ]
+		base = min( series, key=lambda other: other[ "workers" ] )
+
+		if args.weak:
+			row[ "speedup" ] = base[ "time_median" ] / row[ "time_median" ] * row[ "workers" ] / base[ "workers" ]
+			row[ "efficiency" ] = base[ "time_median" ] / row[ "time_median" ]
+		else:
+			row[ "speedup" ] = base[ "time_median" ] / row[ "time_median" ]
+			row[ "efficiency" ] = row[ "speedup" ] * base[ "workers" ] / row[ "workers" ]
+
+	# Write results
+	if os.path.dirname( args.output ) != "":
+		os.makedirs( os.path.dirname( args.output ), exist_ok=True )
+
+	with open( args.output, "w" ) as fh:
+		if args.output.endswith( ".json" ):
+			json.dump( rows, fh, indent=1 )
+		else:
+			writer = csv.DictWriter( fh, fieldnames=list( rows[0].keys() ) )
+			writer.writeheader()
+			writer.writerows( rows )
+
+	print( "Results written to %s" % args.output )
+
+	if num_failed > 0:
+		print( "%d configurations produced clique counts differing from the reference" % num_failed )
+		sys.exit( 1 )
+
+
+if __name__ == "__main__":
+	main()
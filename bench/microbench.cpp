@@ -0,0 +1,464 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#include <stdio.h>
+
+// OS-dependent includes
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
+// Program includes
+#include "../lib/Graph/Graph.h"
+#include "../lib/Graph/NodeOrder.h"
+#include "../lib/CliqueFinder/CliqueFinder.h"
+
+/**
+ * Kernel-level microbenchmark of the clique finding hot paths, without MPI. Measures edge checks, neighbourhood
+ * intersections, candidate set construction and the clique search on ego networks extracted from a dataset, using a
+ * fixed random seed, and compares the time per operation against a baseline.
+ *
+ * Usage: microbench [-d dataset_id] [-f file_path] [-b baseline_file] [-u 1] [-r max_regression] [-s seed] [-o order]
+ *   -u 1  Write the measured times to the baseline file instead of comparing against it
+ *   -r    Maximum allowed increase of the time per operation compared to the baseline, as a fraction (default 0.25)
+ *   -o    Renumber the nodes in this order (degree, rcm or gorder) first; benchmarks are then named after the dataset
+ *         and the order, so that they are compared against their own baseline
+ */
+
+// Allocation counting
+// ==========
+// The replacement operators below pair malloc() with free(), which GCC mistakes for mismatched allocation functions
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static long long num_allocations = 0;
+
+void *operator new( size_t size ) {
+	num_allocations++;
+	void *ptr = malloc( size ? size : 1 );
+
+	if ( ptr == NULL ) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void operator delete( void *ptr ) noexcept {
+	free( ptr );
+}
+
+void operator delete( void *ptr, size_t size ) noexcept {
+	free( ptr );
+}
+
+/**
+ * Get the current value of the CPU time stamp counter, or 0 if it is not available
+ *
+ * @return long long Number of cycles
+ */
+long long getCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Open a counter of the last-level cache misses of this process, counting from when it is opened
+ *
+ * @return int File descriptor of the counter, or -1 if hardware counters are not available
+ */
+int openCacheMissCounter() {
+#ifdef __linux__
+	perf_event_attr attr;
+	memset( &attr, 0, sizeof( attr ) );
+	attr.size = sizeof( attr );
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	return syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+#else
+	return -1;
+#endif
+}
+
+/**
+ * Get the current value of a counter opened by openCacheMissCounter()
+ *
+ * @param int fd File descriptor of the counter
+ * @return long long Number of events counted, or 0 if the counter is not available
+ */
+long long readCounter( int fd ) {
+	long long value = 0;
+
+#ifdef __linux__
+	if ( fd < 0 || read( fd, &value, sizeof( value ) ) != sizeof( value ) ) {
+		return 0;
+	}
+#endif
+
+	return value;
+}
+
+/**
+ * Last-level cache miss counter shared by all benchmarks
+ */
+static int cache_miss_counter = -1;
+
+/**
+ * Result of a single benchmark
+ */
+struct BenchmarkResult {
+	std::string name;
+	long long num_ops;
+	double ns_per_op;
+	double allocations_per_op;
+	double cycles_per_op;
+	double cache_misses_per_op;
+};
+
+/**
+ * Run a benchmark several times and keep the fastest run, to reduce the influence of other load on the machine
+ *
+ * @param std::string name Benchmark name
+ * @param long long num_ops Number of operations performed by a single call of the benchmark function
+ * @param Function function Benchmark function
+ * @return BenchmarkResult Measured cost per operation
+ */
+template <typename Function>
+BenchmarkResult runBenchmark( std::string name, long long num_ops, Function function ) {
+	const int num_repeats = 7;
+	BenchmarkResult result = { name, num_ops, 0, 0, 0, 0 };
+
+	for ( int i = 0; i < num_repeats; i++ ) {
+		long long allocations_start = num_allocations;
+		long long cache_misses_start = readCounter( cache_miss_counter );
+		long long cycles_start = getCycles();
+		auto time_start = std::chrono::steady_clock::now();
+
+		function();
+
+		double ns = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - time_start ).count();
+		double cycles = getCycles() - cycles_start;
+		double cache_misses = readCounter( cache_miss_counter ) - cache_misses_start;
+		double allocations = num_allocations - allocations_start;
+
+		if ( i == 0 || ns / num_ops < result.ns_per_op ) {
+			result.ns_per_op = ns / num_ops;
+			result.cycles_per_op = cycles / num_ops;
+			result.cache_misses_per_op = cache_misses / num_ops;
+			result.allocations_per_op = allocations / num_ops;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Get command-line argument to program run.
+ *
+ * @param std::string arg Argument name (should be preceeded by a dash in the command line)
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+std::string getCommandArg( std::string arg, int argc, char* argv[] ) {
+	for ( int i = 1; i + 1 < argc; i += 1 ) {
+		if ( argv[ i ] == "-" + arg ) {
+			return argv[ i + 1 ];
+		}
+	}
+
+	return "";
+}
+
+int main( int argc, char* argv[] ) {
+	// Settings
+	std::string dataset_name = getCommandArg( "d", argc, argv );
+	std::string input_fname = getCommandArg( "f", argc, argv );
+	std::string baseline_fname = getCommandArg( "b", argc, argv );
+	bool update_baseline = ( getCommandArg( "u", argc, argv ) == "1" );
+	double max_regression = getCommandArg( "r", argc, argv ) != "" ? atof( getCommandArg( "r", argc, argv ).c_str() ) : 0.25;
+	unsigned int seed = getCommandArg( "s", argc, argv ) != "" ? atoi( getCommandArg( "s", argc, argv ).c_str() ) : 42;
+	std::string order_name = getCommandArg( "o", argc, argv );
+
+	if ( dataset_name == "" ) {
+		dataset_name = "hamsterster";
+	}
+
+	if ( input_fname == "" ) {
+		input_fname = "data/input/" + dataset_name + ".tsv";
+	}
+
+	if ( baseline_fname == "" ) {
+		baseline_fname = "bench/microbench_baseline.tsv";
+	}
+
+	// Read graph and construct the sorted neighbour lists and higher-ID neighbour lists (N+) of all nodes
+	Graph graph;
+
+	if ( ! graph.readEdgeList( input_fname ) ) {
+		return 1;
+	}
+
+	// Renumber the nodes, so that the benchmarks run on the memory layout of the search with this order
+	int order = NodeOrder::parse( order_name );
+
+	if ( order == -1 ) {
+		printf( "ERROR: Unknown node order '%s'.\n", order_name.c_str() );
+		return 1;
+	}
+
+	if ( order != NODE_ORDER_NONE ) {
+		NodeOrder::apply( &graph, order, true );
+		dataset_name += "-" + order_name;
+	}
+
+	std::vector<std::pair<int, int> > edges;
+	std::map<int, std::vector<int> > neighbours;
+	std::map<int, std::vector<int> > forwardlist;
+
+	for ( const auto &edge : graph.getEdgeList() ) {
+		neighbours[ edge.first ].push_back( edge.second );
+
+		if ( edge.first < edge.second ) {
+			edges.push_back( edge );
+			forwardlist[ edge.first ].push_back( edge.second );
+		}
+	}
+
+	std::sort( edges.begin(), edges.end() );
+
+	for ( auto &node : neighbours ) {
+		std::sort( node.second.begin(), node.second.end() );
+	}
+
+	for ( auto &node : forwardlist ) {
+		std::sort( node.second.begin(), node.second.end() );
+	}
+
+	std::vector<int> nodes;
+
+	for ( const auto &node : neighbours ) {
+		nodes.push_back( node.first );
+	}
+
+	std::vector<int> forward_nodes;
+
+	for ( const auto &node : forwardlist ) {
+		if ( node.second.size() > 1 ) {
+			forward_nodes.push_back( node.first );
+		}
+	}
+
+	printf( "Dataset %s: %d nodes, %d edges\n", dataset_name.c_str(), graph.getNumNodes(), graph.getNumEdges() );
+
+	cache_miss_counter = openCacheMissCounter();
+
+	if ( cache_miss_counter < 0 ) {
+		printf( "Hardware cache miss counters are not available; LLC misses are not reported.\n" );
+	}
+
+	std::mt19937 rng( seed );
+	std::vector<BenchmarkResult> results;
+	long long checksum = 0;
+
+	// Edge checks: half of the node pairs are edges, the other half random node pairs
+	const int num_edge_checks = 1000000;
+	std::vector<std::pair<int, int> > node_pairs;
+
+	for ( int i = 0; i < num_edge_checks; i++ ) {
+		if ( i % 2 == 0 ) {
+			node_pairs.push_back( edges[ rng() % edges.size() ] );
+		}
+		else {
+			node_pairs.push_back( std::make_pair( nodes[ rng() % nodes.size() ], nodes[ rng() % nodes.size() ] ) );
+		}
+	}
+
+	results.push_back( runBenchmark( "isedge", num_edge_checks, [&]() {
+		for ( const auto &node_pair : node_pairs ) {
+			checksum += graph.isEdge( node_pair.first, node_pair.second );
+		}
+	} ) );
+
+	// Neighbourhood intersections: the candidate set of an edge root, N+(u) and N+(v)
+	const int num_intersections = 100000;
+	std::vector<std::pair<int, int> > root_edges;
+
+	for ( int i = 0; i < num_intersections; i++ ) {
+		root_edges.push_back( edges[ rng() % edges.size() ] );
+	}
+
+	results.push_back( runBenchmark( "intersection", num_intersections, [&]() {
+		for ( const auto &edge : root_edges ) {
+			const std::vector<int> &forward_first = forwardlist[ edge.first ];
+			const std::vector<int> &forward_second = forwardlist[ edge.second ];
+
+			std::vector<int> potential_nodes;
+			std::set_intersection( forward_first.begin(), forward_first.end(), forward_second.begin(), forward_second.end(), std::back_inserter( potential_nodes ) );
+			checksum += potential_nodes.size();
+		}
+	} ) );
+
+	// Candidate set construction: extend a random candidate of a node root, as in the inner loop of the search
+	const int num_constructions = 100000;
+	std::vector<std::pair<int, int> > root_candidates;
+
+	for ( int i = 0; i < num_constructions; i++ ) {
+		int node_id = forward_nodes[ rng() % forward_nodes.size() ];
+		root_candidates.push_back( std::make_pair( node_id, rng() % forwardlist[ node_id ].size() ) );
+	}
+
+	results.push_back( runBenchmark( "candidates", num_constructions, [&]() {
+		for ( const auto &root_candidate : root_candidates ) {
+			const std::vector<int> &potential_nodes = forwardlist[ root_candidate.first ];
+			std::vector<int> new_potential_nodes;
+
+			for ( unsigned int j = root_candidate.second + 1; j < potential_nodes.size(); j++ ) {
+				if ( graph.isEdge( potential_nodes[ root_candidate.second ], potential_nodes[ j ] ) ) {
+					new_potential_nodes.push_back( potential_nodes[ j ] );
+				}
+			}
+
+			checksum += new_potential_nodes.size();
+		}
+	} ) );
+
+	// Clique search on the ego networks (a node, its neighbours, and all edges between them) of random nodes
+	const int num_ego_networks = 200;
+	std::vector<Graph> ego_networks( num_ego_networks );
+
+	for ( int i = 0; i < num_ego_networks; i++ ) {
+		int node_id = nodes[ rng() % nodes.size() ];
+		std::vector<int> ego_nodes = neighbours[ node_id ];
+		ego_nodes.push_back( node_id );
+
+		std::set<int> ego_node_set( ego_nodes.begin(), ego_nodes.end() );
+
+		for ( int ego_node_id : ego_nodes ) {
+			for ( int neighbour_id : neighbours[ ego_node_id ] ) {
+				if ( ego_node_id < neighbour_id && ego_node_set.count( neighbour_id ) > 0 ) {
+					ego_networks[ i ].addEdge( ego_node_id, neighbour_id );
+				}
+			}
+		}
+	}
+
+	results.push_back( runBenchmark( "dfs", num_ego_networks, [&]() {
+		for ( auto &ego_network : ego_networks ) {
+			CliqueFinder cliquefinder( NULL, &ego_network );
+			cliquefinder.initParallelComputation( 0, 1, false );
+			cliquefinder.findAllCliquesDFS();
+
+			for ( long long count : cliquefinder.getCliquesCountsVector() ) {
+				checksum += count;
+			}
+		}
+	} ) );
+
+	// Search of the whole graph for cliques of up to four nodes, in which the order of the nodes determines both the
+	// higher-ID neighbours of every node and the memory locality of the edge checks
+	results.push_back( runBenchmark( "search", 1, [&]() {
+		CliqueFinder cliquefinder( NULL, &graph );
+		cliquefinder.initParallelComputation( 0, 1, false );
+		cliquefinder.setCliqueSizeRange( 0, 4 );
+		cliquefinder.findAllCliquesDFS();
+
+		for ( long long count : cliquefinder.getCliquesCountsVector() ) {
+			checksum += count;
+		}
+	} ) );
+
+	// Read baseline
+	std::map<std::string, double> baseline;
+	std::ifstream fh_baseline( baseline_fname );
+
+	for ( std::string row; std::getline( fh_baseline, row ); ) {
+		std::istringstream row_fields( row );
+		std::string name;
+		double ns_per_op;
+
+		if ( row != "" && row[0] != '#' && row_fields >> name >> ns_per_op ) {
+			baseline[ name ] = ns_per_op;
+		}
+	}
+
+	// Report results, and compare them against the baseline
+	int num_regressions = 0;
+
+	printf( "%-28s %10s %12s %12s %12s %12s %12s %9s\n", "benchmark", "ops", "ns/op", "allocs/op", "cycles/op", "LLC miss/op", "baseline", "change" );
+
+	for ( const auto &result : results ) {
+		std::string name = dataset_name + "/" + result.name;
+		printf( "%-28s %10lld %12.2f %12.2f %12.1f", name.c_str(), result.num_ops, result.ns_per_op, result.allocations_per_op, result.cycles_per_op );
+
+		// Cache misses are only counted where the kernel exposes hardware counters
+		if ( cache_miss_counter >= 0 ) {
+			printf( " %12.2f", result.cache_misses_per_op );
+		}
+		else {
+			printf( " %12s", "-" );
+		}
+
+		if ( baseline.find( name ) != baseline.end() ) {
+			double change = result.ns_per_op / baseline[ name ] - 1;
+			bool regression = ( change > max_regression );
+			num_regressions += regression;
+
+			printf( " %12.2f %+8.1f%%%s\n", baseline[ name ], change * 100, regression ? " REGRESSION" : "" );
+		}
+		else {
+			printf( " %12s %9s\n", "-", "-" );
+		}
+
+		baseline[ name ] = result.ns_per_op;
+	}
+
+	printf( "Checksum: %lld\n", checksum );
+
+	if ( update_baseline ) {
+		std::ofstream fh_baseline_output( baseline_fname, std::fstream::out );
+		fh_baseline_output << "# Microbenchmark baseline: benchmark name and time per operation in nanoseconds\n";
+
+		for ( const auto &entry : baseline ) {
+			fh_baseline_output << entry.first << "\t" << entry.second << "\n";
+		}
+
+		printf( "Baseline written to %s\n", baseline_fname.c_str() );
+
+		return 0;
+	}
+
+	if ( num_regressions > 0 ) {
+		printf( "%d benchmarks regressed by more than %.0f%% compared to the baseline\n", num_regressions, max_regression * 100 );
+
+		return 1;
+	}
+
+	return 0;
+}
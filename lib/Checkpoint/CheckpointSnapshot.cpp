@@ -0,0 +1,137 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <stdio.h>
+
+// OS-dependent includes
+#include <unistd.h>
+
+// Program includes
+#include "CheckpointSnapshot.h"
+
+// Identifier at the start of every snapshot file
+const long long CHECKPOINT_FILE_MAGIC = 0x31504b43514c4350LL;
+
+/**
+ * Write a list of values to a file, preceded by its length
+ *
+ * @param FILE* fh File handle
+ * @param const std::vector<Value>& values Values
+ * @return bool Whether all values were written
+ */
+template <typename Value>
+bool writeValues( FILE *fh, const std::vector<Value> &values ) {
+	long long num_values = values.size();
+
+	return fwrite( &num_values, sizeof( long long ), 1, fh ) == 1 && fwrite( values.data(), sizeof( Value ), values.size(), fh ) == values.size();
+}
+
+/**
+ * Read a list of values written by writeValues()
+ *
+ * @param FILE* fh File handle
+ * @param std::vector<Value>& values Values
+ * @return bool Whether all values were read
+ */
+template <typename Value>
+bool readValues( FILE *fh, std::vector<Value> &values ) {
+	long long num_values;
+
+	if ( fread( &num_values, sizeof( long long ), 1, fh ) != 1 || num_values < 0 ) {
+		return false;
+	}
+
+	values.resize( num_values );
+
+	return fread( values.data(), sizeof( Value ), values.size(), fh ) == values.size();
+}
+
+bool CheckpointSnapshot::covers( int epoch ) const {
+	return epoch >= epoch_first && ( epoch_last < 0 || epoch <= epoch_last );
+}
+
+void CheckpointSnapshot::add( const CheckpointSnapshot &other ) {
+	if ( cliques_counts.size() < other.cliques_counts.size() ) {
+		cliques_counts.resize( other.cliques_counts.size(), 0 );
+	}
+
+	for ( unsigned int i = 0; i < other.cliques_counts.size(); i++ ) {
+		cliques_counts[ i ] += other.cliques_counts[ i ];
+	}
+
+	roots.insert( roots.end(), other.roots.begin(), other.roots.end() );
+	tasks.insert( tasks.end(), other.tasks.begin(), other.tasks.end() );
+}
+
+bool CheckpointSnapshot::write( std::string fname ) const {
+	std::string fname_temporary = fname + ".tmp";
+	FILE *fh = fopen( fname_temporary.c_str(), "wb" );
+
+	if ( fh == NULL ) {
+		printf( "ERROR: The checkpoint file '%s' could not be opened.\n", fname_temporary.c_str() );
+		return false;
+	}
+
+	std::vector<long long> header = { CHECKPOINT_FILE_MAGIC, generation, worker_id, peer_id, num_workers, epoch_first, epoch_last, sequence, (long long) tasks.size() };
+	bool written = writeValues( fh, header ) && writeValues( fh, cliques_counts ) && writeValues( fh, num_tasks_sent ) && writeValues( fh, num_tasks_received ) && writeValues( fh, roots );
+
+	for ( const auto &task : tasks ) {
+		std::vector<long long> task_header = { task.depth, task.start, task.end };
+		written = written && writeValues( fh, task_header ) && writeValues( fh, task.base_nodes ) && writeValues( fh, task.potential_nodes );
+	}
+
+	// Make sure the snapshot is on disk before it replaces the previous file
+	written = written && fflush( fh ) == 0 && fsync( fileno( fh ) ) == 0;
+	written = ( fclose( fh ) == 0 ) && written;
+
+	if ( ! written || rename( fname_temporary.c_str(), fname.c_str() ) != 0 ) {
+		printf( "ERROR: The checkpoint file '%s' could not be written.\n", fname.c_str() );
+		remove( fname_temporary.c_str() );
+		return false;
+	}
+
+	return true;
+}
+
+bool CheckpointSnapshot::read( std::string fname ) {
+	FILE *fh = fopen( fname.c_str(), "rb" );
+
+	if ( fh == NULL ) {
+		return false;
+	}
+
+	std::vector<long long> header;
+	bool read = readValues( fh, header ) && header.size() == 9 && header[0] == CHECKPOINT_FILE_MAGIC && header[8] >= 0;
+
+	if ( read ) {
+		generation = header[1];
+		worker_id = header[2];
+		peer_id = header[3];
+		num_workers = header[4];
+		epoch_first = header[5];
+		epoch_last = header[6];
+		sequence = header[7];
+		tasks.resize( header[8] );
+
+		read = readValues( fh, cliques_counts ) && readValues( fh, num_tasks_sent ) && readValues( fh, num_tasks_received ) && readValues( fh, roots );
+	}
+
+	for ( auto &task : tasks ) {
+		std::vector<long long> task_header;
+		read = read && readValues( fh, task_header ) && task_header.size() == 3 && readValues( fh, task.base_nodes ) && readValues( fh, task.potential_nodes );
+
+		if ( ! read ) {
+			break;
+		}
+
+		task.depth = task_header[0];
+		task.start = task_header[1];
+		task.end = task_header[2];
+	}
+
+	fclose( fh );
+
+	return read;
+}
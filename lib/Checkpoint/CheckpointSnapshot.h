@@ -0,0 +1,104 @@
+#ifndef CHECKPOINTSNAPSHOT_H
+#define CHECKPOINTSNAPSHOT_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+
+// Program includes
+#include "../Transport/Transport.h"
+
+/**
+ * State of the search of a single worker at a checkpoint: the cliques counted so far, the root tasks it has not started
+ * yet, and the remaining candidates of the branches it is working on, as help tasks. A snapshot holds for a range of
+ * checkpoint epochs, as a worker that did not change its state between two checkpoints is described by the same
+ * snapshot at both. Snapshots are stored in a binary file of 64-bit integers (and 32-bit integers for node IDs) in host
+ * byte order
+ */
+class CheckpointSnapshot {
+	public:
+		/**
+		 * Generation of the checkpoints, which is increased every time the search is resumed, so that the checkpoints of
+		 * an earlier run are never mixed with those of the current run
+		 */
+		int generation = 0;
+
+		/**
+		 * Index of the worker among the workers taking part in the computation, its ID in the transport connecting the
+		 * workers, and the number of workers
+		 */
+		int worker_id = 0;
+		int peer_id = 0;
+		int num_workers = 1;
+
+		/**
+		 * First and last epoch for which this snapshot holds. The last epoch is -1 if the snapshot holds for all later
+		 * epochs, which is the case for the snapshot of an idle worker until it receives a help task
+		 */
+		int epoch_first = 0;
+		int epoch_last = -1;
+
+		/**
+		 * Sequence number of the snapshot among the snapshots written by the worker, or -1 if it has not been written.
+		 * Of two snapshots of a worker holding for the same epoch, the later one replaces the earlier one
+		 */
+		long long sequence = -1;
+
+		/**
+		 * Number of cliques counted per clique size, regardless of the clique size range
+		 */
+		std::vector<long long> cliques_counts;
+
+		/**
+		 * Number of help tasks sent to and received from each other worker, indexed by transport ID. In a consistent
+		 * set of snapshots, every task sent has been received
+		 */
+		std::vector<long long> num_tasks_sent;
+		std::vector<long long> num_tasks_received;
+
+		/**
+		 * Root tasks not started yet: node IDs, or edge indices if the root tasks are edges
+		 */
+		std::vector<long long> roots;
+
+		/**
+		 * Remaining parts of the branches of started root tasks, including help tasks received from other workers
+		 */
+		std::vector<HelpTask> tasks;
+
+		/**
+		 * Check whether this snapshot holds for an epoch
+		 *
+		 * @param int epoch Checkpoint epoch
+		 * @return bool Whether the snapshot holds for the epoch
+		 */
+		bool covers( int epoch ) const;
+
+		/**
+		 * Add the cliques counts, root tasks and help tasks of another snapshot to this snapshot
+		 *
+		 * @param const CheckpointSnapshot& other Snapshot of another worker
+		 */
+		void add( const CheckpointSnapshot &other );
+
+		/**
+		 * Write the snapshot to a file. The snapshot is written to a temporary file first, which then replaces the file,
+		 * so that the file always holds a complete snapshot
+		 *
+		 * @param std::string fname File name
+		 * @return bool Whether the snapshot was written
+		 */
+		bool write( std::string fname ) const;
+
+		/**
+		 * Read a snapshot from a file
+		 *
+		 * @param std::string fname File name
+		 * @return bool Whether a complete snapshot was read
+		 */
+		bool read( std::string fname );
+};
+
+#endif
@@ -0,0 +1,425 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <stdio.h>
+#include <string.h>
+
+// OS-dependent includes
+#include <dirent.h>
+#include <sys/stat.h>
+
+// Program includes
+#include "Checkpointer.h"
+#include "../Trace/Trace.h"
+
+/**
+ * Get the names of the checkpoint files in a directory: the start state of each generation ("base.<generation>.ckpt")
+ * and the snapshots of the workers ("<generation>.<worker>.<sequence>.ckpt")
+ *
+ * @param std::string dir Directory
+ * @return std::vector<std::string> File names, without the directory
+ */
+std::vector<std::string> getCheckpointFileNames( std::string dir ) {
+	std::vector<std::string> fnames;
+	DIR *dh = opendir( dir.c_str() );
+
+	if ( dh == NULL ) {
+		return fnames;
+	}
+
+	for ( struct dirent *entry = readdir( dh ); entry != NULL; entry = readdir( dh ) ) {
+		int generation;
+		int worker_id;
+		long long sequence;
+		int num_chars = 0;
+		int length = strlen( entry->d_name );
+
+		if ( ( sscanf( entry->d_name, "base.%d.ckpt%n", &generation, &num_chars ) == 1 && num_chars == length ) || ( sscanf( entry->d_name, "%d.%d.%lld.ckpt%n", &generation, &worker_id, &sequence, &num_chars ) == 3 && num_chars == length ) ) {
+			fnames.push_back( entry->d_name );
+		}
+	}
+
+	closedir( dh );
+
+	return fnames;
+}
+
+/**
+ * Find the latest checkpoint epoch of which the snapshots of all workers form a consistent cut, i.e. every help task
+ * sent before the senders' snapshots was received before the receivers' snapshots, and combine these snapshots
+ *
+ * @param const std::vector<CheckpointSnapshot>& snapshots Snapshots of all workers of a generation
+ * @param CheckpointSnapshot& combined Combined snapshot
+ * @return int Checkpoint epoch, or 0 if no epoch is consistent
+ */
+int combineConsistentSnapshots( const std::vector<CheckpointSnapshot> &snapshots, CheckpointSnapshot &combined ) {
+	if ( snapshots.empty() ) {
+		return 0;
+	}
+
+	int num_workers = snapshots[0].num_workers;
+	int epoch_max = 0;
+
+	for ( const auto &snapshot : snapshots ) {
+		epoch_max = std::max( epoch_max, std::max( snapshot.epoch_first, snapshot.epoch_last ) );
+	}
+
+	for ( int epoch = epoch_max; epoch > 0; epoch-- ) {
+		// The latest snapshot of each worker holding for the epoch
+		std::vector<const CheckpointSnapshot *> cut( num_workers, NULL );
+
+		for ( const auto &snapshot : snapshots ) {
+			if ( snapshot.num_workers == num_workers && snapshot.worker_id < num_workers && snapshot.covers( epoch ) && ( cut[ snapshot.worker_id ] == NULL || snapshot.sequence > cut[ snapshot.worker_id ]->sequence ) ) {
+				cut[ snapshot.worker_id ] = &snapshot;
+			}
+		}
+
+		if ( std::find( cut.begin(), cut.end(), (const CheckpointSnapshot *) NULL ) != cut.end() ) {
+			continue;
+		}
+
+		bool consistent = true;
+
+		for ( const CheckpointSnapshot *sender : cut ) {
+			for ( const CheckpointSnapshot *receiver : cut ) {
+				long long num_sent = ( receiver->peer_id < (int) sender->num_tasks_sent.size() ) ? sender->num_tasks_sent[ receiver->peer_id ] : 0;
+				long long num_received = ( sender->peer_id < (int) receiver->num_tasks_received.size() ) ? receiver->num_tasks_received[ sender->peer_id ] : 0;
+				consistent = consistent && ( num_sent == num_received );
+			}
+		}
+
+		if ( ! consistent ) {
+			continue;
+		}
+
+		for ( const CheckpointSnapshot *snapshot : cut ) {
+			combined.add( *snapshot );
+		}
+
+		return epoch;
+	}
+
+	return 0;
+}
+
+Checkpointer::Checkpointer( std::string dir, int generation, int worker_id, int peer_id, int num_workers, int num_peers, double interval ) : dir(dir), generation(generation), worker_id(worker_id), peer_id(peer_id), num_workers(num_workers), interval(interval), num_tasks_sent(num_peers, 0), num_tasks_received(num_peers, 0) {
+	start();
+	writer_thread = std::thread( &Checkpointer::run, this );
+}
+
+Checkpointer::~Checkpointer() {
+	close();
+}
+
+std::string Checkpointer::getFileName( long long sequence ) {
+	return dir + "/" + std::to_string( generation ) + "." + std::to_string( worker_id ) + "." + std::to_string( sequence ) + ".ckpt";
+}
+
+void Checkpointer::start() {
+	time_start = pm.getCurrentClockTime();
+	setEpoch( epoch );
+}
+
+void Checkpointer::setEpoch( int epoch_new ) {
+	epoch = epoch_new;
+	time_due = time_start + ( epoch + 1 ) * interval;
+}
+
+bool Checkpointer::isDue() {
+	return pm.getCurrentClockTime() >= time_due;
+}
+
+void Checkpointer::completeSnapshot( CheckpointSnapshot &snapshot, int epoch_last ) {
+	snapshot.generation = generation;
+	snapshot.worker_id = worker_id;
+	snapshot.peer_id = peer_id;
+	snapshot.num_workers = num_workers;
+	snapshot.epoch_first = epoch + 1;
+	snapshot.epoch_last = epoch_last;
+	snapshot.sequence = -1;
+	snapshot.num_tasks_sent = num_tasks_sent;
+	snapshot.num_tasks_received = num_tasks_received;
+}
+
+void Checkpointer::enqueueWrite( CheckpointSnapshot &snapshot ) {
+	long long sequence_removed = snapshot.sequence;
+	snapshot.sequence = next_sequence++;
+
+	pending_writes.push_back( CheckpointWrite{ snapshot, sequence_removed } );
+	condition.notify_all();
+}
+
+void Checkpointer::enqueueRemoval( long long sequence ) {
+	CheckpointWrite removal;
+	removal.snapshot.sequence = -1;
+	removal.sequence_removed = sequence;
+
+	pending_writes.push_back( std::move( removal ) );
+	condition.notify_all();
+}
+
+void Checkpointer::addSnapshot( CheckpointSnapshot snapshot ) {
+	snapshots.push_back( std::move( snapshot ) );
+	enqueueWrite( snapshots.back() );
+
+	while ( snapshots.size() > CHECKPOINT_NUM_KEPT ) {
+		enqueueRemoval( snapshots.front().sequence );
+		snapshots.pop_front();
+	}
+}
+
+void Checkpointer::takeSnapshot( CheckpointSnapshot snapshot, double start_time ) {
+	TraceScope trace_scope( "checkpoint", epoch + 1 );
+	std::lock_guard<std::mutex> lock( mutex );
+
+	// The snapshot holds for all epochs that passed since the previous snapshot, as the worker received no help tasks
+	// in the meantime
+	int epoch_current = std::max( epoch + 1, int( ( pm.getCurrentClockTime() - time_start ) / interval ) );
+
+	completeSnapshot( snapshot, epoch_current );
+	setEpoch( epoch_current );
+	addSnapshot( std::move( snapshot ) );
+
+	blocked_time += pm.getCurrentClockTime() - start_time;
+}
+
+void Checkpointer::setIdle( CheckpointSnapshot snapshot ) {
+	std::lock_guard<std::mutex> lock( mutex );
+
+	completeSnapshot( snapshot, -1 );
+	idle_snapshot = std::move( snapshot );
+	idle_time = pm.getCurrentClockTime();
+	idle = true;
+
+	condition.notify_all();
+}
+
+void Checkpointer::taskSent( HelpTask &task, int helper_id ) {
+	task.checkpoint_epoch = epoch;
+	num_tasks_sent[ helper_id ]++;
+}
+
+void Checkpointer::taskReceived( const HelpTask &task ) {
+	double start_time = pm.getCurrentClockTime();
+	std::lock_guard<std::mutex> lock( mutex );
+
+	// The task was sent before the sender's snapshots of the epochs after its epoch, and arrives after this worker's
+	// snapshots of these epochs, so these snapshots take the task over
+	for ( auto snapshot = snapshots.begin(); snapshot != snapshots.end(); snapshot++ ) {
+		if ( snapshot->epoch_last <= task.checkpoint_epoch ) {
+			continue;
+		}
+
+		// Split off the epochs up to the epoch of the task, for which the snapshot stays as it is
+		if ( snapshot->epoch_first <= task.checkpoint_epoch ) {
+			CheckpointSnapshot snapshot_before = *snapshot;
+			snapshot_before.epoch_last = task.checkpoint_epoch;
+			snapshot->epoch_first = task.checkpoint_epoch + 1;
+			snapshot->sequence = -1;
+
+			snapshot = snapshots.insert( snapshot, std::move( snapshot_before ) );
+			enqueueWrite( *snapshot );
+			snapshot++;
+		}
+
+		snapshot->tasks.push_back( task );
+		snapshot->num_tasks_received[ task.requester_id ]++;
+		enqueueWrite( *snapshot );
+	}
+
+	// The snapshot of an idle worker holds until the epoch of the task. A task of a later epoch than the epoch of this
+	// worker was sent after the sender's snapshot of that epoch, so this worker has to take its snapshot of that epoch
+	// before starting on the task
+	if ( idle ) {
+		idle = false;
+
+		if ( task.checkpoint_epoch > epoch ) {
+			idle_snapshot.epoch_last = task.checkpoint_epoch;
+			setEpoch( task.checkpoint_epoch );
+			addSnapshot( std::move( idle_snapshot ) );
+		}
+		else if ( idle_snapshot.sequence >= 0 ) {
+			enqueueRemoval( idle_snapshot.sequence );
+		}
+	}
+
+	num_tasks_received[ task.requester_id ]++;
+
+	blocked_time += pm.getCurrentClockTime() - start_time;
+}
+
+void Checkpointer::run() {
+	Trace::setThreadName( "checkpoint writer" );
+
+	std::unique_lock<std::mutex> lock( mutex );
+
+	while ( true ) {
+		// Write the snapshot of an idle worker once it has been idle for a while
+		double idle_write_time = idle_time + std::min( CHECKPOINT_IDLE_DELAY, interval );
+
+		if ( idle && idle_snapshot.sequence < 0 && ( closing || pm.getCurrentClockTime() >= idle_write_time ) ) {
+			enqueueWrite( idle_snapshot );
+		}
+
+		if ( pending_writes.empty() ) {
+			if ( closing ) {
+				return;
+			}
+
+			if ( idle && idle_snapshot.sequence < 0 ) {
+				condition.wait_for( lock, std::chrono::duration<double>( idle_write_time - pm.getCurrentClockTime() ) );
+			}
+			else {
+				condition.wait( lock );
+			}
+
+			continue;
+		}
+
+		// Write the snapshot without holding the lock, so that the search can continue
+		CheckpointWrite write = std::move( pending_writes.front() );
+		pending_writes.pop_front();
+		lock.unlock();
+
+		double start_time = pm.getCurrentClockTime();
+		bool written = false;
+
+		{
+			TraceScope trace_scope( "checkpoint write", write.snapshot.sequence );
+
+			if ( write.snapshot.sequence >= 0 ) {
+				written = write.snapshot.write( getFileName( write.snapshot.sequence ) );
+			}
+
+			if ( write.sequence_removed >= 0 ) {
+				remove( getFileName( write.sequence_removed ).c_str() );
+			}
+		}
+
+		lock.lock();
+		num_written += written;
+		write_time += pm.getCurrentClockTime() - start_time;
+	}
+}
+
+void Checkpointer::close() {
+	if ( ! writer_thread.joinable() ) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		closing = true;
+		condition.notify_all();
+	}
+
+	writer_thread.join();
+}
+
+long long Checkpointer::getNumWritten() {
+	return num_written;
+}
+
+double Checkpointer::getBlockedTime() {
+	return blocked_time;
+}
+
+double Checkpointer::getWriteTime() {
+	return write_time;
+}
+
+int Checkpointer::prepare( std::string dir, bool resume ) {
+	mkdir( dir.c_str(), 0755 );
+
+	std::vector<std::string> fnames = getCheckpointFileNames( dir );
+	int generation = 0;
+	bool has_base = false;
+
+	for ( const auto &fname : fnames ) {
+		int base_generation;
+
+		if ( sscanf( fname.c_str(), "base.%d.ckpt", &base_generation ) == 1 && ( ! has_base || base_generation > generation ) ) {
+			generation = base_generation;
+			has_base = true;
+		}
+	}
+
+	// The snapshots of the workers of the latest generation, which started from the start state of that generation
+	CheckpointSnapshot resumed;
+	int epoch = 0;
+
+	if ( resume ) {
+		std::vector<CheckpointSnapshot> snapshots;
+
+		for ( const auto &fname : fnames ) {
+			int snapshot_generation;
+			CheckpointSnapshot snapshot;
+
+			if ( sscanf( fname.c_str(), "%d.", &snapshot_generation ) == 1 && snapshot_generation == generation && snapshot.read( dir + "/" + fname ) ) {
+				snapshots.push_back( std::move( snapshot ) );
+			}
+		}
+
+		epoch = combineConsistentSnapshots( snapshots, resumed );
+
+		if ( epoch > 0 ) {
+			printf( "Resuming from checkpoint epoch %d of %d workers: %zu root tasks and %zu partial tasks remaining.\n", epoch, snapshots[0].num_workers, resumed.roots.size(), resumed.tasks.size() );
+		}
+		else if ( has_base && resumed.read( dir + "/base." + std::to_string( generation ) + ".ckpt" ) ) {
+			printf( "No consistent checkpoint found since the search was last resumed; resuming from the same state again.\n" );
+		}
+		else {
+			printf( "No consistent checkpoint found in '%s'; starting the search from scratch.\n", dir.c_str() );
+			resume = false;
+		}
+	}
+
+	// Start state of the new generation, which replaces all earlier checkpoints
+	if ( resume ) {
+		std::sort( resumed.roots.begin(), resumed.roots.end() );
+		resumed.generation = generation + 1;
+		resumed.worker_id = 0;
+		resumed.num_workers = 1;
+		resumed.epoch_first = epoch;
+		resumed.epoch_last = epoch;
+		resumed.num_tasks_sent.clear();
+		resumed.num_tasks_received.clear();
+
+		if ( ! resumed.write( dir + "/base." + std::to_string( generation + 1 ) + ".ckpt" ) ) {
+			return 0;
+		}
+	}
+
+	for ( const auto &fname : fnames ) {
+		remove( ( dir + "/" + fname ).c_str() );
+	}
+
+	return resume ? generation + 1 : 0;
+}
+
+bool Checkpointer::readResumed( std::string dir, int generation, int worker_id, int num_workers, CheckpointSnapshot &snapshot ) {
+	CheckpointSnapshot resumed;
+
+	if ( generation == 0 || ! resumed.read( dir + "/base." + std::to_string( generation ) + ".ckpt" ) ) {
+		return false;
+	}
+
+	if ( worker_id == 0 ) {
+		snapshot.cliques_counts = resumed.cliques_counts;
+	}
+
+	for ( unsigned long long i = worker_id; i < resumed.roots.size(); i += num_workers ) {
+		snapshot.roots.push_back( resumed.roots[ i ] );
+	}
+
+	for ( unsigned long long i = worker_id; i < resumed.tasks.size(); i += num_workers ) {
+		snapshot.tasks.push_back( std::move( resumed.tasks[ i ] ) );
+	}
+
+	return true;
+}
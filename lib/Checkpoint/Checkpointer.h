@@ -0,0 +1,299 @@
+#ifndef CHECKPOINTER_H
+#define CHECKPOINTER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Program includes
+#include "CheckpointSnapshot.h"
+#include "../Transport/Transport.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+
+// Checkpointing parameters
+// ==========
+// Default time (in seconds) between two checkpoints
+const double CHECKPOINT_DEFAULT_INTERVAL = 300;
+
+// Number of snapshots each worker keeps, of its most recent checkpoint epochs
+const unsigned int CHECKPOINT_NUM_KEPT = 3;
+
+// Time (in seconds) a worker has to be idle before its snapshot is written, so that workers that are idle only briefly
+// between help tasks do not write a snapshot every time
+const double CHECKPOINT_IDLE_DELAY = 1;
+
+/**
+ * Snapshot written to a file by the background thread of a checkpointer, followed by the removal of the file of an
+ * earlier snapshot it replaces
+ */
+struct CheckpointWrite {
+	CheckpointSnapshot snapshot;
+	long long sequence_removed;
+};
+
+/**
+ * Periodic checkpoints of the search of a single worker, from which an interrupted search can be resumed, possibly with
+ * a different number of workers.
+ *
+ * Workers take their snapshots independently, at every interval on their own clock, numbered by checkpoint epoch. A
+ * help task carries the epoch of its sender, so that the snapshots of the same epoch of all workers form a consistent
+ * cut of the computation: a worker receiving a task of a later epoch takes its snapshot of that epoch first, and a
+ * worker receiving a task of an earlier epoch, after its own snapshot, adds the task to its snapshot, as the sender's
+ * snapshot no longer holds it. Every snapshot counts the tasks sent to and received from every other worker, so that
+ * an epoch of which some task was still underway when the computation stopped is recognised as inconsistent.
+ *
+ * Snapshots are written by a background thread, each to its own file named by generation, worker and sequence number,
+ * so that the search only waits for copying its state
+ */
+class Checkpointer {
+	protected:
+		/**
+		 * Directory holding the checkpoint files, and the generation of the checkpoints of this run
+		 */
+		std::string dir;
+		int generation;
+
+		/**
+		 * Index of the worker among the workers taking part in the computation, its ID in the transport connecting the
+		 * workers, and the number of workers
+		 */
+		int worker_id;
+		int peer_id;
+		int num_workers;
+
+		/**
+		 * Time (in seconds) between two checkpoints, the clock time at which the first epoch started, and the clock time
+		 * at which the next checkpoint is due
+		 */
+		double interval;
+		double time_start = 0;
+		double time_due = 0;
+
+		/**
+		 * Checkpoint epoch of the latest snapshot of this worker, or 0 if it has not taken a snapshot yet
+		 */
+		int epoch = 0;
+
+		/**
+		 * Number of help tasks sent to and received from each other worker, indexed by transport ID
+		 */
+		std::vector<long long> num_tasks_sent;
+		std::vector<long long> num_tasks_received;
+
+		/**
+		 * Snapshots of the most recent epochs, oldest first, which take over help tasks that arrive late
+		 */
+		std::deque<CheckpointSnapshot> snapshots;
+
+		/**
+		 * Whether the worker is idle, the clock time at which it became idle, and its snapshot, which holds for all
+		 * epochs until it receives a help task
+		 */
+		bool idle = false;
+		double idle_time = 0;
+		CheckpointSnapshot idle_snapshot;
+
+		/**
+		 * Sequence number of the next snapshot written
+		 */
+		long long next_sequence = 0;
+
+		/**
+		 * Snapshots waiting to be written by the background thread, and whether the background thread should stop once
+		 * they are written
+		 */
+		std::deque<CheckpointWrite> pending_writes;
+		bool closing = false;
+
+		/**
+		 * Background thread writing snapshots, and the synchronisation with the search
+		 */
+		std::thread writer_thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+
+		/**
+		 * Number of snapshots written, time (in seconds) the search waited for taking snapshots, and time the background
+		 * thread spent writing them
+		 */
+		long long num_written = 0;
+		double blocked_time = 0;
+		double write_time = 0;
+
+		/**
+		 * Progress monitor object to track time
+		 */
+		ProgressMonitor pm;
+
+		/**
+		 * Get the name of the file of a snapshot of this worker
+		 *
+		 * @param long long sequence Sequence number of the snapshot
+		 * @return std::string File name
+		 */
+		std::string getFileName( long long sequence );
+
+		/**
+		 * Set the checkpoint epoch of this worker, and the time at which its next checkpoint is due
+		 *
+		 * @param int epoch_new Checkpoint epoch
+		 */
+		void setEpoch( int epoch_new );
+
+		/**
+		 * Complete the fields of a snapshot describing this worker, its task counts and the epochs it holds for
+		 *
+		 * @param CheckpointSnapshot& snapshot Snapshot
+		 * @param int epoch_last Last epoch for which the snapshot holds, or -1 for all later epochs
+		 */
+		void completeSnapshot( CheckpointSnapshot &snapshot, int epoch_last );
+
+		/**
+		 * Hand a snapshot over to the background thread, under a new sequence number, replacing the file of its previous
+		 * sequence number if it has been written before. The mutex should be held
+		 *
+		 * @param CheckpointSnapshot& snapshot Snapshot, of which the sequence number is updated
+		 */
+		void enqueueWrite( CheckpointSnapshot &snapshot );
+
+		/**
+		 * Hand the removal of the file of a snapshot over to the background thread. The mutex should be held
+		 *
+		 * @param long long sequence Sequence number of the snapshot
+		 */
+		void enqueueRemoval( long long sequence );
+
+		/**
+		 * Add a snapshot to the snapshots of the most recent epochs, and write it. The mutex should be held
+		 *
+		 * @param CheckpointSnapshot snapshot Snapshot
+		 */
+		void addSnapshot( CheckpointSnapshot snapshot );
+
+		/**
+		 * Main loop of the background thread
+		 */
+		void run();
+
+	public:
+		/**
+		 * Constructor. Starts the background thread
+		 *
+		 * @param std::string dir Directory holding the checkpoint files
+		 * @param int generation Generation of the checkpoints of this run, see Checkpointer::prepare()
+		 * @param int worker_id Index of the worker among the workers taking part in the computation
+		 * @param int peer_id ID of the worker in the transport connecting the workers
+		 * @param int num_workers Number of workers
+		 * @param int num_peers Number of IDs in the transport connecting the workers
+		 * @param double interval Time (in seconds) between two checkpoints
+		 */
+		Checkpointer( std::string dir, int generation, int worker_id, int peer_id, int num_workers, int num_peers, double interval );
+
+		/**
+		 * Destructor. Writes the remaining snapshots
+		 */
+		~Checkpointer();
+
+		/**
+		 * Start the clock of the checkpoint epochs, at the start of the search
+		 */
+		void start();
+
+		/**
+		 * Check whether a checkpoint is due
+		 *
+		 * @return bool Whether the worker should take a snapshot
+		 */
+		bool isDue();
+
+		/**
+		 * Take the snapshot of a busy worker, holding for the epochs since its previous snapshot up to the current epoch
+		 *
+		 * @param CheckpointSnapshot snapshot Cliques counts, remaining root tasks and remaining help tasks of the worker
+		 * @param double start_time Clock time at which the worker started collecting its snapshot
+		 */
+		void takeSnapshot( CheckpointSnapshot snapshot, double start_time );
+
+		/**
+		 * Record that the worker has become idle. Its snapshot holds for all later epochs until it receives a help task,
+		 * and is written once the worker has been idle for a while
+		 *
+		 * @param CheckpointSnapshot snapshot Cliques counts of the worker
+		 */
+		void setIdle( CheckpointSnapshot snapshot );
+
+		/**
+		 * Record a help task sent to another worker, tagging it with the current epoch
+		 *
+		 * @param HelpTask& task Help task
+		 * @param int helper_id Transport ID of the helping worker
+		 */
+		void taskSent( HelpTask &task, int helper_id );
+
+		/**
+		 * Record a help task received from another worker, before the worker starts on it
+		 *
+		 * @param const HelpTask& task Help task
+		 */
+		void taskReceived( const HelpTask &task );
+
+		/**
+		 * Write the remaining snapshots, including the snapshot of the worker if it is idle, and stop the background
+		 * thread
+		 */
+		void close();
+
+		/**
+		 * Get the number of snapshots written
+		 *
+		 * @return long long Number of snapshots
+		 */
+		long long getNumWritten();
+
+		/**
+		 * Get the time the search waited for taking snapshots
+		 *
+		 * @return double Time in seconds
+		 */
+		double getBlockedTime();
+
+		/**
+		 * Get the time the background thread spent writing snapshots
+		 *
+		 * @return double Time in seconds
+		 */
+		double getWriteTime();
+
+		/**
+		 * Prepare the checkpoint directory before the workers start, at a single process. Without resuming, all
+		 * checkpoint files are removed. When resuming, the latest epoch of which the snapshots of all workers form a
+		 * consistent cut is combined into the start state of a new generation, and the files of earlier generations are
+		 * removed
+		 *
+		 * @param std::string dir Directory holding the checkpoint files, created if it does not exist
+		 * @param bool resume Whether to resume the search from the checkpoints in the directory
+		 * @return int Generation of the checkpoints of this run
+		 */
+		static int prepare( std::string dir, bool resume );
+
+		/**
+		 * Read the part of the start state of a resumed search assigned to a worker. The root tasks and help tasks are
+		 * distributed over the workers in a round-robin fashion, and the first worker takes over the cliques counts
+		 *
+		 * @param std::string dir Directory holding the checkpoint files
+		 * @param int generation Generation of the checkpoints of this run
+		 * @param int worker_id Index of the worker among the workers taking part in the computation
+		 * @param int num_workers Number of workers
+		 * @param CheckpointSnapshot& snapshot Part of the start state assigned to the worker
+		 * @return bool Whether the search is resumed, i.e. whether there is a start state
+		 */
+		static bool readResumed( std::string dir, int generation, int worker_id, int num_workers, CheckpointSnapshot &snapshot );
+};
+
+#endif
@@ -9,6 +9,10 @@
 #include <unordered_set>
 #include <math.h>
 #include <algorithm>
+#include <iterator>
+#include <utility>
+#include <random>
+#include <numeric>
 
 // Boost includes
 #include <boost/functional/hash.hpp>
@@ -16,6 +20,7 @@
 
 // Program includes
 #include "CliqueFinder.h"
+#include "../Trace/Trace.h"
 
 void CliqueFinder::initParallelComputation( int process_id_local, int num_processes_local, bool help_enabled_local ) {
 	process_id = process_id_local;
@@ -24,23 +29,55 @@ void CliqueFinder::initParallelComputation( int process_id_local, int num_proces
 }
 
 void CliqueFinder::findAllCliquesDFS() {
-	// Store adjacency list of edges in increasing order (i.e. no edge 5-2 exists)
-	std::map<int, std::vector<int> > baselist;
+	// Start of the time line of the help request threshold trajectory
+	pm.reset();
+	help_last_update_time = pm.getCurrentClockTime();
+	recordHelpRequestThreshold();
 
-	// Loop over edges to construct lists of base nodes and potential nodes
-	for ( const auto& edge : graph->getEdgeList() ) {
-		int node_source_id = edge.first;
-		int node_target_id = edge.second;
+	if ( sample_target_error > 0 ) {
+		findAllCliquesSampled();
+		return;
+	}
 
-		// Ensure that the source node should be processed in this process
-		if ( node_source_id % num_processes != process_id - 1 ) {
-			continue;
-		}
-		
-		// Maintain node ordering
-		if ( node_source_id < node_target_id ) {
-			baselist[ node_source_id ].push_back( node_target_id );
+	// Time budget of the search, from its start
+	if ( deadline > 0 ) {
+		deadline_time = pm.getStartTime() + deadline;
+	}
+
+	// The progress of the root tasks is tracked for the deadline and for progress reporting
+	progress_tracked = ( deadline_time > 0 || progress_board != NULL );
+	progress_root_depth = ( progress_tracked && ! edge_roots ) ? 3 : 0;
+	periodic_checks = ( progress_tracked || checkpointer != NULL );
+
+	// The counts of a resumed search include these cliques already
+	if ( isWeighted() && ! checkpoint_resumed ) {
+		countWeightedSmallCliques();
+	}
+
+	if ( checkpointer != NULL || root_profile != NULL ) {
+		findAllCliquesListed();
+		return;
+	}
+
+	if ( edge_roots ) {
+		findAllCliquesDFSEdgeRoots();
+		return;
+	}
+
+	// Store adjacency list of edges in increasing order (i.e. no edge 5-2 exists), for the source nodes that should be
+	// processed in this process
+	AdjacencyList baselist = graph->getForwardAdjacencyList( process_id, num_processes );
+
+	// Estimated work of the root tasks, against which the progress is measured
+	if ( progress_tracked ) {
+		for ( const auto &node : baselist ) {
+			if ( node.second.size() > 1 ) {
+				progress_num_roots++;
+				progress_work += getRootWork( node.second.size() );
+			}
 		}
+
+		publishProgress( true );
 	}
 
 	// Outer call of first iteration of the main algorithm
@@ -49,10 +86,635 @@ void CliqueFinder::findAllCliquesDFS() {
 			continue;
 		}
 
+		if ( periodic_checks && --check_countdown <= 0 && checkPeriodic() ) {
+			break;
+		}
+
+		TraceScope trace_scope( "root", node.first );
+		double root_start_time = record_root_costs ? pm.getCurrentClockTime() : 0;
+		long long root_start_nodes = dfs_num_nodes;
+
 		std::vector<int> base_nodes;
 		base_nodes.push_back( node.first );
+		beginTask();
 		findCliquesDFS( 3, base_nodes, node.second );
+
+		if ( ! endTask( true ) ) {
+			break;
+		}
+
+		if ( record_root_costs ) {
+			root_costs.push_back( node.first );
+			root_costs.push_back( node.second.size() );
+			root_costs.push_back( pm.getCurrentClockTime() - root_start_time );
+			root_costs.push_back( dfs_num_nodes - root_start_nodes );
+		}
+	}
+}
+
+void CliqueFinder::findAllCliquesDFSEdgeRoots() {
+	// Store the sorted list of higher-ID neighbours (N+) for every node, as the candidate set of an edge root
+	// is the intersection of the forward neighbourhoods of both of its end points
+	AdjacencyList forwardlist = graph->getForwardAdjacencyList();
+
+	// Distribute the oriented edges over the processes in a round-robin fashion, so that the number of root tasks
+	// per process is balanced regardless of the degree distribution
+	long long edge_index = 0;
+
+	// Estimated work of the root tasks, against which the progress is measured
+	if ( progress_tracked ) {
+		for ( const auto &node : forwardlist ) {
+			for ( int neighbour_id : node.second ) {
+				if ( edge_index++ % num_processes == process_id ) {
+					progress_num_roots++;
+					progress_work += getRootWork( getEdgeRootNumCandidatesMax( node.second, neighbour_id, forwardlist ) );
+				}
+			}
+		}
+
+		edge_index = 0;
+		publishProgress( true );
+	}
+
+	for ( const auto &node : forwardlist ) {
+		for ( int neighbour_id : node.second ) {
+			if ( edge_index++ % num_processes != process_id ) {
+				continue;
+			}
+
+			if ( periodic_checks && --check_countdown <= 0 && checkPeriodic() ) {
+				return;
+			}
+
+			TraceScope trace_scope( "edge root", edge_index - 1 );
+			double root_start_time = record_root_costs ? pm.getCurrentClockTime() : 0;
+			long long root_start_nodes = dfs_num_nodes;
+
+			beginTask();
+			int num_candidates = findCliquesEdgeRoot( node.first, node.second, neighbour_id, forwardlist );
+
+			if ( progress_tracked && ! endTask( true, getRootWork( getEdgeRootNumCandidatesMax( node.second, neighbour_id, forwardlist ) ) ) ) {
+				return;
+			}
+
+			if ( record_root_costs && num_candidates > 1 ) {
+				root_costs.push_back( edge_index - 1 );
+				root_costs.push_back( num_candidates );
+				root_costs.push_back( pm.getCurrentClockTime() - root_start_time );
+				root_costs.push_back( dfs_num_nodes - root_start_nodes );
+			}
+		}
+	}
+}
+
+void CliqueFinder::findAllCliquesListed() {
+	// Sorted higher-ID neighbours (N+) of all nodes, as the listed root tasks are not partitioned by node
+	AdjacencyList forwardlist = graph->getForwardAdjacencyList();
+
+	// Unless the search is resumed, the root tasks are the same nodes or edges as without a list, or those assigned to
+	// this process by the root cost profile
+	if ( ! checkpoint_resumed ) {
+		std::vector<long long> all_roots;
+		long long edge_index = 0;
+
+		for ( const auto &node : forwardlist ) {
+			if ( edge_roots ) {
+				for ( unsigned int i = 0; i < node.second.size(); i++, edge_index++ ) {
+					if ( root_profile != NULL ) {
+						all_roots.push_back( edge_index );
+					}
+					else if ( edge_index % num_processes == process_id ) {
+						checkpoint_roots.push_back( edge_index );
+					}
+				}
+			}
+			else if ( node.second.size() > 1 ) {
+				if ( root_profile != NULL ) {
+					all_roots.push_back( node.first );
+				}
+				else if ( ( ( node.first % num_processes ) + num_processes ) % num_processes == process_id ) {
+					checkpoint_roots.push_back( node.first );
+				}
+			}
+		}
+
+		if ( root_profile != NULL ) {
+			checkpoint_roots = root_profile->partition( all_roots, process_id, num_processes );
+		}
+	}
+
+	// Estimated work of the root tasks, against which the progress is measured. The end points of an edge are found by
+	// walking through the forward neighbourhoods along with the edge indices, as the root tasks are in increasing order
+	// of node ID or edge index
+	if ( progress_tracked ) {
+		auto node = forwardlist.cbegin();
+		long long node_edge_index = 0;
+
+		for ( long long root_id : checkpoint_roots ) {
+			if ( edge_roots ) {
+				while ( root_id >= node_edge_index + (long long) node->second.size() ) {
+					node_edge_index += node->second.size();
+					node++;
+				}
+
+				progress_work += getRootWork( getEdgeRootNumCandidatesMax( node->second, node->second[ root_id - node_edge_index ], forwardlist ) );
+			}
+			else {
+				progress_work += getRootWork( forwardlist[ root_id ].size() );
+			}
+		}
+
+		progress_num_roots += checkpoint_roots.size();
+
+		for ( const auto &task : checkpoint_tasks ) {
+			if ( task.depth == progress_root_depth ) {
+				progress_work += getRootCandidatesWork( task.potential_nodes.size(), task.start, task.end );
+			}
+		}
+
+		publishProgress( true );
+	}
+
+	// Parts of root tasks that were in progress at the checkpoint the search is resumed from
+	while ( checkpoint_task_index < checkpoint_tasks.size() ) {
+		if ( --check_countdown <= 0 && checkPeriodic() ) {
+			return;
+		}
+
+		HelpTask task = std::move( checkpoint_tasks[ checkpoint_task_index++ ] );
+
+		TraceScope trace_scope( "checkpoint task", task.depth );
+		beginTask();
+		findCliquesDFS( task.depth, std::move( task.base_nodes ), std::move( task.potential_nodes ), task.start, task.end );
+
+		if ( ! endTask() ) {
+			return;
+		}
+	}
+
+	// Root tasks, in increasing order of node ID or edge index
+	auto node = forwardlist.cbegin();
+	long long node_edge_index = 0;
+
+	while ( checkpoint_root_index < checkpoint_roots.size() ) {
+		if ( --check_countdown <= 0 && checkPeriodic() ) {
+			return;
+		}
+
+		long long root_id = checkpoint_roots[ checkpoint_root_index++ ];
+		double root_start_time = record_root_costs ? pm.getCurrentClockTime() : 0;
+		long long root_start_nodes = dfs_num_nodes;
+		int num_candidates = 0;
+		double root_work = 0;
+
+		beginTask();
+
+		if ( edge_roots ) {
+			while ( root_id >= node_edge_index + (long long) node->second.size() ) {
+				node_edge_index += node->second.size();
+				node++;
+			}
+
+			int neighbour_id = node->second[ root_id - node_edge_index ];
+
+			TraceScope trace_scope( "edge root", root_id );
+			num_candidates = findCliquesEdgeRoot( node->first, node->second, neighbour_id, forwardlist );
+			root_work = progress_tracked ? getRootWork( getEdgeRootNumCandidatesMax( node->second, neighbour_id, forwardlist ) ) : 0;
+		}
+		else {
+			const std::vector<int> &node_forward = forwardlist[ root_id ];
+			num_candidates = node_forward.size();
+
+			TraceScope trace_scope( "root", root_id );
+			findCliquesDFS( 3, std::vector<int>( 1, root_id ), node_forward );
+		}
+
+		if ( ! endTask( true, root_work ) ) {
+			return;
+		}
+
+		if ( record_root_costs && num_candidates > 1 ) {
+			root_costs.push_back( root_id );
+			root_costs.push_back( num_candidates );
+			root_costs.push_back( pm.getCurrentClockTime() - root_start_time );
+			root_costs.push_back( dfs_num_nodes - root_start_nodes );
+		}
+	}
+}
+
+bool CliqueFinder::checkPeriodic() {
+	check_countdown = PERIODIC_CHECK_ITERATIONS;
+
+	if ( checkpointer != NULL ) {
+		checkCheckpoint();
 	}
+
+	if ( progress_board != NULL ) {
+		publishProgress();
+	}
+
+	return deadline_time > 0 && checkDeadline();
+}
+
+void CliqueFinder::checkCheckpoint() {
+	// After the deadline, the final snapshot holds the state of the search, which no longer matches the clique counts
+	if ( checkpointer->isDue() && ! deadline_reached ) {
+		double start_time = pm.getCurrentClockTime();
+		checkpointer->takeSnapshot( getCheckpointSnapshot(), start_time );
+	}
+}
+
+bool CliqueFinder::checkDeadline() {
+	if ( ! deadline_reached && pm.getCurrentClockTime() >= deadline_time ) {
+		deadline_reached = true;
+
+		// The final snapshot holds the state of the search before the task it stops in is discarded, so that the search
+		// can be resumed from the deadline
+		if ( checkpointer != NULL ) {
+			double start_time = pm.getCurrentClockTime();
+			checkpointer->takeSnapshot( getCheckpointSnapshot(), start_time );
+		}
+	}
+
+	// Once the deadline has passed, every later check stops the search right away
+	if ( deadline_reached ) {
+		check_countdown = 0;
+	}
+
+	return deadline_reached;
+}
+
+double CliqueFinder::getRootWork( double num_candidates ) {
+	return num_candidates * ( num_candidates - 1 ) / 2;
+}
+
+double CliqueFinder::getRootCandidatesWork( int num_candidates, int start, int end ) {
+	// Candidate i checks the pairs it forms with the candidates after it
+	return ( end - start ) * ( num_candidates - 1 - ( start + end - 1 ) / 2.0 );
+}
+
+double CliqueFinder::getEdgeRootNumCandidatesMax( const std::vector<int> &node_forward, int neighbour_id, const AdjacencyList &forwardlist ) {
+	const auto neighbour_forward = forwardlist.find( neighbour_id );
+
+	if ( neighbour_forward == forwardlist.end() ) {
+		return 0;
+	}
+
+	return std::min( node_forward.size(), neighbour_forward->second.size() );
+}
+
+void CliqueFinder::setDeadline( double seconds ) {
+	deadline = seconds;
+}
+
+bool CliqueFinder::isDeadlineReached() {
+	return deadline_reached;
+}
+
+void CliqueFinder::beginTask() {
+	if ( deadline_time > 0 ) {
+		deadline_task_cliques_count = dfs_cliques_count;
+	}
+
+	progress_task_work = 0;
+}
+
+bool CliqueFinder::endTask( bool root, double work ) {
+	if ( ! progress_tracked ) {
+		return true;
+	}
+
+	double task_work = progress_task_work + work;
+	progress_task_work = 0;
+
+	// The search only checks the deadline before a candidate, so a task in which it passed has candidates left
+	if ( deadline_reached ) {
+		dfs_cliques_count = deadline_task_cliques_count;
+		return false;
+	}
+
+	if ( root ) {
+		progress_num_roots_completed++;
+	}
+
+	progress_work_completed += task_work;
+
+	return true;
+}
+
+std::vector<long long> CliqueFinder::getProgressRecord() {
+	std::vector<long long> record( PROGRESS_RECORD_SIZE );
+	record[ PROGRESS_ROOTS_TOTAL ] = progress_num_roots;
+	record[ PROGRESS_ROOTS_COMPLETED ] = progress_num_roots_completed;
+	record[ PROGRESS_WORK_TOTAL ] = llround( progress_work );
+	record[ PROGRESS_WORK_COMPLETED ] = llround( progress_work_completed + progress_task_work );
+	record[ PROGRESS_EDGE_CHECKS ] = help_num_checks_previous + help_num_checks;
+
+	return record;
+}
+
+void CliqueFinder::setProgressBoard( ProgressBoard *board, double interval ) {
+	progress_board = board;
+	progress_interval = interval;
+}
+
+void CliqueFinder::publishProgress( bool force ) {
+	if ( progress_board == NULL ) {
+		return;
+	}
+
+	// Publish twice per progress line, so that the line shows the progress of at most half an interval ago
+	double current_time = pm.getCurrentClockTime();
+
+	if ( force || current_time >= progress_publish_time + progress_interval / 2 ) {
+		progress_publish_time = current_time;
+		progress_board->publish( process_id, getProgressRecord() );
+	}
+}
+
+void CliqueFinder::setCheckpointer( Checkpointer *checkpointer_local, CheckpointSnapshot *resumed ) {
+	checkpointer = checkpointer_local;
+
+	if ( resumed == NULL ) {
+		return;
+	}
+
+	checkpoint_resumed = true;
+	checkpoint_roots = resumed->roots;
+	checkpoint_tasks = resumed->tasks;
+
+	for ( unsigned int i = 0; i < resumed->cliques_counts.size(); i++ ) {
+		if ( resumed->cliques_counts[ i ] > 0 ) {
+			dfs_cliques_count[ i ] += resumed->cliques_counts[ i ];
+		}
+	}
+}
+
+CheckpointSnapshot CliqueFinder::getCheckpointSnapshot() {
+	CheckpointSnapshot snapshot;
+
+	for ( const auto &count : dfs_cliques_count ) {
+		if ( (int) snapshot.cliques_counts.size() <= count.first ) {
+			snapshot.cliques_counts.resize( count.first + 1, 0 );
+		}
+
+		snapshot.cliques_counts[ count.first ] = count.second;
+	}
+
+	snapshot.roots.assign( checkpoint_roots.begin() + checkpoint_root_index, checkpoint_roots.end() );
+	snapshot.tasks.assign( checkpoint_tasks.begin() + checkpoint_task_index, checkpoint_tasks.end() );
+
+	// Remaining candidates of the active calls of the search: from the current candidate on for the innermost call,
+	// which has not started on it yet, and after the current candidate for the calls above it
+	for ( int depth = dfs_depth; depth > 0; depth = dfs_frames[ depth ].parent_depth ) {
+		const DFSFrame &frame = dfs_frames[ depth ];
+		int start = ( depth == dfs_depth ) ? frame.current : frame.current + 1;
+
+		if ( start < frame.end ) {
+			HelpTask task;
+			task.depth = depth;
+			task.base_nodes = *frame.base_nodes;
+			task.potential_nodes = *frame.potential_nodes;
+			task.start = start;
+			task.end = frame.end;
+			snapshot.tasks.push_back( std::move( task ) );
+		}
+	}
+
+	return snapshot;
+}
+
+void CliqueFinder::findAllCliquesSampled() {
+	// Samples are small, independent tasks drawn by every process, so that the processes are balanced without help
+	help_enabled = false;
+
+	// Population of root tasks: the nodes with at least two higher-ID neighbours, or the oriented edges of which the end
+	// points have common higher-ID neighbours, as other root tasks have no cliques. Root tasks are sampled with a
+	// probability proportional to their weight, which estimates the work under them: the number of candidate node pairs
+	// they start with (for edge roots, including the candidate nodes themselves, which are triangles). Edge roots are
+	// weighted by their actual candidate nodes rather than by the smaller forward neighbourhood of their end points, which
+	// halves the variance of the estimate on anybeat
+	AdjacencyList forwardlist = graph->getForwardAdjacencyList();
+	std::vector<AdjacencyList::const_iterator> root_nodes;
+	std::vector<Edge> root_edges;
+	std::vector<double> root_weights;
+	std::vector<int> candidates;
+
+	for ( auto node = forwardlist.cbegin(); node != forwardlist.cend(); node++ ) {
+		if ( ! edge_roots ) {
+			if ( node->second.size() > 1 ) {
+				root_nodes.push_back( node );
+				root_weights.push_back( node->second.size() * ( node->second.size() - 1.0 ) / 2 );
+			}
+
+			continue;
+		}
+
+		for ( int neighbour_id : node->second ) {
+			const auto neighbour_forward = forwardlist.find( neighbour_id );
+
+			if ( neighbour_forward == forwardlist.end() ) {
+				continue;
+			}
+
+			candidates.clear();
+			std::set_intersection( node->second.begin(), node->second.end(), neighbour_forward->second.begin(), neighbour_forward->second.end(), std::back_inserter( candidates ) );
+
+			if ( ! candidates.empty() ) {
+				double num_candidates = candidates.size();
+				root_edges.push_back( Edge( node->first, neighbour_id ) );
+				root_weights.push_back( num_candidates * ( num_candidates + 1 ) / 2 );
+			}
+		}
+	}
+
+	// Root tasks that would be sampled at least once within the minimum number of samples of all processes are counted
+	// exactly, distributed over the processes in a round-robin fashion, so that the heaviest root tasks are not sampled
+	// repeatedly. The remaining root tasks form the sampled stratum
+	std::vector<long long> root_order( root_weights.size() );
+	std::iota( root_order.begin(), root_order.end(), 0 );
+	std::sort( root_order.begin(), root_order.end(), [&]( long long a, long long b ) { return root_weights[ a ] > root_weights[ b ]; } );
+
+	double weights_total = 0;
+
+	for ( double weight : root_weights ) {
+		weights_total += weight;
+	}
+
+	long long num_exact = 0;
+
+	while ( num_exact < (long long) root_order.size() && root_weights[ root_order[ num_exact ] ] * SAMPLE_MIN_SAMPLES * num_processes >= weights_total ) {
+		weights_total -= root_weights[ root_order[ num_exact ] ];
+		num_exact++;
+	}
+
+	// Find the cliques under a root task, and get the number of cliques per clique size found under it. The cliques
+	// within single nodes and edges of a graph with collapsed twins are counted exactly
+	std::map<int, long long> cliques_count_sampled;
+
+	if ( isWeighted() ) {
+		countWeightedSmallCliques();
+		cliques_count_sampled = dfs_cliques_count;
+		sample_estimate.addExact( getCliquesCountsVector() );
+	}
+
+	auto findRootCliques = [&]( long long root_index ) {
+		dfs_cliques_count.clear();
+
+		if ( edge_roots ) {
+			const auto node = forwardlist.find( root_edges[ root_index ].first );
+			findCliquesEdgeRoot( node->first, node->second, root_edges[ root_index ].second, forwardlist );
+		}
+		else {
+			std::vector<int> base_nodes;
+			base_nodes.push_back( root_nodes[ root_index ]->first );
+			findCliquesDFS( 3, base_nodes, root_nodes[ root_index ]->second );
+		}
+
+		for ( const auto &count : dfs_cliques_count ) {
+			cliques_count_sampled[ count.first ] += count.second;
+		}
+
+		return getCliquesCountsVector();
+	};
+
+	for ( long long i = process_id; i < num_exact; i += num_processes ) {
+		TraceScope trace_scope( "root", root_order[ i ] );
+		sample_estimate.addExact( findRootCliques( root_order[ i ] ) );
+	}
+
+	if ( num_exact == (long long) root_order.size() ) {
+		dfs_cliques_count = cliques_count_sampled;
+		return;
+	}
+
+	// Once the weights of the root tasks drawn by all processes add up to the weight of the sampled stratum, counting it
+	// exactly would have taken about as long, so stop regardless of the error reached. The budget is in weight rather
+	// than in samples, as root tasks are drawn with replacement and the heaviest ones are drawn again and again
+	double max_weight_drawn = weights_total / num_processes;
+	double weight_drawn = 0;
+
+	// The combined estimate of all processes has a confidence interval about sqrt( num_processes ) times narrower than
+	// the estimate of a single process, so each process can stop at a proportionally larger error. The exact count of
+	// this process is scaled to approximate the exact count of all processes
+	double target_error_local = sample_target_error * sqrt( (double) num_processes );
+	double exact_local = sample_estimate.getEstimate( -1 );
+
+	// Root tasks are sampled with a probability proportional to their weight, and each sample is weighted by the inverse
+	// of its sampling probability
+	for ( long long i = 0; i < num_exact; i++ ) {
+		root_weights[ root_order[ i ] ] = 0;
+	}
+
+	std::mt19937_64 rng( sample_seed + process_id );
+	std::discrete_distribution<long long> root_distribution( root_weights.begin(), root_weights.end() );
+
+	while ( weight_drawn < max_weight_drawn ) {
+		TraceScope trace_scope( "samples", sample_estimate.getNumSamples() );
+
+		for ( int i = 0; i < SAMPLE_BATCH_SIZE && weight_drawn < max_weight_drawn; i++ ) {
+			long long root_index = root_distribution( rng );
+			sample_estimate.addSample( findRootCliques( root_index ), weights_total / root_weights[ root_index ] );
+			weight_drawn += root_weights[ root_index ];
+		}
+
+		double estimate = exact_local * num_processes + sample_estimate.getEstimate( -1 ) - exact_local;
+
+		if ( sample_estimate.getNumSamples() >= SAMPLE_MIN_SAMPLES && estimate > 0 && sample_estimate.getHalfWidth( -1, sample_confidence ) <= target_error_local * estimate ) {
+			break;
+		}
+	}
+
+	// The clique counts hold the cliques found under the root tasks counted exactly and the sampled root tasks, counting
+	// repeated samples repeatedly
+	dfs_cliques_count = cliques_count_sampled;
+}
+
+void CliqueFinder::setSampling( double target_error, double confidence, unsigned int seed ) {
+	sample_target_error = target_error;
+	sample_confidence = confidence;
+	sample_seed = seed;
+}
+
+SampleEstimate &CliqueFinder::getSampleEstimate() {
+	return sample_estimate;
+}
+
+int CliqueFinder::findCliquesEdgeRoot( int node_id, const std::vector<int> &node_forward, int neighbour_id, const AdjacencyList &forwardlist ) {
+	// A node can only be part of a clique with both end points if it is a forward neighbour of both
+	const auto neighbour_forward = forwardlist.find( neighbour_id );
+
+	if ( neighbour_forward == forwardlist.end() ) {
+		return 0;
+	}
+
+	SEARCH_STATS( stats.num_edge_checks += node_forward.size() + neighbour_forward->second.size() );
+
+	std::vector<int> potential_nodes;
+	std::set_intersection( node_forward.begin(), node_forward.end(), neighbour_forward->second.begin(), neighbour_forward->second.end(), std::back_inserter( potential_nodes ) );
+
+	if ( potential_nodes.empty() ) {
+		return 0;
+	}
+
+	// Each common forward neighbour completes a triangle with the root edge
+	if ( isWeighted() ) {
+		std::vector<long long> edge_polynomial = getCliquePolynomial( std::vector<int>( 1, node_id ), neighbour_id );
+
+		for ( int candidate_id : potential_nodes ) {
+			countWeightedCliques( edge_polynomial, candidate_id );
+		}
+	}
+	else {
+		dfs_cliques_count[ 3 ] += potential_nodes.size();
+	}
+
+	std::vector<int> base_nodes;
+	base_nodes.push_back( node_id );
+	base_nodes.push_back( neighbour_id );
+
+	if ( clique_writer != NULL && isCliqueSizeInRange( 3 ) ) {
+		for ( int candidate_id : potential_nodes ) {
+			clique_writer->writeClique( base_nodes, candidate_id );
+		}
+	}
+
+	if ( record_node_counts && isCliqueSizeInRange( 3 ) ) {
+		long long *node_counts = getNodeCliquesCountsArray( 3 );
+		node_counts[ node_id - node_id_min ] += potential_nodes.size();
+		node_counts[ neighbour_id - node_id_min ] += potential_nodes.size();
+
+		for ( int candidate_id : potential_nodes ) {
+			node_counts[ candidate_id - node_id_min ]++;
+		}
+	}
+
+	if ( potential_nodes.size() > 1 ) {
+		findCliquesDFS( 4, base_nodes, potential_nodes );
+	}
+
+	return potential_nodes.size();
+}
+
+std::vector<long long> CliqueFinder::countEdgeCliques( int node_id, int neighbour_id ) {
+	dfs_cliques_count.clear();
+
+	// Every clique in the common neighbourhood forms a clique with the edge, of which the single common neighbours form
+	// the triangles. Unlike for edge roots, all common neighbours are candidates, regardless of their ID
+	std::vector<int> potential_nodes = graph->getCommonNeighbours( node_id, neighbour_id );
+
+	if ( ! potential_nodes.empty() ) {
+		dfs_cliques_count[ 3 ] += potential_nodes.size();
+	}
+
+	if ( potential_nodes.size() > 1 ) {
+		std::vector<int> base_nodes;
+		base_nodes.push_back( std::min( node_id, neighbour_id ) );
+		base_nodes.push_back( std::max( node_id, neighbour_id ) );
+		findCliquesDFS( 4, base_nodes, potential_nodes );
+	}
+
+	return getCliquesCountsVector();
 }
 
 std::vector<long long> CliqueFinder::getCliquesCountsVector() {
@@ -67,7 +729,7 @@ std::vector<long long> CliqueFinder::getCliquesCountsVector() {
 			continue;
 		}
 
-		cliques_counts.push_back( dfs_cliques_count[ i ] );
+		cliques_counts.push_back( isCliqueSizeInRange( i ) ? dfs_cliques_count[ i ] : 0 );
 		i++;
 		num_sizes_processed++;
 	}
@@ -75,6 +737,179 @@ std::vector<long long> CliqueFinder::getCliquesCountsVector() {
 	return cliques_counts;
 }
 
+void CliqueFinder::setEdgeRoots( bool enable ) {
+	edge_roots = enable;
+}
+
+void CliqueFinder::setRootProfile( const RootProfile *profile ) {
+	root_profile = profile;
+}
+
+void CliqueFinder::setRecordRootCosts( bool enable ) {
+	record_root_costs = enable;
+}
+
+void CliqueFinder::setCliqueSizeRange( int size_min, int size_max ) {
+	clique_size_min = size_min;
+	clique_size_max = size_max;
+}
+
+bool CliqueFinder::isCliqueSizeInRange( int size ) {
+	return ( clique_size_min == 0 || size >= clique_size_min ) && ( clique_size_max == 0 || size <= clique_size_max );
+}
+
+void CliqueFinder::setCliqueWriter( CliqueWriter *writer ) {
+	clique_writer = writer;
+}
+
+std::vector<double> CliqueFinder::getRootCosts() {
+	return root_costs;
+}
+
+void CliqueFinder::setRecordNodeCounts( bool enable ) {
+	record_node_counts = enable;
+}
+
+long long *CliqueFinder::getNodeCliquesCountsArray( int size ) {
+	// The node ID range is only known once the graph is read
+	if ( node_cliques_counts.empty() ) {
+		node_id_min = graph->getNodeIdMin();
+		node_id_max = graph->getNodeIdMax();
+	}
+
+	if ( (int) node_cliques_counts.size() <= size ) {
+		node_cliques_counts.resize( size + 1 );
+	}
+
+	if ( node_cliques_counts[ size ].empty() ) {
+		node_cliques_counts[ size ].resize( (long long) node_id_max - node_id_min + 1, 0 );
+	}
+
+	return node_cliques_counts[ size ].data();
+}
+
+bool CliqueFinder::isWeighted() {
+	if ( node_polynomials_initialized ) {
+		return ! node_polynomials.empty();
+	}
+
+	node_polynomials_initialized = true;
+	const std::vector<int> &node_weights = graph->getNodeWeights();
+	node_polynomials.resize( node_weights.size() );
+	node_monomial_weights.resize( node_weights.size(), 0 );
+
+	for ( unsigned int node_id = 0; node_id < node_weights.size(); node_id++ ) {
+		std::vector<long long> &polynomial = node_polynomials[ node_id ];
+		int weight = node_weights[ node_id ];
+
+		if ( ! graph->areNodeTwinsAdjacent( node_id ) ) {
+			polynomial.push_back( 0 );
+			polynomial.push_back( weight );
+			node_monomial_weights[ node_id ] = weight;
+			continue;
+		}
+
+		// Binomial coefficients of the number of true twins
+		int num_chosen_max = ( clique_size_max > 0 ) ? std::min( weight, clique_size_max ) : weight;
+		polynomial.resize( num_chosen_max + 1, 0 );
+		long long num_choices = 1;
+
+		for ( int num_chosen = 1; num_chosen <= num_chosen_max; num_chosen++ ) {
+			num_choices = num_choices * ( weight - num_chosen + 1 ) / num_chosen;
+			polynomial[ num_chosen ] = num_choices;
+		}
+	}
+
+	return ! node_polynomials.empty();
+}
+
+void CliqueFinder::multiplyNodePolynomial( std::vector<long long> &polynomial, int node_id ) {
+	const std::vector<long long> &factor = node_polynomials[ node_id ];
+	unsigned int product_size = polynomial.size() + factor.size() - 1;
+
+	if ( clique_size_max > 0 ) {
+		product_size = std::min( product_size, (unsigned int) clique_size_max + 1 );
+	}
+
+	std::vector<long long> product( product_size, 0 );
+
+	for ( unsigned int a = 0; a < polynomial.size(); a++ ) {
+		if ( polynomial[ a ] == 0 ) {
+			continue;
+		}
+
+		for ( unsigned int b = 1; b < factor.size() && a + b < product_size; b++ ) {
+			product[ a + b ] += polynomial[ a ] * factor[ b ];
+		}
+	}
+
+	polynomial.swap( product );
+}
+
+std::vector<long long> CliqueFinder::getCliquePolynomial( const std::vector<int> &base_nodes, int node_id ) {
+	std::vector<long long> polynomial( 1, 1 );
+
+	for ( int base_node_id : base_nodes ) {
+		multiplyNodePolynomial( polynomial, base_node_id );
+	}
+
+	multiplyNodePolynomial( polynomial, node_id );
+
+	return polynomial;
+}
+
+void CliqueFinder::countWeightedCliques( const std::vector<long long> &polynomial, int node_id ) {
+	const std::vector<long long> &factor = node_polynomials[ node_id ];
+
+	for ( unsigned int a = 0; a < polynomial.size(); a++ ) {
+		if ( polynomial[ a ] == 0 ) {
+			continue;
+		}
+
+		for ( unsigned int b = 1; b < factor.size(); b++ ) {
+			int size = a + b;
+
+			if ( clique_size_max > 0 && size > clique_size_max ) {
+				break;
+			}
+
+			if ( size >= 3 ) {
+				dfs_cliques_count[ size ] += polynomial[ a ] * factor[ b ];
+			}
+		}
+	}
+}
+
+void CliqueFinder::countWeightedSmallCliques() {
+	// Polynomials of more than one coefficient beyond the constant term belong to true twins
+	std::vector<long long> empty_polynomial( 1, 1 );
+
+	for ( int node_id = process_id; node_id < (int) node_polynomials.size(); node_id += num_processes ) {
+		if ( node_polynomials[ node_id ].size() > 2 ) {
+			countWeightedCliques( empty_polynomial, node_id );
+		}
+	}
+
+	for ( const auto &node : graph->getForwardAdjacencyList( process_id, num_processes ) ) {
+		std::vector<long long> polynomial( 1, 1 );
+		multiplyNodePolynomial( polynomial, node.first );
+
+		for ( int neighbour_id : node.second ) {
+			if ( polynomial.size() > 2 || node_polynomials[ neighbour_id ].size() > 2 ) {
+				countWeightedCliques( polynomial, neighbour_id );
+			}
+		}
+	}
+}
+
+const std::vector<std::vector<long long> > &CliqueFinder::getNodeCliquesCounts() {
+	return node_cliques_counts;
+}
+
+int CliqueFinder::getNodeCliquesCountsIdMin() {
+	return node_id_min;
+}
+
 void CliqueFinder::temporarilyDisableHelp() {
 	help_disable_switch = true;
 	help_enabled = false;
@@ -97,17 +932,158 @@ void CliqueFinder::setHelpRequestThreshold( int threshold ) {
 }
 
 void CliqueFinder::calculateHelpRequestThreshold() {
-	setHelpRequestThreshold( std::max( 2, int( graph->getNumEdges() / graph->getNumNodes() * 5 ) ) );
+	setHelpRequestThreshold( std::max( 2, int( round( 5.0 * graph->getNumEdges() / graph->getNumNodes() ) ) ) );
+}
+
+void CliqueFinder::setHelpRequestThresholdAdaptive( bool enable ) {
+	help_threshold_adaptive = enable;
+}
+
+void CliqueFinder::updateHelpRequestThreshold( bool accepted, double latency ) {
+	double current_time = pm.getCurrentClockTime();
+
+	if ( help_threshold_current == 0 ) {
+		help_threshold_current = getHelpRequestThreshold();
+	}
+
+	// Exponentially weighted moving averages of the help request round-trip latency and of the time spent per candidate
+	// pair check since the previous help request
+	help_latency_average = ( help_latency_average == 0 ) ? latency : 0.8 * help_latency_average + 0.2 * latency;
+
+	if ( help_num_checks > 0 ) {
+		double time_per_check = ( current_time - latency - help_last_update_time ) / help_num_checks;
+		help_time_per_check_average = ( help_time_per_check_average == 0 ) ? time_per_check : 0.8 * help_time_per_check_average + 0.2 * time_per_check;
+	}
+
+	help_num_checks_previous += help_num_checks;
+	help_num_checks = 0;
+	help_last_update_time = current_time;
+
+	// Back off when no helpers are free: raise the threshold and skip an exponentially increasing number of request
+	// opportunities. Lower the threshold again while requests are accepted
+	if ( accepted ) {
+		help_threshold_current *= HELP_THRESHOLD_DECREASE_FACTOR;
+		help_num_consecutive_rejections = 0;
+		help_num_skipped_requests = 0;
+	}
+	else {
+		help_threshold_current *= HELP_THRESHOLD_INCREASE_FACTOR;
+		help_num_consecutive_rejections++;
+		help_num_skipped_requests = ( 1 << std::min( help_num_consecutive_rejections, HELP_MAX_BACKOFF_EXPONENT ) ) - 1;
+	}
+
+	// The work at the current level of the remaining subtree of r candidates is about r^2 / 2 pair checks. Only
+	// subtrees whose estimated work takes several help request round-trips are worth requesting help for
+	double threshold_min = 2;
+
+	if ( help_time_per_check_average > 0 ) {
+		threshold_min = std::max( threshold_min, sqrt( 2 * HELP_LATENCY_WORK_RATIO * help_latency_average / help_time_per_check_average ) );
+	}
+
+	help_threshold_current = std::min( std::max( help_threshold_current, threshold_min ), (double) HELP_MAX_THRESHOLD );
+
+	int threshold_previous = help_degree_threshold;
+	setHelpRequestThreshold( int( help_threshold_current ) );
+
+	if ( help_degree_threshold != threshold_previous ) {
+		recordHelpRequestThreshold();
+	}
 }
 
-void CliqueFinder::findCliquesDFS( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int start, int end ) {
+void CliqueFinder::recordHelpRequestThreshold() {
+	// When the trajectory is full, keep every other sample and only record every other change from now on, so that the
+	// trajectory covers the entire run with a bounded number of samples
+	if ( help_threshold_trajectory.size() >= 2 * HELP_MAX_TRAJECTORY_SAMPLES ) {
+		for ( unsigned int i = 1; i < HELP_MAX_TRAJECTORY_SAMPLES / 2; i++ ) {
+			help_threshold_trajectory[ 2 * i ] = help_threshold_trajectory[ 4 * i ];
+			help_threshold_trajectory[ 2 * i + 1 ] = help_threshold_trajectory[ 4 * i + 1 ];
+		}
+
+		help_threshold_trajectory.resize( HELP_MAX_TRAJECTORY_SAMPLES );
+		help_trajectory_stride *= 2;
+	}
+
+	if ( help_num_threshold_changes++ % help_trajectory_stride != 0 ) {
+		return;
+	}
+
+	help_threshold_trajectory.push_back( pm.getCurrentClockTime() - pm.getStartTime() );
+	help_threshold_trajectory.push_back( getHelpRequestThreshold() );
+}
+
+std::vector<double> CliqueFinder::getHelpRequestThresholdTrajectory() {
+	// Always include the final threshold
+	std::vector<double> trajectory = help_threshold_trajectory;
+	trajectory.push_back( pm.getCurrentClockTime() - pm.getStartTime() );
+	trajectory.push_back( getHelpRequestThreshold() );
+
+	return trajectory;
+}
+
+void CliqueFinder::findCliquesDFS( int depth, const std::vector<int> &base_nodes, const std::vector<int> &potential_nodes, int start, int end ) {
 	if ( start == -1 ) {
 		start = 0;
 		end = potential_nodes.size();
 	}
 
+	// Cliques at this depth are larger than the largest clique size to count
+	if ( clique_size_max > 0 && depth > clique_size_max ) {
+		return;
+	}
+
+	// Whether the cliques found at this depth should be listed
+	bool list_cliques = ( clique_writer != NULL && isCliqueSizeInRange( depth ) );
+
+	// Clique counts per node of the cliques found at this depth, if recorded. The array is only obtained once a clique is
+	// found, so that clique sizes without cliques have no array
+	bool record_depth_node_counts = ( record_node_counts && isCliqueSizeInRange( depth ) );
+	long long *node_counts = NULL;
+
+	// Number of cliques of the input graph the base nodes stand for if the graph has collapsed twins, or 0 if some of the
+	// base nodes are true twins
+	bool weighted = isWeighted();
+	long long base_weight = 1;
+
+	if ( weighted ) {
+		for ( int node_id : base_nodes ) {
+			base_weight *= node_monomial_weights[ node_id ];
+		}
+	}
+
+	// Base nodes of the next level. Listing cliques, recording node clique counts and collapsed twins need the whole
+	// clique of the base nodes and the current candidate node, to which the candidate node is added and removed again
+	// around every descent; otherwise only the current candidate node is passed down
+	bool full_prefix = ( clique_writer != NULL || record_node_counts || weighted );
+	std::vector<int> new_base_nodes;
+
+	if ( full_prefix ) {
+		new_base_nodes.reserve( base_nodes.size() + 1 );
+		new_base_nodes = base_nodes;
+	}
+
+	SEARCH_STATS( stats.addCandidates( depth, potential_nodes.size() ) );
+
+	// Frame of this call, from which a checkpoint takes the remaining candidates
+	if ( checkpointer != NULL ) {
+		if ( (int) dfs_frames.size() <= depth ) {
+			dfs_frames.resize( depth + 1 );
+		}
+
+		dfs_frames[ depth ] = { &base_nodes, &potential_nodes, start, end, dfs_depth };
+		dfs_depth = depth;
+	}
+
 	// Loop over potential nodes
 	for ( int i = start; i < end; i++ ) {
+		if ( checkpointer != NULL ) {
+			dfs_frames[ depth ].current = i;
+		}
+
+		// Take checkpoints, publish the progress and stop the search once the deadline has passed
+		if ( periodic_checks && --check_countdown <= 0 && checkPeriodic() ) {
+			break;
+		}
+
 		// If the help disable switch is turned on, no help will be requested. This ensures that no infinite loop
 		// will occur where help is continually requested
 		if ( help_disable_switch ) {
@@ -115,38 +1091,121 @@ void CliqueFinder::findCliquesDFS( int depth, std::vector<int> base_nodes, std::
 			help_disable_switch = false;
 		}
 		else if ( help_enabled && end - i > getHelpRequestThreshold() ) {
-			num_help_requests_sent++;
-
-			// Request help through process
-			if ( process->requestHelp() ) {
-				// Help has been granted, so we can pass the remaining part of this DFS branch to the helper process
-				// through the current slave process
-				process->grantHelp( depth, base_nodes, potential_nodes, i, end );
-				num_help_requests_sent_accepted++;
-				return;
+			if ( help_threshold_adaptive && help_num_skipped_requests > 0 ) {
+				// Back off from requesting help after rejected requests
+				help_num_skipped_requests--;
 			}
+			else {
+				num_help_requests_sent++;
+
+				// Request help through process
+				double request_time = help_threshold_adaptive ? pm.getCurrentClockTime() : 0;
+				SEARCH_STATS( double stats_request_time = pm.getCurrentClockTime() );
+				bool accepted = process->requestHelp();
+				SEARCH_STATS( stats.help_request_time += pm.getCurrentClockTime() - stats_request_time );
 
-			num_help_requests_sent_rejected++;
+				if ( help_threshold_adaptive ) {
+					updateHelpRequestThreshold( accepted, pm.getCurrentClockTime() - request_time );
+				}
+
+				if ( accepted ) {
+					// Help has been granted, so we can pass the remaining part of this DFS branch to the helper process
+					// through the current slave process
+					if ( checkpointer != NULL ) {
+						dfs_depth = dfs_frames[ depth ].parent_depth;
+					}
+
+					process->grantHelp( depth, base_nodes, potential_nodes, i, end );
+					num_help_requests_sent_accepted++;
+					return;
+				}
+
+				num_help_requests_sent_rejected++;
+			}
 		}
 
 		// Core of algorithm
-		std::vector<int> new_base_nodes;
 		std::vector<int> new_potential_nodes;
 
 		// Internal loop: check for edges between potential nodes
+		help_num_checks += potential_nodes.size() - i - 1;
+		dfs_num_nodes++;
+		SEARCH_STATS( stats.addNode( depth ) );
+		SEARCH_STATS( stats.num_edge_checks += potential_nodes.size() - i - 1 );
+
+		// With collapsed twins, the cliques without true twins are counted at once after the edge checks, as the
+		// product of the weights of the base nodes and the current candidate node and the sum of the weights of the new
+		// candidate nodes. Cliques with true twins are counted by their polynomial, which is only computed for them
+		long long candidate_weight = weighted ? base_weight * node_monomial_weights[ potential_nodes[ i ] ] : 0;
+		long long new_candidates_weight = 0;
+		std::vector<long long> candidate_polynomial;
+
 		for ( int j = i + 1; j < potential_nodes.size(); j++ ) {
 			if ( graph->isEdge( potential_nodes[ i ], potential_nodes[ j ] ) ) {
 				// Clique was found
 				new_potential_nodes.push_back( potential_nodes[ j ] );
-				dfs_cliques_count[ depth ]++;
+
+				if ( ! weighted ) {
+					dfs_cliques_count[ depth ]++;
+				}
+				else if ( candidate_weight != 0 && node_monomial_weights[ potential_nodes[ j ] ] != 0 ) {
+					new_candidates_weight += node_monomial_weights[ potential_nodes[ j ] ];
+				}
+				else {
+					if ( candidate_polynomial.empty() ) {
+						candidate_polynomial = getCliquePolynomial( base_nodes, potential_nodes[ i ] );
+					}
+
+					countWeightedCliques( candidate_polynomial, potential_nodes[ j ] );
+				}
+
+				if ( list_cliques ) {
+					clique_writer->writeClique( base_nodes, potential_nodes[ i ], potential_nodes[ j ] );
+				}
 			}
 		}
 
-		// Move down the BFS tree
-		if ( new_potential_nodes.size() > 1 ) {
-			new_base_nodes.push_back( potential_nodes[ i ] );
-			findCliquesDFS( depth + 1, new_base_nodes, new_potential_nodes );
+		if ( new_candidates_weight > 0 ) {
+			dfs_cliques_count[ depth ] += candidate_weight * new_candidates_weight;
 		}
+
+		// Each clique found consists of the base nodes, the current candidate node and one of the new candidate nodes
+		if ( record_depth_node_counts && ! new_potential_nodes.empty() ) {
+			if ( node_counts == NULL ) {
+				node_counts = getNodeCliquesCountsArray( depth );
+			}
+
+			for ( int node_id : base_nodes ) {
+				node_counts[ node_id - node_id_min ] += new_potential_nodes.size();
+			}
+
+			node_counts[ potential_nodes[ i ] - node_id_min ] += new_potential_nodes.size();
+
+			for ( int node_id : new_potential_nodes ) {
+				node_counts[ node_id - node_id_min ]++;
+			}
+		}
+
+		// Move down the BFS tree, unless the cliques found there are larger than the largest clique size to count
+		if ( new_potential_nodes.size() > 1 && ( clique_size_max == 0 || depth < clique_size_max ) ) {
+			if ( full_prefix ) {
+				new_base_nodes.push_back( potential_nodes[ i ] );
+				findCliquesDFS( depth + 1, new_base_nodes, new_potential_nodes );
+				new_base_nodes.pop_back();
+			}
+			else {
+				new_base_nodes.assign( 1, potential_nodes[ i ] );
+				findCliquesDFS( depth + 1, new_base_nodes, new_potential_nodes );
+			}
+		}
+
+		if ( depth == progress_root_depth ) {
+			progress_task_work += potential_nodes.size() - i - 1;
+		}
+	}
+
+	if ( checkpointer != NULL ) {
+		dfs_depth = dfs_frames[ depth ].parent_depth;
 	}
 }
 
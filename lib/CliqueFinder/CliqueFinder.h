@@ -13,20 +13,36 @@
 #include <boost/functional/hash.hpp>
 
 // Program includes
-#include "../Process/ProcessSlave.h"
+#include "HelpChannel.h"
 #include "../Graph/Graph.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+#include "SearchStats.h"
+#include "SampleEstimate.h"
+#include "CliqueWriter.h"
+#include "../Checkpoint/Checkpointer.h"
+#include "../Progress/ProgressBoard.h"
+#include "../Planner/RootProfile.h"
 
-// Temporary class definitions
+// Adaptive help request threshold parameters
 // ==========
-class ProcessSlave;
+const double HELP_THRESHOLD_INCREASE_FACTOR = 1.25;
+const double HELP_THRESHOLD_DECREASE_FACTOR = 0.8;
+const double HELP_LATENCY_WORK_RATIO = 4;
+const int HELP_MAX_THRESHOLD = 1 << 20;
+const int HELP_MAX_BACKOFF_EXPONENT = 10;
+const unsigned int HELP_MAX_TRAJECTORY_SAMPLES = 64;
+
+// Number of iterations of the search between two periodic checks, which take checkpoints when due, publish the progress
+// and check whether the deadline has passed
+const int PERIODIC_CHECK_ITERATIONS = 4096;
 
 class CliqueFinder {
 
 	private:
 		/**
-		 * Corresponding multiprocessing process
+		 * Channel through which help is requested from other processes, usually the corresponding multiprocessing process
 		 */
-		ProcessSlave *process;
+		HelpChannel *process;
 
 		/**
 		 * The graph on which calculations have to be done
@@ -40,7 +56,8 @@ class CliqueFinder {
 		std::map<int,long long> dfs_cliques_count;
 
 		/**
-		 * Parallel computation settings
+		 * Parallel computation settings. The process ID is the index of this process among the processes taking
+		 * part in the computation, and thus ranges from 0 to num_processes - 1
 		 */
 		int process_id;
 		int num_processes;
@@ -52,24 +69,340 @@ class CliqueFinder {
 		bool help_disable_switch = false;
 		int help_degree_threshold = 0;
 
+		/**
+		 * Adaptive help request threshold settings and state. The threshold is adjusted at runtime from the outcome and
+		 * round-trip latency of help requests, backing off while no helpers are free
+		 */
+		bool help_threshold_adaptive = false;
+		double help_threshold_current = 0;
+		double help_latency_average = 0;
+		double help_time_per_check_average = 0;
+		double help_last_update_time = 0;
+		long long help_num_checks = 0;
+		long long help_num_checks_previous = 0;
+		int help_num_consecutive_rejections = 0;
+		int help_num_skipped_requests = 0;
+
+		/**
+		 * Trajectory of the help request threshold over time, downsampled by keeping every help_trajectory_stride-th change
+		 * Format: ( [time-0], [threshold-0], ..., [time-i], [threshold-i] )
+		 */
+		std::vector<double> help_threshold_trajectory;
+		long long help_num_threshold_changes = 0;
+		int help_trajectory_stride = 1;
+
+		/**
+		 * Progress monitor object to track time
+		 */
+		ProgressMonitor pm;
+
+		/**
+		 * Whether the root tasks of the search are oriented edges (u, v) instead of single nodes
+		 */
+		bool edge_roots = false;
+
+		/**
+		 * Cost of each root task processed by this process, if recording root task costs is enabled: its time and its
+		 * number of search tree nodes, i.e. of candidate nodes visited. The root ID is the node ID for node root tasks
+		 * and the edge index for edge root tasks
+		 * Format: ( [root_id-0], [num_candidates-0], [seconds-0], [num_nodes-0], ..., [root_id-i], [num_candidates-i],
+		 * [seconds-i], [num_nodes-i] )
+		 */
+		bool record_root_costs = false;
+		std::vector<double> root_costs;
+
+		/**
+		 * Number of search tree nodes visited so far, from which the number of search tree nodes of each root task is
+		 * recorded
+		 */
+		long long dfs_num_nodes = 0;
+
+		/**
+		 * Profile of the root task costs of an earlier run, by which the root tasks are partitioned over the processes,
+		 * or NULL to partition them by ID
+		 */
+		const RootProfile *root_profile = NULL;
+
+		/**
+		 * Smallest and largest clique size to count, or 0 for no limit. The search does not descend beyond the largest
+		 * clique size
+		 */
+		int clique_size_min = 0;
+		int clique_size_max = 0;
+
+		/**
+		 * Writer to list all cliques found within the clique size range to, or NULL if cliques are only counted
+		 */
+		CliqueWriter *clique_writer = NULL;
+
+		/**
+		 * Number of cliques each node belongs to per clique size, if recording node clique counts is enabled. Dense
+		 * arrays over the node ID range of the graph, allocated once cliques of a size are found
+		 * Format: node_cliques_counts[ clique_size ][ node_id - node_id_min ]
+		 */
+		bool record_node_counts = false;
+		int node_id_min = 0;
+		int node_id_max = -1;
+		std::vector<std::vector<long long> > node_cliques_counts;
+
+		/**
+		 * Get the node clique counts array of a clique size, allocating it if needed
+		 *
+		 * @param int size Clique size
+		 * @return long long* Clique counts, indexed by node ID minus the smallest node ID
+		 */
+		long long *getNodeCliquesCountsArray( int size );
+
+		/**
+		 * Number of ways to choose nodes of the input graph from the nodes a node stands for, if the graph has collapsed
+		 * twins (see TwinCompression), as a polynomial in the number of nodes chosen: x for a single node, w x for a class
+		 * of w false twins and (1 + x)^w - 1 for a class of w true twins. A clique of the collapsed graph stands for as
+		 * many cliques of every size of the input graph as the coefficients of the product of the polynomials of its
+		 * nodes. Truncated beyond the largest clique size to count, and empty if the graph has no collapsed twins
+		 * Format: node_polynomials[ node_id ][ num_nodes_chosen ] = num_choices
+		 */
+		bool node_polynomials_initialized = false;
+		std::vector<std::vector<long long> > node_polynomials;
+
+		/**
+		 * Coefficient w of every node whose polynomial is w x, i.e. of single nodes and false twins, or 0 for true twins.
+		 * A clique of such nodes stands for cliques of the same size of the input graph, as many as the product of the
+		 * coefficients of its nodes, so that the search counts these cliques without polynomials
+		 */
+		std::vector<long long> node_monomial_weights;
+
+		/**
+		 * Check whether cliques are counted by the polynomials of their nodes, computing the polynomials on first use
+		 *
+		 * @return bool Whether the graph has collapsed twins
+		 */
+		bool isWeighted();
+
+		/**
+		 * Multiply a polynomial by the polynomial of a node, truncated beyond the largest clique size to count
+		 *
+		 * @param std::vector<long long>& polynomial Polynomial of a clique, indexed by number of nodes chosen
+		 * @param int node_id Node ID
+		 */
+		void multiplyNodePolynomial( std::vector<long long> &polynomial, int node_id );
+
+		/**
+		 * Get the polynomial of a clique, as the product of the polynomials of its nodes
+		 *
+		 * @param const std::vector<int>& base_nodes Base nodes of the clique
+		 * @param int node_id Further node of the clique
+		 * @return std::vector<long long> Polynomial of the clique, indexed by number of nodes chosen
+		 */
+		std::vector<long long> getCliquePolynomial( const std::vector<int> &base_nodes, int node_id );
+
+		/**
+		 * Count the cliques of three nodes or more of the input graph that a clique of the collapsed graph stands for, as
+		 * the coefficients of the product of the polynomial of part of the clique and the polynomial of its last node
+		 *
+		 * @param const std::vector<long long>& polynomial Polynomial of the clique without its last node
+		 * @param int node_id Last node of the clique
+		 */
+		void countWeightedCliques( const std::vector<long long> &polynomial, int node_id );
+
+		/**
+		 * Count the cliques of the input graph within single nodes and edges of the collapsed graph, which no root task
+		 * covers. Only classes of true twins stand for several nodes of a clique, so that only their nodes and edges stand
+		 * for cliques of three nodes or more. The nodes are partitioned over the processes by ID
+		 */
+		void countWeightedSmallCliques();
+
+		/**
+		 * Sampling settings: target relative error of the estimated total number of cliques, or 0 to count exactly,
+		 * confidence level of the error, and the seed of the random number generator, to which the process ID is added
+		 */
+		double sample_target_error = 0;
+		double sample_confidence = 0.95;
+		unsigned int sample_seed = 0;
+
+		/**
+		 * Estimate of the number of cliques from the root tasks sampled by this process
+		 */
+		SampleEstimate sample_estimate;
+
+		/**
+		 * Checkpointer recording the state of the search at every checkpoint, or NULL if checkpointing is disabled
+		 */
+		Checkpointer *checkpointer = NULL;
+
+		/**
+		 * Root tasks (node IDs, or edge indices if edge roots are enabled) and help tasks to process if checkpointing or
+		 * a root cost profile is enabled, and the index of the next root task and help task to process. Help tasks come
+		 * from the checkpoint the search is resumed from, as do the root tasks if checkpoint_resumed is set
+		 */
+		std::vector<long long> checkpoint_roots;
+		std::vector<HelpTask> checkpoint_tasks;
+		unsigned long long checkpoint_root_index = 0;
+		unsigned int checkpoint_task_index = 0;
+		bool checkpoint_resumed = false;
+
+		/**
+		 * Active calls of findCliquesDFS() by depth, if checkpointing is enabled, from which a checkpoint takes the
+		 * remaining candidates of the search: the node lists of the call, the index of its current candidate, the end of
+		 * its candidates, and the depth of the calling call (0 for none). dfs_depth is the depth of the innermost active
+		 * call, or 0 if there is none
+		 */
+		struct DFSFrame {
+			const std::vector<int> *base_nodes;
+			const std::vector<int> *potential_nodes;
+			int current;
+			int end;
+			int parent_depth;
+		};
+
+		std::vector<DFSFrame> dfs_frames;
+		int dfs_depth = 0;
+
+		/**
+		 * Time budget of the search in seconds, or 0 for none, the clock time at which it runs out (0 if there is no
+		 * deadline), and whether it has run out. Once the deadline has passed, the search stops at its next check
+		 */
+		double deadline = 0;
+		double deadline_time = 0;
+		bool deadline_reached = false;
+
+		/**
+		 * Whether the search makes periodic checks, i.e. whether checkpointing, a deadline or progress reporting is
+		 * enabled, and the number of iterations of the search left until the next check
+		 */
+		bool periodic_checks = false;
+		int check_countdown = PERIODIC_CHECK_ITERATIONS;
+
+		/**
+		 * Clique counts at the start of the current root task or help task, to which they are restored if the deadline
+		 * interrupts the task
+		 */
+		std::map<int,long long> deadline_task_cliques_count;
+
+		/**
+		 * Number of root tasks of this process and their estimated work, in total and of the tasks completed. Only
+		 * tracked if there is a deadline or the progress is reported
+		 */
+		bool progress_tracked = false;
+		long long progress_num_roots = 0;
+		long long progress_num_roots_completed = 0;
+		double progress_work = 0;
+		double progress_work_completed = 0;
+
+		/**
+		 * Depth of the candidates of node root tasks if the progress is tracked, or 0 otherwise, and the work of the
+		 * candidates at that depth completed in the current task. The work of a node root task is divided over its
+		 * candidates by the number of candidate pairs each of them checks, so that the candidates handed over to helpers
+		 * are credited to the helper completing them
+		 */
+		int progress_root_depth = 0;
+		double progress_task_work = 0;
+
+		/**
+		 * Board the progress record of this process is published to, or NULL if the progress is not reported, the time
+		 * (in seconds) between two progress lines, and the clock time of the latest publication
+		 */
+		ProgressBoard *progress_board = NULL;
+		double progress_interval = 0;
+		double progress_publish_time = 0;
+
+		/**
+		 * Make the periodic checks of the search: take a checkpoint if one is due, publish the progress and check whether
+		 * the deadline has passed
+		 *
+		 * @return bool Whether the search should stop
+		 */
+		bool checkPeriodic();
+
+		/**
+		 * Check whether the deadline has passed, taking a final snapshot of the search if it has just passed and
+		 * checkpointing is enabled
+		 *
+		 * @return bool Whether the search should stop
+		 */
+		bool checkDeadline();
+
+		/**
+		 * Get the estimated work of a root task: the number of candidate node pairs it starts with, as for sampling
+		 *
+		 * @param double num_candidates Number of candidate nodes of the root task, or an upper bound on it
+		 * @return double Estimated work
+		 */
+		double getRootWork( double num_candidates );
+
+		/**
+		 * Get the estimated work of a range of candidates of a node root task, see progress_root_depth
+		 *
+		 * @param int num_candidates Number of candidate nodes of the root task
+		 * @param int start Index of the first candidate of the range
+		 * @param int end Index after the last candidate of the range
+		 * @return double Estimated work
+		 */
+		double getRootCandidatesWork( int num_candidates, int start, int end );
+
+		/**
+		 * Get the number of candidate nodes of an edge root task, bounded from above by the smaller forward neighbourhood
+		 * of its end points, as computing the candidates would take as long as the edge checks of the task itself
+		 *
+		 * @param const std::vector<int>& node_forward Sorted higher-ID neighbours of the source node
+		 * @param int neighbour_id Target node of the edge
+		 * @param const AdjacencyList& forwardlist Sorted higher-ID neighbours of all nodes
+		 * @return double Upper bound on the number of candidate nodes
+		 */
+		double getEdgeRootNumCandidatesMax( const std::vector<int> &node_forward, int neighbour_id, const AdjacencyList &forwardlist );
+
+		/**
+		 * Find all cliques of the listed root tasks and help tasks to process if checkpointing or a root cost profile is
+		 * enabled, taking a snapshot of the search whenever a checkpoint is due
+		 */
+		void findAllCliquesListed();
+
+		/**
+		 * Take a snapshot of the search if a checkpoint is due
+		 */
+		void checkCheckpoint();
+
+		/**
+		 * Find the cliques containing an oriented edge (u, v) with u < v, i.e. the cliques of the root task of the edge
+		 *
+		 * @param int node_id Source node u of the edge
+		 * @param const std::vector<int>& node_forward Sorted higher-ID neighbours of u
+		 * @param int neighbour_id Target node v of the edge
+		 * @param const AdjacencyList& forwardlist Sorted higher-ID neighbours of all nodes
+		 * @return int Number of candidate nodes of the root task, i.e. common higher-ID neighbours of u and v
+		 */
+		int findCliquesEdgeRoot( int node_id, const std::vector<int> &node_forward, int neighbour_id, const AdjacencyList &forwardlist );
+
+		/**
+		 * Check whether a clique size lies within the range of clique sizes to count
+		 *
+		 * @param int size Clique size
+		 * @return bool Whether cliques of this size are counted
+		 */
+		bool isCliqueSizeInRange( int size );
+
 	public:
 		// Help requests statistics
 		long long num_help_requests_sent = 0;
 		long long num_help_requests_sent_rejected = 0;
 		long long num_help_requests_sent_accepted = 0;
+
+#ifdef CLIQUES_STATS
+		// Search statistics, only collected when compiled with CLIQUES_STATS
+		SearchStats stats;
+#endif
 		
 		/**
 		 * Constructor
 		 *
-		 * @param SlaveProcess *process Process associated with this part of calculations
+		 * @param HelpChannel *process Process associated with this part of calculations. May be NULL if help is disabled
 		 */
-		CliqueFinder( ProcessSlave *process, Graph *graph ) : process(process), graph(graph) {}
+		CliqueFinder( HelpChannel *process, Graph *graph ) : process(process), graph(graph) {}
 
 		/**
 		 * Initialize parallel computation configuration for determining the part of computation that
 		 * should be covered by each particular process.
 		 *
-		 * @param int process_id_local Process ID
+		 * @param int process_id_local Index of the process among the processes taking part in the computation
 		 * @param int num_processes_local Number of processes working on the calculations in parallel
 		 * @param bool help_enabled_local Whether dynamic load balancing is enabled
 		 */
@@ -80,15 +413,210 @@ class CliqueFinder {
 		 */
 		void findAllCliquesDFS();
 
+		/**
+		 * Find all cliques using oriented edges (u, v), with u < v, as root tasks instead of single nodes. The initial
+		 * candidate set of each root edge is the intersection of the higher-ID neighbourhoods of u and v. Because
+		 * the number of root tasks grows with the number of edges, a single hub node no longer forms one task that is
+		 * far larger than all other tasks.
+		 */
+		void findAllCliquesDFSEdgeRoots();
+
+		/**
+		 * Count the cliques containing an edge (u, v), by searching the subgraph induced by the common neighbours of u
+		 * and v only, without help. The edge itself need not be in the graph, so that the cliques an edge insertion adds
+		 * can be counted before or after inserting it. Resets the clique counts of this clique finder
+		 *
+		 * @param int node_id Node u
+		 * @param int neighbour_id Node v
+		 * @return std::vector<long long> Number of cliques containing the edge per clique size within the clique size
+		 * range, indexed by clique size
+		 */
+		std::vector<long long> countEdgeCliques( int node_id, int neighbour_id );
+
+		/**
+		 * Enable or disable the use of oriented edges as root tasks.
+		 *
+		 * @param bool enable Whether to use edges (true) or nodes (false) as root tasks
+		 */
+		void setEdgeRoots( bool enable );
+
+		/**
+		 * Estimate the number of cliques from root tasks (nodes, or oriented edges if edge roots are enabled) sampled
+		 * uniformly at random with replacement, until the confidence interval of the estimated total number of cliques of
+		 * all processes is expected to be within the target relative error
+		 */
+		void findAllCliquesSampled();
+
+		/**
+		 * Enable/disable estimating the number of cliques by sampling root tasks instead of counting them exactly
+		 *
+		 * @param double target_error Target relative error of the estimated total number of cliques (e.g. 0.01), or 0 to
+		 * count exactly
+		 * @param double confidence Confidence level of the target error (e.g. 0.95)
+		 * @param unsigned int seed Seed of the random number generator, to which the process ID is added
+		 */
+		void setSampling( double target_error, double confidence, unsigned int seed );
+
+		/**
+		 * Get the estimate of the number of cliques from the root tasks sampled by this process
+		 *
+		 * @return SampleEstimate& Sample estimate
+		 */
+		SampleEstimate &getSampleEstimate();
+
+		/**
+		 * Enable/disable recording the cost (time and number of search tree nodes) of each root task, for replaying the
+		 * computation in the load balancing simulator and as root cost profile of later runs. Help requests and help
+		 * provided by other processes affect the recorded costs, so costs are best recorded without dynamic load
+		 * balancing
+		 *
+		 * @param bool enable Whether root task costs should be recorded
+		 */
+		void setRecordRootCosts( bool enable );
+
+		/**
+		 * Partition the root tasks over the processes by their measured cost in an earlier run instead of by ID, so
+		 * that the processes get root tasks of nearly equal total cost and rarely need help. Should be the same profile
+		 * for all processes
+		 *
+		 * @param const RootProfile* profile Root cost profile read for the graph and type of root tasks of the search, or
+		 * NULL to partition by ID
+		 */
+		void setRootProfile( const RootProfile *profile );
+
+		/**
+		 * Get the recorded root task costs
+		 *
+		 * @return std::vector<double> Root ID, number of candidate nodes, time in seconds and number of search tree
+		 * nodes per root task, see ROOT_COST_RECORD_SIZE
+		 */
+		std::vector<double> getRootCosts();
+
+		/**
+		 * Enable/disable recording the number of cliques each node belongs to, per clique size within the clique size
+		 * range
+		 *
+		 * @param bool enable Whether node clique counts should be recorded
+		 */
+		void setRecordNodeCounts( bool enable );
+
+		/**
+		 * Get the recorded node clique counts. Sizes without cliques have empty arrays
+		 *
+		 * @return const std::vector<std::vector<long long> >& Clique counts, indexed by clique size and by node ID minus
+		 * the smallest node ID
+		 */
+		const std::vector<std::vector<long long> > &getNodeCliquesCounts();
+
+		/**
+		 * Get the smallest node ID of the node clique counts arrays
+		 *
+		 * @return int Node ID
+		 */
+		int getNodeCliquesCountsIdMin();
+
+		/**
+		 * Set the range of clique sizes to count. Cliques of other sizes are reported as 0, and the search is cut off at
+		 * the largest clique size, so that a small maximum clique size speeds up the search
+		 *
+		 * @param int size_min Smallest clique size to count, or 0 for no limit
+		 * @param int size_max Largest clique size to count, or 0 for no limit
+		 */
+		void setCliqueSizeRange( int size_min, int size_max );
+
+		/**
+		 * Set the writer to list all cliques found within the clique size range to
+		 *
+		 * @param CliqueWriter* writer Clique writer, or NULL to only count cliques
+		 */
+		void setCliqueWriter( CliqueWriter *writer );
+
+		/**
+		 * Enable checkpointing of the search, optionally resuming it. Only exact counting of cliques is checkpointed; the
+		 * search is not checkpointed if it is sampled, or if node clique counts are recorded or cliques are listed
+		 *
+		 * @param Checkpointer* checkpointer_local Checkpointer of this process
+		 * @param CheckpointSnapshot* resumed Optional. Part of the resumed state of the search assigned to this process,
+		 * which replaces its root tasks, or NULL to start from scratch
+		 */
+		void setCheckpointer( Checkpointer *checkpointer_local, CheckpointSnapshot *resumed = NULL );
+
+		/**
+		 * Get the state of the search for a checkpoint: the cliques counted so far, the root tasks and help tasks not
+		 * started yet, and the remaining candidates of the active calls of the search
+		 *
+		 * @return CheckpointSnapshot Snapshot, of which the fields describing the process are left to the checkpointer
+		 */
+		CheckpointSnapshot getCheckpointSnapshot();
+
+		/**
+		 * Set the time budget of the search. Once it has run out, all root tasks and help tasks still to be processed are
+		 * skipped, and the clique counts of the task being processed are discarded, so that the counts hold the cliques
+		 * of the completed tasks. Does not apply to sampling, which has its own budget
+		 *
+		 * @param double seconds Time in seconds from the start of the search, or 0 for no deadline
+		 */
+		void setDeadline( double seconds );
+
+		/**
+		 * Check whether the deadline of the search has passed
+		 *
+		 * @return bool Whether the search stopped at the deadline
+		 */
+		bool isDeadlineReached();
+
+		/**
+		 * Start a root task or help task, recording the clique counts if there is a deadline
+		 */
+		void beginTask();
+
+		/**
+		 * Complete a root task or help task started by beginTask(), restoring the clique counts if the deadline
+		 * interrupted the task
+		 *
+		 * @param bool root Whether the task is a root task
+		 * @param double work Estimated work of the task on top of the work of its node root task candidates, i.e. the
+		 * work of an edge root task
+		 * @return bool Whether the task was completed before the deadline
+		 */
+		bool endTask( bool root = false, double work = 0 );
+
+		/**
+		 * Get the progress record of this process: the number of root tasks in total and completed, their estimated work
+		 * in total and completed (see getRootWork()), and the number of edge checks so far. The root tasks and work are 0
+		 * unless the progress is tracked
+		 *
+		 * @return std::vector<long long> Progress record, see PROGRESS_* in ProgressBoard.h
+		 */
+		std::vector<long long> getProgressRecord();
+
+		/**
+		 * Enable progress reporting. The progress record of this process is published to the board periodically during
+		 * the search, twice per progress line
+		 *
+		 * @param ProgressBoard* board Board to publish the progress record to
+		 * @param double interval Time (in seconds) between two progress lines
+		 */
+		void setProgressBoard( ProgressBoard *board, double interval );
+
+		/**
+		 * Publish the progress record of this process, if progress reporting is enabled and the previous publication
+		 * was at least half an interval ago
+		 *
+		 * @param bool force Optional. Whether to publish regardless of the time of the previous publication
+		 */
+		void publishProgress( bool force = false );
+
 		/**
 		 * Traverse down the clique-finding depth-first search tree. Given a base (k-1)-clique and all nodes that can be added to form a k-clique,
 		 * it traverses down the clique tree and finds (k+1)-cliques.
 		 *
 		 * @param int depth Depth of new search (k+1)
-		 * @param vector<int> base_nodes Node list of known base clique (k-1)
-		 * @param vector<int> potential_nodes List of nodes that can, individually, all be added to the (k-1)-clique to form a k-clique.
+		 * @param const vector<int>& base_nodes Node list of known base clique (k-1), or only its last node if neither
+		 * cliques are listed, node clique counts are recorded nor the graph has collapsed twins
+		 * @param const vector<int>& potential_nodes List of nodes that can, individually, all be added to the (k-1)-clique to form a k-clique.
 		 */
-		void findCliquesDFS( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int start = -1, int end = -1 );
+		void findCliquesDFS( int depth, const std::vector<int> &base_nodes, const std::vector<int> &potential_nodes, int start = -1, int end = -1 );
 
 		/**
 		 * Retrieve a vector of clique counts. This should be called after processing has completed.
@@ -131,6 +659,35 @@ class CliqueFinder {
 		 */
 		void calculateHelpRequestThreshold();
 
+		/**
+		 * Enable or disable adjusting the help request threshold at runtime
+		 *
+		 * @param bool enable Whether to adapt (true) or fix (false) the help request threshold
+		 */
+		void setHelpRequestThresholdAdaptive( bool enable );
+
+		/**
+		 * Adjust the help request threshold based on the outcome of a help request. Rejections raise the threshold and
+		 * make the process back off from requesting help, acceptances lower it. The threshold is bounded from below by
+		 * the number of candidates whose estimated work at the current level outweighs the help request latency.
+		 *
+		 * @param bool accepted Whether the help request was accepted
+		 * @param double latency Round-trip time of the help request in seconds
+		 */
+		void updateHelpRequestThreshold( bool accepted, double latency );
+
+		/**
+		 * Record the current help request threshold in the threshold trajectory
+		 */
+		void recordHelpRequestThreshold();
+
+		/**
+		 * Retrieve the trajectory of the help request threshold, including the final threshold
+		 *
+		 * @return vector<double> Trajectory as alternating time (in seconds since the start of the search) and threshold
+		 */
+		std::vector<double> getHelpRequestThresholdTrajectory();
+
 		/**
 		 * Get the number of help requests that were sent by this process
 		 *
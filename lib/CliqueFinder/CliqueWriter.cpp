@@ -0,0 +1,194 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <algorithm>
+
+// Program includes
+#include "CliqueWriter.h"
+#include "../Trace/Trace.h"
+
+CliqueWriter::CliqueWriter( std::string fname, int format ) : format(format) {
+	fh_output = fopen( fname.c_str(), "wb" );
+
+	if ( fh_output == NULL ) {
+		printf( "ERROR: The clique output file '%s' could not be opened.\n", fname.c_str() );
+		return;
+	}
+
+	// Leave room for the largest record, so that a buffer never grows beyond its reserved size
+	buffers[0].reserve( 2 * CLIQUE_WRITER_BUFFER_SIZE );
+	buffers[1].reserve( 2 * CLIQUE_WRITER_BUFFER_SIZE );
+
+	writer_thread = std::thread( &CliqueWriter::run, this );
+}
+
+CliqueWriter::~CliqueWriter() {
+	close();
+}
+
+bool CliqueWriter::isOpen() {
+	return fh_output != NULL;
+}
+
+void CliqueWriter::setGraph( const Graph *graph ) {
+	this->graph = graph;
+}
+
+void CliqueWriter::appendVarint( unsigned long long value ) {
+	std::vector<unsigned char> &buffer = buffers[ active_buffer ];
+
+	while ( value >= 0x80 ) {
+		buffer.push_back( (unsigned char) ( value | 0x80 ) );
+		value >>= 7;
+	}
+
+	buffer.push_back( (unsigned char) value );
+}
+
+void CliqueWriter::appendNode( long long node_id ) {
+	if ( format == CLIQUE_OUTPUT_BINARY ) {
+		appendVarint( ( (unsigned long long) node_id << 1 ) ^ (unsigned long long) ( node_id >> 63 ) );
+		return;
+	}
+
+	// Decimal notation, with the digits generated in reverse order
+	std::vector<unsigned char> &buffer = buffers[ active_buffer ];
+	unsigned long long value = ( node_id < 0 ) ? -(unsigned long long) node_id : node_id;
+	char digits[20];
+	int num_digits = 0;
+
+	do {
+		digits[ num_digits++ ] = '0' + value % 10;
+		value /= 10;
+	} while ( value > 0 );
+
+	if ( node_id < 0 ) {
+		buffer.push_back( '-' );
+	}
+
+	while ( num_digits > 0 ) {
+		buffer.push_back( digits[ --num_digits ] );
+	}
+}
+
+void CliqueWriter::appendClique( const std::vector<int> &base_nodes, const int *nodes, int num_nodes ) {
+	if ( fh_output == NULL ) {
+		return;
+	}
+
+	std::vector<unsigned char> &buffer = buffers[ active_buffer ];
+
+	// Members of the clique, translated back to the node IDs of the input file
+	long long members[ base_nodes.size() + num_nodes ];
+	int num_members = 0;
+
+	for ( int node_id : base_nodes ) {
+		members[ num_members++ ] = ( graph != NULL ) ? graph->getExternalNodeId( node_id ) : node_id;
+	}
+
+	for ( int i = 0; i < num_nodes; i++ ) {
+		members[ num_members++ ] = ( graph != NULL ) ? graph->getExternalNodeId( nodes[ i ] ) : nodes[ i ];
+	}
+
+	// Renumbered nodes (see NodeOrder) are no longer in the order of their external node IDs
+	if ( graph != NULL ) {
+		std::sort( members, members + num_members );
+	}
+
+	if ( format == CLIQUE_OUTPUT_BINARY ) {
+		// Clique size, followed by the first member and the differences between consecutive members
+		appendVarint( num_members );
+		long long previous_node_id = 0;
+
+		for ( int i = 0; i < num_members; i++ ) {
+			appendNode( members[ i ] - previous_node_id );
+			previous_node_id = members[ i ];
+		}
+	}
+	else {
+		for ( int i = 0; i < num_members; i++ ) {
+			appendNode( members[ i ] );
+			buffer.push_back( i + 1 < num_members ? '\t' : '\n' );
+		}
+	}
+
+	num_cliques++;
+
+	if ( buffer.size() >= CLIQUE_WRITER_BUFFER_SIZE ) {
+		swapBuffers();
+	}
+}
+
+void CliqueWriter::writeClique( const std::vector<int> &base_nodes, int node_a ) {
+	appendClique( base_nodes, &node_a, 1 );
+}
+
+void CliqueWriter::writeClique( const std::vector<int> &base_nodes, int node_a, int node_b ) {
+	int nodes[2] = { node_a, node_b };
+	appendClique( base_nodes, nodes, 2 );
+}
+
+void CliqueWriter::swapBuffers() {
+	std::unique_lock<std::mutex> lock( mutex );
+
+	// Wait for the background thread to finish writing the other buffer
+	condition.wait( lock, [this]() { return pending_buffer == NULL; } );
+
+	pending_buffer = &buffers[ active_buffer ];
+	active_buffer = 1 - active_buffer;
+	buffers[ active_buffer ].clear();
+
+	condition.notify_all();
+}
+
+void CliqueWriter::run() {
+	Trace::setThreadName( "clique writer" );
+
+	while ( true ) {
+		std::unique_lock<std::mutex> lock( mutex );
+		condition.wait( lock, [this]() { return pending_buffer != NULL || closing; } );
+
+		if ( pending_buffer == NULL ) {
+			return;
+		}
+
+		// Write the pending buffer without holding the lock, so that the search can keep filling the active buffer
+		std::vector<unsigned char> *buffer = pending_buffer;
+		lock.unlock();
+
+		{
+			TraceScope trace_scope( "clique write", buffer->size() );
+			fwrite( buffer->data(), 1, buffer->size(), fh_output );
+		}
+
+		lock.lock();
+		pending_buffer = NULL;
+		condition.notify_all();
+	}
+}
+
+void CliqueWriter::close() {
+	if ( fh_output == NULL ) {
+		return;
+	}
+
+	if ( ! buffers[ active_buffer ].empty() ) {
+		swapBuffers();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		closing = true;
+		condition.notify_all();
+	}
+
+	writer_thread.join();
+	fclose( fh_output );
+	fh_output = NULL;
+}
+
+long long CliqueWriter::getNumCliques() {
+	return num_cliques;
+}
@@ -0,0 +1,165 @@
+#ifndef CLIQUEWRITER_H
+#define CLIQUEWRITER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdio.h>
+
+// Program includes
+#include "../Graph/Graph.h"
+
+// Output formats of clique listings
+// ==========
+// Binary: per clique the clique size, followed by the first member and the difference of each next member with the
+// previous member. All values are unsigned LEB128 varints, and members and differences are zigzag-encoded first, so
+// that negative values take few bytes as well
+const int CLIQUE_OUTPUT_BINARY = 0;
+
+// Text: per clique a line with the members, separated by tab characters
+const int CLIQUE_OUTPUT_TEXT = 1;
+
+// Size (in bytes) of each of the two buffers of a clique writer
+const size_t CLIQUE_WRITER_BUFFER_SIZE = 1 << 20;
+
+/**
+ * Writer of the cliques found by a single clique finder to its own file. Cliques are encoded into one of two buffers,
+ * while the other buffer is written to file by a background thread, so that the search only waits for the file system
+ * if it finds cliques faster than they can be written
+ */
+class CliqueWriter {
+	protected:
+		/**
+		 * Output file handle, or NULL if the file could not be opened
+		 */
+		FILE *fh_output = NULL;
+
+		/**
+		 * Output format, CLIQUE_OUTPUT_BINARY or CLIQUE_OUTPUT_TEXT
+		 */
+		int format;
+
+		/**
+		 * Buffer being filled by the search, and the other buffer, which is being written or free
+		 */
+		std::vector<unsigned char> buffers[2];
+		int active_buffer = 0;
+
+		/**
+		 * Buffer handed to the background thread to be written, or NULL if the background thread is idle
+		 */
+		std::vector<unsigned char> *pending_buffer = NULL;
+
+		/**
+		 * Whether the background thread should stop once the pending buffer is written
+		 */
+		bool closing = false;
+
+		/**
+		 * Background thread writing buffers to file, and the synchronisation with the search
+		 */
+		std::thread writer_thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+
+		/**
+		 * Graph whose external node IDs are written instead of the node IDs, or NULL to write the node IDs
+		 */
+		const Graph *graph = NULL;
+
+		/**
+		 * Number of cliques written
+		 */
+		long long num_cliques = 0;
+
+		/**
+		 * Append a value to the active buffer as an unsigned LEB128 varint
+		 *
+		 * @param unsigned long long value Value
+		 */
+		void appendVarint( unsigned long long value );
+
+		/**
+		 * Append a node ID to the active buffer as a zigzag-encoded varint (binary) or in decimal notation (text)
+		 *
+		 * @param long long node_id Node ID, or difference with the previous node ID in the binary format
+		 */
+		void appendNode( long long node_id );
+
+		/**
+		 * Append the members of a clique to the active buffer, and hand the buffer over once it is full
+		 *
+		 * @param const std::vector<int>& base_nodes Base nodes of the clique
+		 * @param const int* nodes Further nodes of the clique
+		 * @param int num_nodes Number of further nodes
+		 */
+		void appendClique( const std::vector<int> &base_nodes, const int *nodes, int num_nodes );
+
+		/**
+		 * Hand the active buffer over to the background thread, waiting for the previous buffer to be written first
+		 */
+		void swapBuffers();
+
+		/**
+		 * Main loop of the background thread
+		 */
+		void run();
+
+	public:
+		/**
+		 * Constructor. Opens the output file and starts the background thread
+		 *
+		 * @param std::string fname Output file name
+		 * @param int format Output format, CLIQUE_OUTPUT_BINARY or CLIQUE_OUTPUT_TEXT
+		 */
+		CliqueWriter( std::string fname, int format );
+
+		/**
+		 * Destructor. Writes any remaining cliques and closes the file
+		 */
+		~CliqueWriter();
+
+		/**
+		 * Check whether the output file was opened successfully
+		 *
+		 * @return bool Whether the output file is open
+		 */
+		bool isOpen();
+
+		/**
+		 * Write the external node IDs of a graph, as used in its input file, instead of its node IDs. The members of every
+		 * clique are written in ascending order of external node ID
+		 *
+		 * @param const Graph* graph Graph the cliques are found in
+		 */
+		void setGraph( const Graph *graph );
+
+		/**
+		 * Write a clique consisting of the base nodes and one or two more nodes
+		 *
+		 * @param const std::vector<int>& base_nodes Base nodes of the clique
+		 * @param int node_a Next node of the clique
+		 * @param int node_b Optional. Last node of the clique
+		 */
+		void writeClique( const std::vector<int> &base_nodes, int node_a );
+		void writeClique( const std::vector<int> &base_nodes, int node_a, int node_b );
+
+		/**
+		 * Write any remaining cliques, stop the background thread and close the file
+		 */
+		void close();
+
+		/**
+		 * Get the number of cliques written
+		 *
+		 * @return long long Number of cliques
+		 */
+		long long getNumCliques();
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef HELPCHANNEL_H
+#define HELPCHANNEL_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+/**
+ * Channel through which a clique finder requests help from other workers and hands over the remaining part of a branch
+ * of its search. Implemented by Worker on top of a transport, so that the clique finder itself does not depend on MPI
+ */
+class HelpChannel {
+	public:
+		virtual ~HelpChannel() {}
+
+		/**
+		 * Request help from another worker. Returns true if another worker is available, in which case that worker is
+		 * reserved, and the request should be followed by granting the help through grantHelp()
+		 *
+		 * @return bool Whether another worker is available
+		 */
+		virtual bool requestHelp() = 0;
+
+		/**
+		 * Hand over the remaining part of a branch of the search to the worker reserved by requestHelp()
+		 *
+		 * @param int depth Depth of the branch, i.e. the size of the cliques found at the current level
+		 * @param std::vector<int> base_nodes Base nodes of the branch
+		 * @param std::vector<int> potential_nodes Candidate nodes of the branch
+		 * @param int helper_start Index of the first candidate node the helping worker should process
+		 * @param int helper_end Index after the last candidate node the helping worker should process
+		 */
+		virtual void grantHelp( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int helper_start, int helper_end ) = 0;
+};
+
+#endif
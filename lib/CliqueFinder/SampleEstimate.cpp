@@ -0,0 +1,118 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+// Program includes
+#include "SampleEstimate.h"
+
+int SampleEstimate::getFieldsOffset( int size ) {
+	return ( size < 0 ) ? SAMPLE_TOTAL : SAMPLE_SIZES + size * SAMPLE_SIZE_FIELDS;
+}
+
+void SampleEstimate::addExact( const std::vector<long long> &cliques_counts ) {
+	if ( (int) record.size() < getFieldsOffset( cliques_counts.size() ) ) {
+		record.resize( getFieldsOffset( cliques_counts.size() ), 0 );
+	}
+
+	for ( unsigned int size = 0; size < cliques_counts.size(); size++ ) {
+		record[ getFieldsOffset( size ) + SAMPLE_FIELD_EXACT ] += cliques_counts[ size ];
+		record[ getFieldsOffset( -1 ) + SAMPLE_FIELD_EXACT ] += cliques_counts[ size ];
+	}
+}
+
+void SampleEstimate::addSample( const std::vector<long long> &cliques_counts, double weight ) {
+	std::vector<double> values( cliques_counts.size() );
+
+	for ( unsigned int size = 0; size < cliques_counts.size(); size++ ) {
+		values[ size ] = cliques_counts[ size ] * weight;
+	}
+
+	addSample( values );
+}
+
+void SampleEstimate::addSample( const std::vector<double> &values ) {
+	if ( (int) record.size() < getFieldsOffset( values.size() ) ) {
+		record.resize( getFieldsOffset( values.size() ), 0 );
+	}
+
+	double total = 0;
+
+	for ( unsigned int size = 0; size < values.size(); size++ ) {
+		record[ getFieldsOffset( size ) + SAMPLE_FIELD_SUM ] += values[ size ];
+		record[ getFieldsOffset( size ) + SAMPLE_FIELD_SUM_SQUARES ] += values[ size ] * values[ size ];
+		total += values[ size ];
+	}
+
+	record[ SAMPLE_NUM_SAMPLES ]++;
+	record[ getFieldsOffset( -1 ) + SAMPLE_FIELD_SUM ] += total;
+	record[ getFieldsOffset( -1 ) + SAMPLE_FIELD_SUM_SQUARES ] += total * total;
+}
+
+long long SampleEstimate::getNumSamples() {
+	return (long long) record[ SAMPLE_NUM_SAMPLES ];
+}
+
+int SampleEstimate::getNumSizes() {
+	int num_sizes = ( record.size() - SAMPLE_SIZES ) / SAMPLE_SIZE_FIELDS;
+
+	while ( num_sizes > 0 && record[ getFieldsOffset( num_sizes - 1 ) + SAMPLE_FIELD_EXACT ] == 0 && record[ getFieldsOffset( num_sizes - 1 ) + SAMPLE_FIELD_SUM ] == 0 ) {
+		num_sizes--;
+	}
+
+	return num_sizes;
+}
+
+double SampleEstimate::getEstimate( int size ) {
+	if ( size >= getNumSizes() ) {
+		return 0;
+	}
+
+	double num_samples = record[ SAMPLE_NUM_SAMPLES ];
+	int offset = getFieldsOffset( size );
+
+	return record[ offset + SAMPLE_FIELD_EXACT ] + ( num_samples > 0 ? record[ offset + SAMPLE_FIELD_SUM ] / num_samples : 0 );
+}
+
+double SampleEstimate::getHalfWidth( int size, double confidence ) {
+	double num_samples = record[ SAMPLE_NUM_SAMPLES ];
+
+	if ( num_samples < 2 || size >= getNumSizes() ) {
+		return 0;
+	}
+
+	int offset = getFieldsOffset( size );
+	double sum = record[ offset + SAMPLE_FIELD_SUM ];
+	double variance = std::max( 0.0, ( record[ offset + SAMPLE_FIELD_SUM_SQUARES ] - sum * sum / num_samples ) / ( num_samples - 1 ) );
+
+	return getNormalQuantile( confidence ) * sqrt( variance / num_samples );
+}
+
+std::vector<double> SampleEstimate::getRecord( int num_sizes ) {
+	std::vector<double> padded_record = record;
+	padded_record.resize( getFieldsOffset( num_sizes ), 0 );
+
+	return padded_record;
+}
+
+double SampleEstimate::getNormalQuantile( double confidence ) {
+	// Bisection on the two-sided tail probability erfc( z / sqrt( 2 ) ), which decreases in z
+	double tail = 1 - confidence;
+	double low = 0;
+	double high = 40;
+
+	for ( int i = 0; i < 100; i++ ) {
+		double mid = ( low + high ) / 2;
+
+		if ( erfc( mid / sqrt( 2.0 ) ) > tail ) {
+			low = mid;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	return ( low + high ) / 2;
+}
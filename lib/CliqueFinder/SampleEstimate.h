@@ -0,0 +1,135 @@
+#ifndef SAMPLEESTIMATE_H
+#define SAMPLEESTIMATE_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+// Layout of sampling records, as exchanged between processes
+// ==========
+// Fields: number of samples, the fields of the total number of cliques, followed by the fields per clique size. The
+// fields of a number of cliques are the number of cliques under root tasks counted exactly, and the sum and sum of
+// squares of the samples of the number of cliques under the other root tasks
+const int SAMPLE_NUM_SAMPLES = 0;
+const int SAMPLE_TOTAL = 1;
+const int SAMPLE_SIZES = 4;
+const int SAMPLE_SIZE_FIELDS = 3;
+
+const int SAMPLE_FIELD_EXACT = 0;
+const int SAMPLE_FIELD_SUM = 1;
+const int SAMPLE_FIELD_SUM_SQUARES = 2;
+
+// Sampling settings
+// ==========
+// Number of samples drawn between checks of the stopping rule
+const int SAMPLE_BATCH_SIZE = 64;
+
+// Minimum number of samples per worker before the stopping rule applies, so that the variance estimate is reliable.
+// Root tasks that are expected to be sampled at least once within the minimum number of samples of all workers are
+// counted exactly instead
+const int SAMPLE_MIN_SAMPLES = 256;
+
+/**
+ * Monte Carlo estimate of the number of cliques per clique size. Root tasks are split into a stratum that is counted
+ * exactly, and a stratum from which root tasks are sampled at random with replacement. Every sample is the number of
+ * cliques found under a single root task divided by its sampling probability, which is an unbiased estimate of the
+ * number of cliques in the sampled stratum. The estimate is the exact count plus the mean of the samples, with a
+ * confidence interval from the central limit theorem
+ */
+class SampleEstimate {
+	private:
+		/**
+		 * Sampling record (see SAMPLE_* for the layout)
+		 */
+		std::vector<double> record;
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param const std::vector<double>& record Optional. Sampling record to start from
+		 */
+		SampleEstimate( const std::vector<double> &record = std::vector<double>( SAMPLE_SIZES, 0 ) ) : record(record) {}
+
+		/**
+		 * Add the number of cliques under root tasks counted exactly
+		 *
+		 * @param const std::vector<long long>& cliques_counts Number of cliques per clique size
+		 */
+		void addExact( const std::vector<long long> &cliques_counts );
+
+		/**
+		 * Add a sample
+		 *
+		 * @param const std::vector<long long>& cliques_counts Number of cliques per clique size under the sampled root task
+		 * @param double weight Inverse of the sampling probability of the root task
+		 */
+		void addSample( const std::vector<long long> &cliques_counts, double weight );
+
+		/**
+		 * Add a sample of which the number of cliques per clique size has already been weighted by the inverse of its
+		 * sampling probability
+		 *
+		 * @param const std::vector<double>& values Weighted number of cliques per clique size
+		 */
+		void addSample( const std::vector<double> &values );
+
+		/**
+		 * Get the number of samples
+		 *
+		 * @return long long Number of samples
+		 */
+		long long getNumSamples();
+
+		/**
+		 * Get the largest clique size with any cliques in the samples, plus one
+		 *
+		 * @return int Number of clique sizes
+		 */
+		int getNumSizes();
+
+		/**
+		 * Get the estimated number of cliques of a clique size, or of all sizes
+		 *
+		 * @param int size Clique size, or -1 for all sizes
+		 * @return double Estimated number of cliques
+		 */
+		double getEstimate( int size );
+
+		/**
+		 * Get the half-width of the confidence interval of the estimated number of cliques of a clique size, or of all
+		 * sizes. Only the sampled stratum contributes to it
+		 *
+		 * @param int size Clique size, or -1 for all sizes
+		 * @param double confidence Confidence level, e.g. 0.95
+		 * @return double Half-width of the confidence interval, or 0 if there are fewer than two samples
+		 */
+		double getHalfWidth( int size, double confidence );
+
+		/**
+		 * Get the offset of the fields of the number of cliques of a clique size, or of all sizes
+		 *
+		 * @param int size Clique size, or -1 for all sizes
+		 * @return int Offset in the sampling record
+		 */
+		static int getFieldsOffset( int size );
+
+		/**
+		 * Get the sampling record for exchanging it between processes (see SAMPLE_* for the layout)
+		 *
+		 * @param int num_sizes Number of clique sizes to include, at least getNumSizes()
+		 * @return std::vector<double> Sampling record
+		 */
+		std::vector<double> getRecord( int num_sizes );
+
+		/**
+		 * Get the two-sided quantile of the standard normal distribution for a confidence level, e.g. 1.96 for 0.95
+		 *
+		 * @param double confidence Confidence level, between 0 and 1
+		 * @return double Quantile
+		 */
+		static double getNormalQuantile( double confidence );
+};
+
+#endif
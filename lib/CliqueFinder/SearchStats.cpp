@@ -0,0 +1,30 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <algorithm>
+
+// Program includes
+#include "SearchStats.h"
+
+int SearchStats::getNumDepths() {
+	return std::max( num_nodes.size(), candidates_histogram.size() );
+}
+
+std::vector<long long> SearchStats::getRecord( int num_depths ) {
+	std::vector<long long> record( STATS_DEPTHS + num_depths * STATS_DEPTH_SIZE, 0 );
+
+	record[ STATS_EDGE_CHECKS ] = num_edge_checks;
+	record[ STATS_HELP_BYTES_SENT ] = help_bytes_sent;
+	record[ STATS_HELP_REQUEST_TIME ] = (long long) ( help_request_time * 1000000 );
+
+	for ( unsigned int depth = 0; depth < num_nodes.size(); depth++ ) {
+		record[ STATS_DEPTHS + depth * STATS_DEPTH_SIZE ] = num_nodes[ depth ];
+	}
+
+	for ( unsigned int depth = 0; depth < candidates_histogram.size(); depth++ ) {
+		std::copy( candidates_histogram[ depth ].begin(), candidates_histogram[ depth ].end(), record.begin() + STATS_DEPTHS + depth * STATS_DEPTH_SIZE + 1 );
+	}
+
+	return record;
+}
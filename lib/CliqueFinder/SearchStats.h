@@ -0,0 +1,115 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+// Compile-time switch
+// ==========
+// Search statistics are only collected when compiled with -DCLIQUES_STATS (make STATS=1). Otherwise, statements wrapped
+// in SEARCH_STATS() are removed by the preprocessor, so that the hot path of the search is unaffected
+#ifdef CLIQUES_STATS
+#define SEARCH_STATS( statement ) statement
+#else
+#define SEARCH_STATS( statement )
+#endif
+
+// Layout of search statistics records, as exchanged between processes
+// ==========
+// Number of candidate set size buckets per depth. Bucket b holds candidate sets of size 2^b to 2^(b+1) - 1, with the
+// last bucket also holding all larger sets
+const int STATS_NUM_BUCKETS = 16;
+
+// Fields: number of edge checks (isEdge calls and set intersection steps), bytes sent in help transfers, time blocked
+// in help requests (microseconds), followed by per depth the number of DFS nodes visited and the candidate set size
+// histogram
+const int STATS_EDGE_CHECKS = 0;
+const int STATS_HELP_BYTES_SENT = 1;
+const int STATS_HELP_REQUEST_TIME = 2;
+const int STATS_DEPTHS = 3;
+const int STATS_DEPTH_SIZE = 1 + STATS_NUM_BUCKETS;
+
+class SearchStats {
+	private:
+		/**
+		 * Number of DFS nodes visited per depth, i.e. the number of candidate nodes the clique of that size was extended
+		 * with
+		 * Format: [depth] => [num_nodes]
+		 */
+		std::vector<long long> num_nodes;
+
+		/**
+		 * Histogram of candidate set sizes per depth
+		 * Format: [depth] => [bucket] => [num_candidate_sets]
+		 */
+		std::vector<std::vector<long long> > candidates_histogram;
+
+	public:
+		/**
+		 * Number of pairs of nodes checked for adjacency
+		 */
+		long long num_edge_checks = 0;
+
+		/**
+		 * Number of bytes of search state sent to helper processes
+		 */
+		long long help_bytes_sent = 0;
+
+		/**
+		 * Time (in seconds) spent waiting for responses to help requests
+		 */
+		double help_request_time = 0;
+
+		/**
+		 * Record a visit to a DFS node at the given depth
+		 *
+		 * @param int depth Depth of the DFS node
+		 */
+		void addNode( int depth ) {
+			if ( depth >= (int) num_nodes.size() ) {
+				num_nodes.resize( depth + 1, 0 );
+			}
+
+			num_nodes[ depth ]++;
+		}
+
+		/**
+		 * Record the size of a candidate set at the given depth
+		 *
+		 * @param int depth Depth of the DFS node
+		 * @param int num_candidates Size of the candidate set
+		 */
+		void addCandidates( int depth, int num_candidates ) {
+			if ( depth >= (int) candidates_histogram.size() ) {
+				candidates_histogram.resize( depth + 1, std::vector<long long>( STATS_NUM_BUCKETS, 0 ) );
+			}
+
+			int bucket = 0;
+
+			while ( num_candidates > 1 && bucket < STATS_NUM_BUCKETS - 1 ) {
+				num_candidates >>= 1;
+				bucket++;
+			}
+
+			candidates_histogram[ depth ][ bucket ]++;
+		}
+
+		/**
+		 * Get the maximum depth for which statistics were recorded, plus one
+		 *
+		 * @return int Number of depths
+		 */
+		int getNumDepths();
+
+		/**
+		 * Get the statistics as a record for exchanging them between processes (see STATS_* for the layout)
+		 *
+		 * @param int num_depths Number of depths to include, at least getNumDepths()
+		 * @return std::vector<long long> Statistics record
+		 */
+		std::vector<long long> getRecord( int num_depths );
+};
+
+#endif
@@ -4,10 +4,11 @@
 #include <vector>
 #include <string>
 #include <iostream>
-#include <sstream>
 #include <fstream>
 #include <unordered_set>
 #include <math.h>
+#include <climits>
+#include <cstdlib>
 #include <algorithm>
 
 // Program includes
@@ -23,28 +24,86 @@ bool Graph::readEdgeList( std::string fname ) {
 		return false;
 	}
 
-	// Delimiters for rows and fields
-	char const row_delimiter = '\n';
-	char const field_delimiter = '\t';
+	// External source and target node ID of every edge
+	std::vector<long long> edges_external;
 
-	// Loop over lines
-	for ( std::string row; std::getline( fl_input, row, row_delimiter ); ) {
-		std::istringstream row_fields( row );
-		std::vector<std::string> fields;
+	// Loop over lines, parsing the first two fields in place
+	for ( std::string row; std::getline( fl_input, row ); ) {
+		const char *field = row.c_str();
+		char *field_end;
 
-		for ( std::string row_field; getline( row_fields, row_field, field_delimiter ); ) {
-			fields.push_back( row_field );
+		long long node_source = std::strtoll( field, &field_end, 10 );
+
+		if ( field_end == field ) {
+			continue;
+		}
+
+		field = field_end;
+		long long node_target = std::strtoll( field, &field_end, 10 );
+
+		if ( field_end == field ) {
+			continue;
 		}
 
-		int node_source = std::atoi( fields[0].c_str() );
-		int node_target = std::atoi( fields[1].c_str() );
+		edges_external.push_back( node_source );
+		edges_external.push_back( node_target );
+	}
+
+	// Collect the external node IDs without a node ID in a hash map, and number them in ascending order after the
+	// existing nodes, so that the node IDs do not depend on the order of the edges
+	std::vector<long long> new_external_ids;
+	node_ids.reserve( node_ids.size() + edges_external.size() / 2 );
+
+	for ( long long external_id : edges_external ) {
+		if ( node_ids.emplace( external_id, -1 ).second ) {
+			new_external_ids.push_back( external_id );
+		}
+	}
+
+	if ( external_node_ids.size() + new_external_ids.size() > (size_t) INT_MAX ) {
+		printf( "ERROR: The input file '%s' has more than %d nodes.\n", fname.c_str(), INT_MAX );
+		return false;
+	}
+
+	std::sort( new_external_ids.begin(), new_external_ids.end() );
+
+	for ( long long external_id : new_external_ids ) {
+		node_ids[ external_id ] = external_node_ids.size();
+		external_node_ids.push_back( external_id );
+	}
 
-		addEdge( node_source, node_target );
+	for ( size_t i = 0; i < edges_external.size(); i += 2 ) {
+		addEdge( node_ids[ edges_external[ i ] ], node_ids[ edges_external[ i + 1 ] ] );
 	}
 
 	return true;
 }
 
+int Graph::getNodeId( long long external_id, bool add ) {
+	auto node_id = node_ids.find( external_id );
+
+	if ( node_id != node_ids.end() ) {
+		return node_id->second;
+	}
+
+	if ( ! add ) {
+		return -1;
+	}
+
+	node_ids[ external_id ] = external_node_ids.size();
+	external_node_ids.push_back( external_id );
+
+	return external_node_ids.size() - 1;
+}
+
+long long Graph::getExternalNodeId( int nid ) const {
+	return ( nid >= 0 && nid < (int) external_node_ids.size() ) ? external_node_ids[ nid ] : nid;
+}
+
+const std::vector<long long> &Graph::getExternalNodeIds() const {
+	return external_node_ids;
+}
+
 void Graph::addNode( int nid ) {
 	node nd;
 	nd.id = nid;
@@ -57,6 +116,10 @@ void Graph::addNode( int nid ) {
 }
 
 bool Graph::isNode( int nid ) {
+	if ( csr_offsets != NULL ) {
+		return nid >= 0 && nid < num_nodes;
+	}
+
 	return ( nodelist.find( nid ) != nodelist.end() );
 }
 
@@ -89,7 +152,29 @@ bool Graph::addEdge( int node_source, int node_target ) {
 	return true;
 }
 
+bool Graph::removeEdge( int node_source, int node_target ) {
+	if ( csr_offsets != NULL || ! isEdge( node_source, node_target ) ) {
+		return false;
+	}
+
+	std::vector<int> &source_neighbours = adjacencylist[ node_source ];
+	std::vector<int> &target_neighbours = adjacencylist[ node_target ];
+	source_neighbours.erase( std::find( source_neighbours.begin(), source_neighbours.end(), node_target ) );
+	target_neighbours.erase( std::find( target_neighbours.begin(), target_neighbours.end(), node_source ) );
+
+	edgelist.erase( std::make_pair( node_source, node_target ) );
+	edgelist.erase( std::make_pair( node_target, node_source ) );
+
+	num_edges--;
+
+	return true;
+}
+
 bool Graph::isEdge( int node_source, int node_target ) {
+	if ( csr_offsets != NULL ) {
+		return isNode( node_source ) && std::binary_search( csr_neighbours + csr_offsets[ node_source ], csr_neighbours + csr_offsets[ node_source + 1 ], node_target );
+	}
+
 	if ( edgelist.count( std::make_pair( node_source, node_target ) ) == 1 ) {
 		return true;
 	}
@@ -98,17 +183,297 @@ bool Graph::isEdge( int node_source, int node_target ) {
 }
 
 EdgeList Graph::getEdgeList() {
+	if ( csr_offsets != NULL ) {
+		EdgeList csr_edgelist;
+
+		for ( int i = 0; i < num_nodes; i++ ) {
+			for ( long long j = csr_offsets[ i ]; j < csr_offsets[ i + 1 ]; j++ ) {
+				csr_edgelist.insert( std::make_pair( i, csr_neighbours[ j ] ) );
+			}
+		}
+
+		return csr_edgelist;
+	}
+
 	return edgelist;
 }
 
+std::vector<int> Graph::getCommonNeighbours( int node_a, int node_b ) {
+	std::vector<int> common_neighbours;
+
+	if ( ! isNode( node_a ) || ! isNode( node_b ) ) {
+		return common_neighbours;
+	}
+
+	// Check the neighbours of the node with the smallest degree for being neighbours of the other node
+	if ( getNodeDegree( node_a ) > getNodeDegree( node_b ) ) {
+		std::swap( node_a, node_b );
+	}
+
+	if ( csr_offsets != NULL ) {
+		for ( long long i = csr_offsets[ node_a ]; i < csr_offsets[ node_a + 1 ]; i++ ) {
+			if ( isEdge( node_b, csr_neighbours[ i ] ) ) {
+				common_neighbours.push_back( csr_neighbours[ i ] );
+			}
+		}
+
+		return common_neighbours;
+	}
+
+	for ( int neighbour_id : adjacencylist[ node_a ] ) {
+		if ( isEdge( node_b, neighbour_id ) ) {
+			common_neighbours.push_back( neighbour_id );
+		}
+	}
+
+	std::sort( common_neighbours.begin(), common_neighbours.end() );
+
+	return common_neighbours;
+}
+
+void Graph::useCSR( int num_nodes, const long long *offsets, const int *neighbours ) {
+	this->num_nodes = num_nodes;
+	num_edges = offsets[ num_nodes ] / 2;
+	csr_offsets = offsets;
+	csr_neighbours = neighbours;
+	powerlaw_exponent = 0;
+}
+
+AdjacencyList Graph::getForwardAdjacencyList( int partition, int num_partitions ) {
+	AdjacencyList forwardlist;
+
+	if ( csr_offsets != NULL ) {
+		for ( int i = partition; i < num_nodes; i += num_partitions ) {
+			// Neighbour lists are sorted, so the higher-ID neighbours form their tail
+			const int *neighbours_end = csr_neighbours + csr_offsets[ i + 1 ];
+			const int *forward_begin = std::upper_bound( csr_neighbours + csr_offsets[ i ], neighbours_end, i );
+
+			if ( forward_begin != neighbours_end ) {
+				forwardlist[ i ].assign( forward_begin, neighbours_end );
+			}
+		}
+
+		return forwardlist;
+	}
+
+	for ( const auto &node : adjacencylist ) {
+		if ( ( ( node.first % num_partitions ) + num_partitions ) % num_partitions != partition ) {
+			continue;
+		}
+
+		std::vector<int> forward_neighbours;
+
+		for ( int neighbour_id : node.second ) {
+			if ( neighbour_id > node.first ) {
+				forward_neighbours.push_back( neighbour_id );
+			}
+		}
+
+		if ( ! forward_neighbours.empty() ) {
+			std::sort( forward_neighbours.begin(), forward_neighbours.end() );
+			forwardlist[ node.first ] = forward_neighbours;
+		}
+	}
+
+	return forwardlist;
+}
+
+bool Graph::renumberNodes( const std::vector<int> &order ) {
+	if ( csr_offsets != NULL || (int) order.size() != num_nodes ) {
+		return false;
+	}
+
+	// New node ID of every node, and the edges between the new node IDs
+	std::map<int, int> new_ids;
+
+	for ( unsigned int i = 0; i < order.size(); i++ ) {
+		new_ids[ order[ i ] ] = i;
+	}
+
+	if ( (int) new_ids.size() != num_nodes ) {
+		return false;
+	}
+
+	std::vector<Edge> edges;
+	edges.reserve( num_edges );
+
+	for ( const auto &node : adjacencylist ) {
+		for ( int neighbour_id : node.second ) {
+			if ( node.first < neighbour_id ) {
+				edges.push_back( std::make_pair( new_ids[ node.first ], new_ids[ neighbour_id ] ) );
+			}
+		}
+	}
+
+	// Translate the external node IDs along, before the node IDs themselves are replaced
+	std::vector<long long> new_external_node_ids( num_nodes );
+	node_ids.clear();
+
+	for ( int i = 0; i < num_nodes; i++ ) {
+		new_external_node_ids[ i ] = getExternalNodeId( order[ i ] );
+		node_ids[ new_external_node_ids[ i ] ] = i;
+	}
+
+	external_node_ids = new_external_node_ids;
+
+	// Collapsed twins are renumbered along
+	if ( ! node_weights.empty() ) {
+		std::vector<int> new_node_weights( num_nodes );
+		std::vector<bool> new_node_twins_adjacent( num_nodes );
+
+		for ( int i = 0; i < num_nodes; i++ ) {
+			new_node_weights[ i ] = node_weights[ order[ i ] ];
+			new_node_twins_adjacent[ i ] = node_twins_adjacent[ order[ i ] ];
+		}
+
+		node_weights = new_node_weights;
+		node_twins_adjacent = new_node_twins_adjacent;
+	}
+
+	rebuild( num_nodes, edges );
+
+	return true;
+}
+
+bool Graph::collapseTwins( const std::vector<std::vector<int> > &twins, const std::vector<bool> &twins_adjacent ) {
+	if ( csr_offsets != NULL || ! node_weights.empty() || twins.size() != twins_adjacent.size() ) {
+		return false;
+	}
+
+	// New node ID of every node, which is the index of its class
+	std::unordered_map<int, int> new_ids;
+	new_ids.reserve( num_nodes );
+
+	for ( unsigned int i = 0; i < twins.size(); i++ ) {
+		for ( int nid : twins[ i ] ) {
+			new_ids[ nid ] = i;
+		}
+	}
+
+	if ( (int) new_ids.size() != num_nodes ) {
+		return false;
+	}
+
+	// Edges between members of two classes collapse into a single edge, and edges within a class disappear
+	std::vector<Edge> edges;
+
+	for ( const auto &node : adjacencylist ) {
+		int new_id = new_ids[ node.first ];
+
+		for ( int neighbour_id : node.second ) {
+			int new_neighbour_id = new_ids[ neighbour_id ];
+
+			if ( new_id < new_neighbour_id ) {
+				edges.push_back( std::make_pair( new_id, new_neighbour_id ) );
+			}
+		}
+	}
+
+	std::sort( edges.begin(), edges.end() );
+	edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+	// Members keep their external node IDs, which map to the node ID of their class
+	std::vector<long long> new_external_node_ids( twins.size() );
+	std::unordered_map<long long, int> new_node_ids;
+	node_weights.resize( twins.size() );
+	node_twins_adjacent = twins_adjacent;
+
+	for ( unsigned int i = 0; i < twins.size(); i++ ) {
+		new_external_node_ids[ i ] = getExternalNodeId( twins[ i ][ 0 ] );
+		node_weights[ i ] = twins[ i ].size();
+
+		for ( int nid : twins[ i ] ) {
+			new_node_ids[ getExternalNodeId( nid ) ] = i;
+		}
+	}
+
+	external_node_ids = new_external_node_ids;
+	node_ids = new_node_ids;
+
+	rebuild( twins.size(), edges );
+
+	return true;
+}
+
+const std::vector<int> &Graph::getNodeWeights() const {
+	return node_weights;
+}
+
+bool Graph::areNodeTwinsAdjacent( int nid ) const {
+	return nid >= 0 && nid < (int) node_twins_adjacent.size() && node_twins_adjacent[ nid ];
+}
+
+void Graph::rebuild( int num_nodes_new, std::vector<Edge> &edges ) {
+	std::sort( edges.begin(), edges.end() );
+
+	adjacencylist.clear();
+	edgelist.clear();
+	nodelist.clear();
+	nodes_degrees.clear();
+	num_nodes = 0;
+	num_edges = 0;
+
+	for ( int i = 0; i < num_nodes_new; i++ ) {
+		addNode( i );
+		adjacencylist[ i ];
+	}
+
+	edgelist.reserve( 2 * edges.size() );
+
+	for ( const Edge &edge : edges ) {
+		addEdge( edge.first, edge.second );
+	}
+}
+
+std::vector<int> Graph::getNodeIds() {
+	std::vector<int> nids;
+
+	if ( csr_offsets != NULL ) {
+		for ( int i = 0; i < num_nodes; i++ ) {
+			nids.push_back( i );
+		}
+
+		return nids;
+	}
+
+	for ( const auto &node : nodelist ) {
+		nids.push_back( node.first );
+	}
+
+	return nids;
+}
+
 int Graph::getNodeDegree( int nid ) {
-	return adjacencylist[ nid ].size();
+	if ( csr_offsets != NULL ) {
+		return isNode( nid ) ? csr_offsets[ nid + 1 ] - csr_offsets[ nid ] : 0;
+	}
+
+	// Look the node up without inserting it into the adjacency list
+	auto neighbours = adjacencylist.find( nid );
+
+	return ( neighbours != adjacencylist.end() ) ? neighbours->second.size() : 0;
 }
 
 int Graph::getNumNodes() {
 	return num_nodes;
 }
 
+int Graph::getNodeIdMin() {
+	if ( csr_offsets != NULL || adjacencylist.empty() ) {
+		return 0;
+	}
+
+	return adjacencylist.begin()->first;
+}
+
+int Graph::getNodeIdMax() {
+	if ( csr_offsets != NULL ) {
+		return num_nodes - 1;
+	}
+
+	return adjacencylist.empty() ? -1 : adjacencylist.rbegin()->first;
+}
+
 int Graph::getNumEdges() {
 	return num_edges;
 }
@@ -122,23 +487,36 @@ float Graph::getPowerLawExponent() {
 	// Estimated power-law exponent
 	powerlaw_exponent = 0;
 
-	// Minimal degree found in the network
-	int mindegree = -1;
-
-	for ( int i = 0; i < nodelist.size(); i++ ) {
-		int degree = getNodeDegree( i );
+	// Degrees of the nodes with edges. Node IDs are only consecutive in compressed sparse row format, and nodes without
+	// edges are left out, as the power law describes the degrees of nodes with edges
+	std::vector<int> degrees;
 
-		if ( degree < mindegree || mindegree == -1 ) {
-			mindegree = degree;
+	if ( csr_offsets != NULL ) {
+		for ( int i = 0; i < num_nodes; i++ ) {
+			degrees.push_back( getNodeDegree( i ) );
 		}
 	}
+	else {
+		for ( const auto &node : adjacencylist ) {
+			degrees.push_back( node.second.size() );
+		}
+	}
+
+	degrees.erase( std::remove( degrees.begin(), degrees.end(), 0 ), degrees.end() );
+
+	if ( degrees.empty() ) {
+		return powerlaw_exponent;
+	}
+
+	// Minimal degree found in the network
+	int mindegree = *std::min_element( degrees.begin(), degrees.end() );
 
 	// Calculate power-law exponent
-	for ( int i = 0; i < nodelist.size(); i++ ) {
-		powerlaw_exponent += log( ( (float) getNodeDegree( i ) ) / mindegree );
+	for ( int degree : degrees ) {
+		powerlaw_exponent += log( ( (float) degree ) / mindegree );
 	}
 
-	powerlaw_exponent = 1 + nodelist.size() / powerlaw_exponent;
+	powerlaw_exponent = 1 + degrees.size() / powerlaw_exponent;
 
 	return powerlaw_exponent;
 }
@@ -8,6 +8,7 @@
 #include <string>
 #include <map>
 #include <unordered_set>
+#include <unordered_map>
 
 // Boost includes
 #include <boost/functional/hash.hpp>
@@ -67,15 +68,77 @@ class Graph {
 		 */
 		float powerlaw_exponent = 0;
 
+		/**
+		 * Graph in compressed sparse row format, owned by the caller, if the graph was set using useCSR(). The neighbours
+		 * of node i are csr_neighbours[ csr_offsets[ i ] ] up to csr_neighbours[ csr_offsets[ i + 1 ] ]
+		 */
+		const long long *csr_offsets = NULL;
+		const int *csr_neighbours = NULL;
+
+		/**
+		 * External node IDs, as used in input files, of the nodes read from file, and the node ID of every external node
+		 * ID. Node IDs are dense, from 0 up to the number of nodes read
+		 * Format: external_node_ids[ node_id ] = external_id, node_ids[ external_id ] = node_id
+		 */
+		std::vector<long long> external_node_ids;
+		std::unordered_map<long long, int> node_ids;
+
+		/**
+		 * Number of nodes of the input graph every node stands for, and whether these nodes are adjacent (true twins) or
+		 * not (false twins), if classes of twins were collapsed into single nodes using collapseTwins(). Empty otherwise
+		 * Format: node_weights[ node_id ] = num_twins, node_twins_adjacent[ node_id ] = adjacent
+		 */
+		std::vector<int> node_weights;
+		std::vector<bool> node_twins_adjacent;
+
+		/**
+		 * Replace the graph by nodes 0 up to a number of nodes and the given edges, which are added in sorted order, so
+		 * that the edges of nodes with nearby IDs are also allocated close together
+		 *
+		 * @param int num_nodes_new Number of nodes
+		 * @param std::vector<Edge>& edges Edges between the new nodes, each listed once. Sorted in place
+		 */
+		void rebuild( int num_nodes_new, std::vector<Edge> &edges );
+
 	public:
 		/**
 		 * Read a list of edges from a file.
-		 * Each line should contain a source node ID and a target node ID, separated by a tab character.
+		 * Each line should contain a source node ID and a target node ID, separated by a tab character or spaces. Lines
+		 * that do not start with two node IDs, such as empty lines and comment lines, are skipped. Node IDs are any 64-bit
+		 * integers, and are mapped to dense node IDs 0 up to the number of nodes in ascending order, so that a graph
+		 * with node IDs 0 up to the number of nodes keeps its node IDs
 		 *
 		 * @param std::string fname Input file name to read edges from
+		 * @return bool Whether the file could be read
 		 */
 		bool readEdgeList( std::string fname );
 
+		/**
+		 * Get the node ID of an external node ID, as used in the input file. Optionally, a new node ID is assigned to
+		 * an external node ID that is not in the graph yet, after all existing node IDs, without adding the node
+		 *
+		 * @param long long external_id External node ID
+		 * @param bool add Optional. Whether to assign a node ID to an unknown external node ID
+		 * @return int Node ID, or -1 if the external node ID is unknown and not added
+		 */
+		int getNodeId( long long external_id, bool add = false );
+
+		/**
+		 * Get the external node ID of a node, as used in the input file. Nodes that were not read from file, such as
+		 * nodes of graphs built using addEdge(), are their own external node ID
+		 *
+		 * @param int nid Node ID
+		 * @return long long External node ID
+		 */
+		long long getExternalNodeId( int nid ) const;
+
+		/**
+		 * Get the external node IDs of the nodes read from file, indexed by node ID
+		 *
+		 * @return const std::vector<long long>& External node IDs
+		 */
+		const std::vector<long long> &getExternalNodeIds() const;
+
 		/**
 		 * Add a node to the graph.
 		 *
@@ -106,6 +169,16 @@ class Graph {
 		 * @param int node_target Target node ID
 		 */
 		bool addEdge( int node_source, int node_target );
+
+		/**
+		 * Remove an edge between two nodes from the graph. Its end points remain in the graph. Not supported for graphs
+		 * in compressed sparse row format
+		 *
+		 * @param int node_source Source node ID
+		 * @param int node_target Target node ID
+		 * @return bool Whether the edge existed and was removed
+		 */
+		bool removeEdge( int node_source, int node_target );
 		
 		/**
 		 * Check whether an edge exists between two nodes.
@@ -118,6 +191,84 @@ class Graph {
 
 		EdgeList getEdgeList();
 
+		/**
+		 * Get the common neighbours of two nodes, i.e. the nodes that form a triangle with them if they are connected.
+		 * Takes time linear in the smallest degree of the two nodes
+		 *
+		 * @param int node_a First node ID
+		 * @param int node_b Second node ID
+		 * @return std::vector<int> Sorted common neighbours
+		 */
+		std::vector<int> getCommonNeighbours( int node_a, int node_b );
+
+		/**
+		 * Use a graph in compressed sparse row format with nodes 0 up to num_nodes, without copying it. The neighbour list of
+		 * every node should be sorted, and every edge should be present in both directions. The arrays should remain valid
+		 * while the graph is in use, and no edges should be added to the graph afterwards.
+		 *
+		 * @param int num_nodes Number of nodes
+		 * @param const long long* offsets Start of the neighbour list of each node, with num_nodes + 1 entries
+		 * @param const int* neighbours Concatenated neighbour lists
+		 */
+		void useCSR( int num_nodes, const long long *offsets, const int *neighbours );
+
+		/**
+		 * Get the sorted list of higher-ID neighbours (N+) of every node with at least one higher-ID neighbour. Optionally,
+		 * only nodes whose ID modulo num_partitions equals partition are included. Does not modify the graph, so it can
+		 * be called from several threads at once.
+		 *
+		 * @param int partition Optional. Partition of nodes to include
+		 * @param int num_partitions Optional. Number of partitions
+		 * @return AdjacencyList Higher-ID neighbours per node
+		 */
+		AdjacencyList getForwardAdjacencyList( int partition = 0, int num_partitions = 1 );
+
+		/**
+		 * Renumber the nodes of the graph to 0 up to the number of nodes, in the given order. External node IDs are
+		 * renumbered along, so that output is translated back to the node IDs of the input file. Not supported for graphs
+		 * in compressed sparse row format
+		 *
+		 * @param const std::vector<int>& order All node IDs, in the order of their new node IDs
+		 * @return bool Whether the nodes were renumbered
+		 */
+		bool renumberNodes( const std::vector<int> &order );
+
+		/**
+		 * Collapse classes of twins into single nodes, numbered 0 up to the number of classes in the given order. Twins
+		 * have the same neighbours outside their class, so that there is an edge between two collapsed nodes if there
+		 * was an edge between their members. Every collapsed node takes the external node ID of its first member, and
+		 * records its number of members and whether they are adjacent, see getNodeWeights(). Not supported for graphs
+		 * in compressed sparse row format or graphs whose twins were collapsed already
+		 *
+		 * @param const std::vector<std::vector<int> >& twins Node IDs of the members of every class, covering all nodes
+		 * @param const std::vector<bool>& twins_adjacent Whether the members of every class are adjacent (true twins) or
+		 * not (false twins)
+		 * @return bool Whether the twins were collapsed
+		 */
+		bool collapseTwins( const std::vector<std::vector<int> > &twins, const std::vector<bool> &twins_adjacent );
+
+		/**
+		 * Get the number of nodes of the input graph every node stands for, if twins were collapsed
+		 *
+		 * @return const std::vector<int>& Number of twins, indexed by node ID, or an empty list if no twins were collapsed
+		 */
+		const std::vector<int> &getNodeWeights() const;
+
+		/**
+		 * Check whether the twins a node stands for are adjacent (true twins) or not (false twins)
+		 *
+		 * @param int nid Node ID
+		 * @return bool Whether the twins are adjacent, or false if no twins were collapsed
+		 */
+		bool areNodeTwinsAdjacent( int nid ) const;
+
+		/**
+		 * Get the IDs of all nodes in the graph
+		 *
+		 * @return std::vector<int> Sorted node IDs
+		 */
+		std::vector<int> getNodeIds();
+
 		/**
 		 * Get the degree of a node.
 		 *
@@ -133,6 +284,14 @@ class Graph {
 		 */
 		int getNumNodes();
 
+		/**
+		 * Get the smallest and largest node ID in the graph, or 0 and -1 if the graph has no nodes
+		 *
+		 * @return int Node ID
+		 */
+		int getNodeIdMin();
+		int getNodeIdMax();
+
 		/**
 		 * Get the number of edges in the graph
 		 *
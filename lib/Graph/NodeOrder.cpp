@@ -0,0 +1,255 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <queue>
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+
+// Program includes
+#include "NodeOrder.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+
+int NodeOrder::parse( const std::string &name ) {
+	if ( name == "" || name == "none" ) {
+		return NODE_ORDER_NONE;
+	}
+	else if ( name == "degree" ) {
+		return NODE_ORDER_DEGREE;
+	}
+	else if ( name == "rcm" ) {
+		return NODE_ORDER_RCM;
+	}
+	else if ( name == "gorder" ) {
+		return NODE_ORDER_GORDER;
+	}
+
+	return -1;
+}
+
+std::vector<std::vector<int> > NodeOrder::getNeighbourPositions( Graph *graph, const std::vector<int> &nodes ) {
+	std::vector<std::vector<int> > neighbours( nodes.size() );
+
+	// Forward neighbour lists are sorted, and listed per node in ascending order, so that appending every edge to both
+	// of its end points keeps all neighbour lists sorted: the lower neighbours of a node are appended before its own
+	// higher neighbours
+	for ( const auto &node : graph->getForwardAdjacencyList() ) {
+		int position = std::lower_bound( nodes.begin(), nodes.end(), node.first ) - nodes.begin();
+
+		for ( int neighbour_id : node.second ) {
+			int neighbour_position = std::lower_bound( nodes.begin(), nodes.end(), neighbour_id ) - nodes.begin();
+			neighbours[ position ].push_back( neighbour_position );
+			neighbours[ neighbour_position ].push_back( position );
+		}
+	}
+
+	return neighbours;
+}
+
+std::vector<int> NodeOrder::getDegreeOrder( const std::vector<std::vector<int> > &neighbours ) {
+	std::vector<int> order( neighbours.size() );
+
+	for ( unsigned int i = 0; i < order.size(); i++ ) {
+		order[ i ] = i;
+	}
+
+	std::stable_sort( order.begin(), order.end(), [&neighbours]( int a, int b ) {
+		return neighbours[ a ].size() < neighbours[ b ].size();
+	} );
+
+	return order;
+}
+
+std::vector<int> NodeOrder::getRCMOrder( const std::vector<std::vector<int> > &neighbours ) {
+	std::vector<int> order;
+	std::vector<bool> visited( neighbours.size(), false );
+	order.reserve( neighbours.size() );
+
+	// Start every component at its first unvisited node of lowest degree
+	for ( int start : getDegreeOrder( neighbours ) ) {
+		if ( visited[ start ] ) {
+			continue;
+		}
+
+		visited[ start ] = true;
+		order.push_back( start );
+
+		// Breadth-first search, with the order itself as queue
+		for ( unsigned int head = order.size() - 1; head < order.size(); head++ ) {
+			std::vector<int> next;
+
+			for ( int neighbour : neighbours[ order[ head ] ] ) {
+				if ( ! visited[ neighbour ] ) {
+					visited[ neighbour ] = true;
+					next.push_back( neighbour );
+				}
+			}
+
+			std::stable_sort( next.begin(), next.end(), [&neighbours]( int a, int b ) {
+				return neighbours[ a ].size() < neighbours[ b ].size();
+			} );
+
+			order.insert( order.end(), next.begin(), next.end() );
+		}
+	}
+
+	std::reverse( order.begin(), order.end() );
+
+	return order;
+}
+
+std::vector<int> NodeOrder::getGorderOrder( const std::vector<std::vector<int> > &neighbours ) {
+	int num_nodes = neighbours.size();
+	unsigned int hub_degree = std::max( 1, (int) sqrt( num_nodes ) );
+
+	// Score of every unplaced node against the window of most recently placed nodes: the number of edges with them,
+	// plus the number of neighbours shared with them through nodes of degree up to hub_degree
+	std::vector<int> scores( num_nodes, 0 );
+	std::vector<bool> placed( num_nodes, false );
+
+	// Max-heap of scores and negated positions, so that ties go to the lowest position. Scores lowered after an entry was
+	// pushed leave stale entries, which are replaced when they reach the top, and the heap is rebuilt from the current
+	// scores once stale entries dominate, which bounds its size
+	std::priority_queue<std::pair<int, int> > heap;
+
+	for ( int i = 0; i < num_nodes; i++ ) {
+		heap.push( std::make_pair( 0, -i ) );
+	}
+
+	// Add a placed node to the window, or remove it from the window
+	auto updateScores = [&]( int node, int change ) {
+		for ( int neighbour : neighbours[ node ] ) {
+			if ( ! placed[ neighbour ] ) {
+				scores[ neighbour ] += change;
+
+				if ( change > 0 ) {
+					heap.push( std::make_pair( scores[ neighbour ], -neighbour ) );
+				}
+			}
+
+			if ( neighbours[ neighbour ].size() > hub_degree ) {
+				continue;
+			}
+
+			for ( int sibling : neighbours[ neighbour ] ) {
+				if ( ! placed[ sibling ] ) {
+					scores[ sibling ] += change;
+
+					if ( change > 0 ) {
+						heap.push( std::make_pair( scores[ sibling ], -sibling ) );
+					}
+				}
+			}
+		}
+	};
+
+	std::vector<int> order;
+	order.reserve( num_nodes );
+
+	// The order starts at the node of highest degree, as in the original Gorder
+	int next = ( num_nodes > 0 ) ? 0 : -1;
+
+	for ( int i = 1; i < num_nodes; i++ ) {
+		if ( neighbours[ i ].size() > neighbours[ next ].size() ) {
+			next = i;
+		}
+	}
+
+	while ( next >= 0 ) {
+		placed[ next ] = true;
+		order.push_back( next );
+		updateScores( next, 1 );
+
+		if ( order.size() > (unsigned int) GORDER_WINDOW_SIZE ) {
+			updateScores( order[ order.size() - GORDER_WINDOW_SIZE - 1 ], -1 );
+		}
+
+		if ( heap.size() > 4 * (size_t) num_nodes ) {
+			std::vector<std::pair<int, int> > entries;
+
+			for ( int i = 0; i < num_nodes; i++ ) {
+				if ( ! placed[ i ] ) {
+					entries.push_back( std::make_pair( scores[ i ], -i ) );
+				}
+			}
+
+			heap = std::priority_queue<std::pair<int, int> >( entries.begin(), entries.end() );
+		}
+
+		// Unplaced node of highest score. An entry above the current score is stale and is replaced by the current
+		// score, while an entry below it is outdated by an entry pushed since
+		next = -1;
+
+		while ( ! heap.empty() ) {
+			std::pair<int, int> entry = heap.top();
+			int node = -entry.second;
+			heap.pop();
+
+			if ( placed[ node ] || entry.first < scores[ node ] ) {
+				continue;
+			}
+
+			if ( entry.first > scores[ node ] ) {
+				heap.push( std::make_pair( scores[ node ], -node ) );
+				continue;
+			}
+
+			next = node;
+			break;
+		}
+	}
+
+	// Reversing keeps the nodes of every window together, but moves the hubs placed early to the highest IDs, where they
+	// have the fewest higher-ID neighbours
+	std::reverse( order.begin(), order.end() );
+
+	return order;
+}
+
+std::vector<int> NodeOrder::compute( Graph *graph, int order ) {
+	std::vector<int> node_order;
+
+	if ( order == NODE_ORDER_NONE ) {
+		return node_order;
+	}
+
+	std::vector<int> nodes = graph->getNodeIds();
+	std::vector<std::vector<int> > neighbours = getNeighbourPositions( graph, nodes );
+	std::vector<int> positions;
+
+	if ( order == NODE_ORDER_DEGREE ) {
+		positions = getDegreeOrder( neighbours );
+	}
+	else if ( order == NODE_ORDER_RCM ) {
+		positions = getRCMOrder( neighbours );
+	}
+	else {
+		positions = getGorderOrder( neighbours );
+	}
+
+	for ( int position : positions ) {
+		node_order.push_back( nodes[ position ] );
+	}
+
+	return node_order;
+}
+
+bool NodeOrder::apply( Graph *graph, int order, bool verbose ) {
+	if ( order == NODE_ORDER_NONE ) {
+		return false;
+	}
+
+	ProgressMonitor pm;
+
+	if ( ! graph->renumberNodes( compute( graph, order ) ) ) {
+		return false;
+	}
+
+	if ( verbose ) {
+		printf( "Renumbering the nodes took %.2f seconds.\n", pm.lap() );
+	}
+
+	return true;
+}
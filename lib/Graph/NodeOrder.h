@@ -0,0 +1,105 @@
+#ifndef NODEORDER_H
+#define NODEORDER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+
+// Program includes
+#include "Graph.h"
+
+// Orders in which the nodes of a graph are renumbered before the search
+// ==========
+// Keep the node IDs of the input file, in ascending order
+const int NODE_ORDER_NONE = 0;
+
+// Ascending degree, so that high-degree nodes have the highest IDs and thus few higher-ID neighbours (N+)
+const int NODE_ORDER_DEGREE = 1;
+
+// Reverse Cuthill-McKee: breadth-first search from a node of lowest degree per component, visiting neighbours in order
+// of ascending degree, reversed. Neighbours receive nearby IDs, which keeps the neighbour lists narrow in ID range
+const int NODE_ORDER_RCM = 2;
+
+// Gorder: greedily append the node sharing the most neighbours and edges with the last GORDER_WINDOW_SIZE nodes, so
+// that nodes whose neighbourhoods are searched together receive nearby IDs. The order starts at the node of highest
+// degree and is reversed, so that high-degree nodes tend to receive high IDs as with the other orders
+const int NODE_ORDER_GORDER = 3;
+
+// Number of most recently placed nodes the next node is scored against by Gorder
+const int GORDER_WINDOW_SIZE = 5;
+
+/**
+ * Vertex orders improving the memory locality of the search. The nodes are renumbered in the computed order, so that
+ * the neighbour lists and edges touched together by the search are close together in memory, and the order determines
+ * which neighbours of a node are its higher-ID neighbours (N+). All orders are deterministic, so that every process
+ * computes the same order from the same graph
+ */
+class NodeOrder {
+	protected:
+		/**
+		 * Node positions in order of ascending degree, with ties broken by position
+		 *
+		 * @param const std::vector<std::vector<int> >& neighbours Neighbour positions of every node
+		 * @return std::vector<int> Node positions in order
+		 */
+		static std::vector<int> getDegreeOrder( const std::vector<std::vector<int> > &neighbours );
+
+		/**
+		 * Node positions in reverse Cuthill-McKee order
+		 *
+		 * @param const std::vector<std::vector<int> >& neighbours Neighbour positions of every node
+		 * @return std::vector<int> Node positions in order
+		 */
+		static std::vector<int> getRCMOrder( const std::vector<std::vector<int> > &neighbours );
+
+		/**
+		 * Node positions in reversed Gorder order. Shared neighbours through nodes of degree above the square root of the
+		 * number of nodes are not scored, which bounds the time of the greedy placement as in the original Gorder
+		 *
+		 * @param const std::vector<std::vector<int> >& neighbours Neighbour positions of every node
+		 * @return std::vector<int> Node positions in order
+		 */
+		static std::vector<int> getGorderOrder( const std::vector<std::vector<int> > &neighbours );
+
+	public:
+		/**
+		 * Find the order with a name: none (or empty), degree, rcm or gorder
+		 *
+		 * @param const std::string& name Name of the order
+		 * @return int Order, see NODE_ORDER_*, or -1 for an unknown name
+		 */
+		static int parse( const std::string &name );
+
+		/**
+		 * Sorted neighbours of every node, indexed by position of the node in the sorted node IDs
+		 *
+		 * @param Graph* graph Graph
+		 * @param const std::vector<int>& nodes Sorted node IDs of the graph
+		 * @return std::vector<std::vector<int> > Positions of the neighbours of every node
+		 */
+		static std::vector<std::vector<int> > getNeighbourPositions( Graph *graph, const std::vector<int> &nodes );
+
+		/**
+		 * Compute an order of the nodes of a graph
+		 *
+		 * @param Graph* graph Graph
+		 * @param int order Order, see NODE_ORDER_*
+		 * @return std::vector<int> Node IDs in order, or an empty list for NODE_ORDER_NONE
+		 */
+		static std::vector<int> compute( Graph *graph, int order );
+
+		/**
+		 * Renumber the nodes of a graph in an order, translating the node IDs of the input file along, and report the
+		 * time taken in verbose mode. Graphs in compressed sparse row format are left unchanged
+		 *
+		 * @param Graph* graph Graph
+		 * @param int order Order, see NODE_ORDER_*
+		 * @param bool verbose Whether to report the time taken
+		 * @return bool Whether the nodes were renumbered
+		 */
+		static bool apply( Graph *graph, int order, bool verbose );
+};
+
+#endif
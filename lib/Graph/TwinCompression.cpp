@@ -0,0 +1,110 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdio.h>
+
+// Boost includes
+#include <boost/functional/hash.hpp>
+
+// Program includes
+#include "TwinCompression.h"
+#include "NodeOrder.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+
+std::vector<int> TwinCompression::getTwinClasses( const std::vector<std::vector<int> > &neighbours, bool adjacent ) {
+	int num_nodes = neighbours.size();
+	std::vector<int> classes( num_nodes );
+
+	// Sorted neighbourhood of a node, including the node itself for true twins
+	auto getNeighbourhood = [&]( int node ) {
+		std::vector<int> neighbourhood = neighbours[ node ];
+
+		if ( adjacent ) {
+			neighbourhood.insert( std::upper_bound( neighbourhood.begin(), neighbourhood.end(), node ), node );
+		}
+
+		return neighbourhood;
+	};
+
+	// First members of the classes found so far, by hash of their neighbourhood
+	std::unordered_map<size_t, std::vector<int> > first_members;
+	first_members.reserve( num_nodes );
+
+	for ( int i = 0; i < num_nodes; i++ ) {
+		std::vector<int> neighbourhood = getNeighbourhood( i );
+		std::vector<int> &candidates = first_members[ boost::hash_range( neighbourhood.begin(), neighbourhood.end() ) ];
+		classes[ i ] = i;
+
+		for ( int first : candidates ) {
+			if ( getNeighbourhood( first ) == neighbourhood ) {
+				classes[ i ] = first;
+				break;
+			}
+		}
+
+		if ( classes[ i ] == i ) {
+			candidates.push_back( i );
+		}
+	}
+
+	return classes;
+}
+
+bool TwinCompression::apply( Graph *graph, bool verbose ) {
+	ProgressMonitor pm;
+
+	std::vector<int> nodes = graph->getNodeIds();
+	std::vector<std::vector<int> > neighbours = NodeOrder::getNeighbourPositions( graph, nodes );
+	std::vector<int> true_classes = getTwinClasses( neighbours, true );
+	std::vector<int> false_classes = getTwinClasses( neighbours, false );
+
+	std::vector<int> true_class_sizes( nodes.size(), 0 );
+
+	for ( int first : true_classes ) {
+		true_class_sizes[ first ]++;
+	}
+
+	// Classes in order of their first member. A node with true twins has no false twins, as a false twin would be a
+	// neighbour of its true twins and thereby of itself
+	std::vector<int> class_ids( nodes.size(), -1 );
+	std::vector<std::vector<int> > twins;
+	std::vector<bool> twins_adjacent;
+	int num_true_twins = 0;
+	int num_false_twins = 0;
+
+	for ( unsigned int i = 0; i < nodes.size(); i++ ) {
+		bool adjacent = ( true_class_sizes[ true_classes[ i ] ] > 1 );
+		int first = adjacent ? true_classes[ i ] : false_classes[ i ];
+
+		if ( class_ids[ first ] == -1 ) {
+			class_ids[ first ] = twins.size();
+			twins.push_back( std::vector<int>() );
+			twins_adjacent.push_back( adjacent );
+		}
+		else if ( adjacent ) {
+			num_true_twins++;
+		}
+		else {
+			num_false_twins++;
+		}
+
+		twins[ class_ids[ first ] ].push_back( nodes[ i ] );
+	}
+
+	bool collapsed = ( twins.size() < nodes.size() && graph->collapseTwins( twins, twins_adjacent ) );
+
+	if ( ! collapsed ) {
+		num_true_twins = 0;
+		num_false_twins = 0;
+	}
+
+	if ( verbose ) {
+		printf( "Collapsed %d true twins and %d false twins: %d nodes, %d edges left.\n", num_true_twins, num_false_twins, graph->getNumNodes(), graph->getNumEdges() );
+		printf( "Collapsing twins took %.2f seconds.\n", pm.lap() );
+	}
+
+	return collapsed;
+}
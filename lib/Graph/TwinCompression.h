@@ -0,0 +1,45 @@
+#ifndef TWINCOMPRESSION_H
+#define TWINCOMPRESSION_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+// Program includes
+#include "Graph.h"
+
+/**
+ * Collapse of structurally equivalent nodes. True twins are adjacent nodes with the same closed neighbourhood, and false
+ * twins are non-adjacent nodes with the same open neighbourhood, such as the leaves of a fan. A class of twins is
+ * collapsed into a single node weighted by its number of members (see Graph::collapseTwins()), which the search counts
+ * combinatorially: a clique holds any non-empty subset of a class of true twins and a single member of a class of false
+ * twins, so that a clique of the collapsed graph stands for a known number of cliques of every size of the input graph.
+ * A node cannot have both true and false twins, so that the classes partition the nodes
+ */
+class TwinCompression {
+	protected:
+		/**
+		 * Find the classes of twins by hashing the open or closed neighbourhood of every node, comparing the
+		 * neighbourhoods of nodes with equal hashes
+		 *
+		 * @param const std::vector<std::vector<int> >& neighbours Sorted neighbour positions of every node
+		 * @param bool adjacent Whether to find true twins (closed neighbourhoods) or false twins (open neighbourhoods)
+		 * @return std::vector<int> Position of the first member of the class of every node
+		 */
+		static std::vector<int> getTwinClasses( const std::vector<std::vector<int> > &neighbours, bool adjacent );
+
+	public:
+		/**
+		 * Collapse the classes of twins of a graph into single nodes, keeping the nodes in the order of their first
+		 * member, and report the result and the time taken in verbose mode. Graphs in compressed sparse row format are
+		 * left unchanged
+		 *
+		 * @param Graph* graph Graph
+		 * @param bool verbose Whether to report the number of twins collapsed and the time taken
+		 * @return bool Whether the twins were collapsed
+		 */
+		static bool apply( Graph *graph, bool verbose );
+};
+
+#endif
@@ -0,0 +1,98 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <sstream>
+#include <istream>
+
+// Program includes
+#include "IncrementalCounter.h"
+
+void IncrementalCounter::setPartition( int partition, int num_partitions ) {
+	this->partition = partition;
+	this->num_partitions = num_partitions;
+	cliquefinder.initParallelComputation( partition, num_partitions, false );
+}
+
+void IncrementalCounter::setCliqueSizeRange( int size_min, int size_max ) {
+	cliquefinder.setCliqueSizeRange( size_min, size_max );
+}
+
+std::vector<long long> IncrementalCounter::countCliques() {
+	cliquefinder.findAllCliquesDFS();
+
+	return cliquefinder.getCliquesCountsVector();
+}
+
+int IncrementalCounter::applyUpdates( const std::vector<EdgeUpdate> &updates, std::vector<long long> &cliques_counts_change ) {
+	int num_ignored = 0;
+
+	for ( const EdgeUpdate &update : updates ) {
+		bool counted = ( num_updates++ % num_partitions == partition );
+
+		// Only insertions add nodes, so removals of edges with unknown end points are ignored as missing edges
+		int node_source = graph->getNodeId( update.node_source, update.insert );
+		int node_target = graph->getNodeId( update.node_target, update.insert );
+
+		if ( node_source < 0 || node_target < 0 || node_source == node_target || update.insert == graph->isEdge( node_source, node_target ) ) {
+			num_ignored++;
+			continue;
+		}
+
+		// The cliques containing the edge do not depend on the edge itself, so they are counted before removing it and
+		// after inserting it alike
+		if ( update.insert ) {
+			graph->addEdge( node_source, node_target );
+		}
+
+		if ( counted ) {
+			std::vector<long long> cliques_counts = cliquefinder.countEdgeCliques( node_source, node_target );
+
+			if ( cliques_counts_change.size() < cliques_counts.size() ) {
+				cliques_counts_change.resize( cliques_counts.size(), 0 );
+			}
+
+			for ( unsigned int size = 0; size < cliques_counts.size(); size++ ) {
+				cliques_counts_change[ size ] += update.insert ? cliques_counts[ size ] : -cliques_counts[ size ];
+			}
+		}
+
+		if ( ! update.insert ) {
+			graph->removeEdge( node_source, node_target );
+		}
+	}
+
+	return num_ignored;
+}
+
+int IncrementalCounter::readUpdates( std::istream &input, int max_updates, std::vector<EdgeUpdate> &updates ) {
+	int num_invalid = 0;
+
+	for ( int i = 0; i < max_updates; ) {
+		std::string row;
+
+		if ( ! std::getline( input, row ) ) {
+			break;
+		}
+
+		if ( row.find_first_not_of( " \t\r" ) == std::string::npos || row[0] == '#' ) {
+			continue;
+		}
+
+		std::istringstream row_fields( row );
+		std::string operation;
+		EdgeUpdate update;
+
+		if ( ! ( row_fields >> operation >> update.node_source >> update.node_target ) || ( operation != "+" && operation != "-" ) ) {
+			num_invalid++;
+			continue;
+		}
+
+		update.insert = ( operation == "+" );
+		updates.push_back( update );
+		i++;
+	}
+
+	return num_invalid;
+}
@@ -0,0 +1,111 @@
+#ifndef INCREMENTALCOUNTER_H
+#define INCREMENTALCOUNTER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <istream>
+
+// Program includes
+#include "../Graph/Graph.h"
+#include "../CliqueFinder/CliqueFinder.h"
+
+/**
+ * Insertion or removal of an edge, between two external node IDs as used in the input file
+ */
+struct EdgeUpdate {
+	bool insert;
+	long long node_source;
+	long long node_target;
+};
+
+/**
+ * Clique counts of a graph that changes by edge insertions and removals. After counting the cliques of the base graph
+ * once, every update changes the counts by the number of cliques containing the changed edge, which are the cliques in
+ * the common neighbourhood of its end points extended by the edge. The time per update thus depends on the
+ * neighbourhoods of its end points only, and not on the size of the graph.
+ *
+ * The work can be split over several workers, each holding a copy of the graph. Every worker applies every update to
+ * its graph, in the same order, but only counts the cliques of its own partition of the root tasks of the base graph
+ * and of the updates, so that the sum of the counts of all workers is the count of a single worker
+ */
+class IncrementalCounter {
+	protected:
+		/**
+		 * Graph, which is changed by the updates
+		 */
+		Graph *graph;
+
+		/**
+		 * Clique finder counting the cliques of the base graph, and the cliques containing changed edges
+		 */
+		CliqueFinder cliquefinder;
+
+		/**
+		 * Partition of root tasks and updates of this worker, and the number of partitions
+		 */
+		int partition = 0;
+		int num_partitions = 1;
+
+		/**
+		 * Number of updates applied so far, including the updates of other partitions
+		 */
+		long long num_updates = 0;
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param Graph* graph Base graph, which is changed by the updates
+		 */
+		IncrementalCounter( Graph *graph ) : graph(graph), cliquefinder(NULL, graph) {
+			cliquefinder.initParallelComputation( 0, 1, false );
+		}
+
+		/**
+		 * Set the partition of the root tasks and updates whose cliques this worker counts
+		 *
+		 * @param int partition Index of this worker
+		 * @param int num_partitions Number of workers
+		 */
+		void setPartition( int partition, int num_partitions );
+
+		/**
+		 * @see CliqueFinder::setCliqueSizeRange()
+		 */
+		void setCliqueSizeRange( int size_min, int size_max );
+
+		/**
+		 * Count the cliques of the base graph under the root tasks of this partition
+		 *
+		 * @return std::vector<long long> Number of cliques per clique size
+		 */
+		std::vector<long long> countCliques();
+
+		/**
+		 * Apply updates to the graph, and count the change of the number of cliques of the updates of this partition.
+		 * Updates inserting an existing edge, removing a missing edge, or connecting a node to itself are ignored. Nodes
+		 * new to the graph are assigned the next node ID, which is the same for all workers as they apply the same
+		 * updates in the same order
+		 *
+		 * @param const std::vector<EdgeUpdate>& updates Updates, in the order in which they are applied
+		 * @param std::vector<long long>& cliques_counts_change Output. Change of the number of cliques per clique size,
+		 * which is added to
+		 * @return int Number of ignored updates
+		 */
+		int applyUpdates( const std::vector<EdgeUpdate> &updates, std::vector<long long> &cliques_counts_change );
+
+		/**
+		 * Read updates from a stream, one per line: "+" to insert or "-" to remove an edge, followed by its source and
+		 * target node ID, separated by whitespace. Empty lines and lines starting with "#" are skipped
+		 *
+		 * @param std::istream& input Input stream
+		 * @param int max_updates Maximum number of updates to read
+		 * @param std::vector<EdgeUpdate>& updates Output. Updates read, which are added to
+		 * @return int Number of invalid lines skipped
+		 */
+		static int readUpdates( std::istream &input, int max_updates, std::vector<EdgeUpdate> &updates );
+};
+
+#endif
@@ -0,0 +1,292 @@
+// Includes
+// ==========
+// STL includes
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+// Program includes
+#include "CliqueCounter.h"
+#include "../Transport/ThreadTransport.h"
+#include "../Transport/Worker.h"
+#include "../CliqueFinder/CliqueFinder.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+#include "../Trace/Trace.h"
+#include "../Progress/ProgressReporter.h"
+
+ResultsReport CliqueCounter::countCliques( Graph *graph ) {
+	ProgressMonitor pm_run;
+
+	// Collapse twins and renumber the nodes before anything refers to their IDs
+	if ( twin_compression ) {
+		TraceScope trace_scope( "twin compression" );
+		TwinCompression::apply( graph, verbose );
+	}
+
+	{
+		TraceScope trace_scope( "node order" );
+		NodeOrder::apply( graph, node_order, verbose );
+	}
+
+	// Create a worker with its own transport and clique finder per thread. Help can only be provided if there are
+	// other threads taking part in the computation
+	ThreadTransportState state( num_threads, help_match_policy );
+	std::vector<std::unique_ptr<ThreadTransport> > transports;
+	std::vector<std::unique_ptr<Worker> > workers;
+	std::vector<std::unique_ptr<CliqueFinder> > cliquefinders;
+	std::vector<std::unique_ptr<CliqueWriter> > clique_writers;
+	std::vector<std::unique_ptr<Checkpointer> > checkpointers;
+
+	// Prepare the checkpoint directory before any thread starts, as resuming replaces its contents
+	int checkpoint_generation = ( checkpoint_dir != "" ) ? Checkpointer::prepare( checkpoint_dir, checkpoint_resume ) : 0;
+
+	// Root cost profile shared by all threads, if one is given and was recorded on this graph
+	RootProfile root_profile;
+	std::string root_profile_contents;
+	bool root_profile_accepted = ( root_profile_fname != "" && RootProfile::readFile( root_profile_fname, root_profile_contents ) && root_profile.parse( root_profile_contents, graph, edge_roots, true ) );
+
+	// Board to which the threads publish their progress, if it is reported
+	ProgressBoard progress_board( num_threads );
+
+	for ( int i = 0; i < num_threads; i++ ) {
+		transports.emplace_back( new ThreadTransport( &state, i ) );
+		workers.emplace_back( new Worker( transports[ i ].get(), help_enabled && num_threads > 1 ) );
+		cliquefinders.emplace_back( new CliqueFinder( workers[ i ].get(), graph ) );
+		workers[ i ]->setCliqueFinder( cliquefinders[ i ].get() );
+
+		cliquefinders[ i ]->initParallelComputation( i, num_threads, help_enabled && num_threads > 1 );
+		cliquefinders[ i ]->setHelpRequestThreshold( help_request_threshold );
+		cliquefinders[ i ]->setHelpRequestThresholdAdaptive( help_threshold_adaptive );
+		cliquefinders[ i ]->setEdgeRoots( edge_roots );
+		cliquefinders[ i ]->setRecordRootCosts( record_root_costs );
+		cliquefinders[ i ]->setRecordNodeCounts( record_node_counts );
+		cliquefinders[ i ]->setSampling( sample_target_error, sample_confidence, sample_seed );
+		cliquefinders[ i ]->setDeadline( deadline );
+
+		if ( root_profile_accepted ) {
+			cliquefinders[ i ]->setRootProfile( &root_profile );
+		}
+
+		if ( progress_interval > 0 ) {
+			cliquefinders[ i ]->setProgressBoard( &progress_board, progress_interval );
+		}
+		cliquefinders[ i ]->setCliqueSizeRange( clique_size_min, clique_size_max );
+
+		if ( clique_output_prefix != "" ) {
+			clique_writers.emplace_back( new CliqueWriter( clique_output_prefix + "." + std::to_string( i ), clique_output_format ) );
+			clique_writers[ i ]->setGraph( graph );
+			cliquefinders[ i ]->setCliqueWriter( clique_writers[ i ].get() );
+		}
+
+		if ( checkpoint_dir != "" ) {
+			checkpointers.emplace_back( new Checkpointer( checkpoint_dir, checkpoint_generation, i, i, num_threads, num_threads, checkpoint_interval ) );
+			workers[ i ]->setCheckpointer( checkpointers[ i ].get() );
+
+			CheckpointSnapshot resumed;
+			bool is_resumed = Checkpointer::readResumed( checkpoint_dir, checkpoint_generation, i, num_threads, resumed );
+			cliquefinders[ i ]->setCheckpointer( checkpointers[ i ].get(), is_resumed ? &resumed : NULL );
+		}
+	}
+
+	// Find cliques on all threads, and combine the result records of all workers
+	ResultsReport report;
+	std::vector<std::thread> threads;
+	ProgressReporter progress_reporter( &progress_board, progress_interval );
+
+	if ( progress_interval > 0 ) {
+		progress_reporter.start();
+	}
+
+	for ( int i = 0; i < num_threads; i++ ) {
+		threads.push_back( std::thread( [&, i]() {
+			Trace::setThreadName( "worker " + std::to_string( i ) );
+			workers[ i ]->findCliques();
+
+			if ( checkpoint_dir != "" ) {
+				checkpointers[ i ]->close();
+			}
+
+			if ( clique_output_prefix != "" ) {
+				clique_writers[ i ]->close();
+			}
+
+			std::vector<long long> record_total = transports[ i ]->reduceResults( workers[ i ]->getResultRecord() );
+
+			if ( i == 0 ) {
+				report.record = record_total;
+			}
+		} ) );
+	}
+
+	for ( auto &thread : threads ) {
+		thread.join();
+	}
+
+	progress_reporter.stop();
+
+	if ( record_root_costs ) {
+		report.root_costs_header = RootProfile::getHeader( edge_roots, RootProfile::getGraphSummary( graph ) );
+	}
+
+	// Gather the help request threshold trajectories, root task costs, node clique counts and search statistics of all
+	// workers
+	for ( int i = 0; i < num_threads; i++ ) {
+		if ( help_threshold_adaptive ) {
+			report.help_threshold_trajectories.push_back( cliquefinders[ i ]->getHelpRequestThresholdTrajectory() );
+		}
+
+		std::vector<double> root_costs = cliquefinders[ i ]->getRootCosts();
+		report.root_costs.insert( report.root_costs.end(), root_costs.begin(), root_costs.end() );
+
+		if ( record_node_counts ) {
+			report.addNodeCliquesCounts( cliquefinders[ i ]->getNodeCliquesCountsIdMin(), cliquefinders[ i ]->getNodeCliquesCounts() );
+		}
+	}
+
+	if ( record_node_counts ) {
+		report.node_id_min = graph->getNodeIdMin();
+		report.num_nodes = std::max( graph->getNodeIdMax() - graph->getNodeIdMin() + 1, 0 );
+		report.node_external_ids = graph->getExternalNodeIds();
+	}
+
+	if ( sample_target_error > 0 ) {
+		int sample_num_sizes = 0;
+
+		for ( int i = 0; i < num_threads; i++ ) {
+			sample_num_sizes = std::max( sample_num_sizes, cliquefinders[ i ]->getSampleEstimate().getNumSizes() );
+		}
+
+		for ( int i = 0; i < num_threads; i++ ) {
+			std::vector<double> sample_record = cliquefinders[ i ]->getSampleEstimate().getRecord( sample_num_sizes );
+			report.sample_record.resize( sample_record.size(), 0 );
+
+			for ( unsigned int j = 0; j < sample_record.size(); j++ ) {
+				report.sample_record[ j ] += sample_record[ j ];
+			}
+		}
+
+		report.sample_target_error = sample_target_error;
+		report.sample_confidence = sample_confidence;
+	}
+
+#ifdef CLIQUES_STATS
+	int stats_num_depths = 0;
+
+	for ( int i = 0; i < num_threads; i++ ) {
+		stats_num_depths = std::max( stats_num_depths, cliquefinders[ i ]->stats.getNumDepths() );
+	}
+
+	for ( int i = 0; i < num_threads; i++ ) {
+		std::vector<long long> stats = cliquefinders[ i ]->stats.getRecord( stats_num_depths );
+		report.stats.resize( stats.size(), 0 );
+
+		for ( unsigned int j = 0; j < stats.size(); j++ ) {
+			report.stats[ j ] += stats[ j ];
+		}
+	}
+#endif
+
+	report.num_processes = num_threads;
+	report.num_workers = num_threads;
+	report.help_request_threshold = help_request_threshold;
+	report.help_threshold_adaptive = help_threshold_adaptive;
+	report.time_past = pm_run.stop();
+
+	return report;
+}
+
+ResultsReport CliqueCounter::countCliquesCSR( int num_nodes, const long long *offsets, const int *neighbours ) {
+	Graph graph;
+	graph.useCSR( num_nodes, offsets, neighbours );
+
+	return countCliques( &graph );
+}
+
+ResultsReport CliqueCounter::countCliquesEdgeArray( const int *edges, long long num_edges ) {
+	Graph graph;
+
+	for ( long long i = 0; i < num_edges; i++ ) {
+		graph.addEdge( edges[ 2 * i ], edges[ 2 * i + 1 ] );
+	}
+
+	return countCliques( &graph );
+}
+
+void CliqueCounter::setNumThreads( int threads ) {
+	num_threads = ( threads > 0 ) ? threads : std::max( (int) std::thread::hardware_concurrency(), 1 );
+}
+
+void CliqueCounter::setVerbose( bool v ) {
+	verbose = v;
+}
+
+void CliqueCounter::setEnableDynamicLoadBalancing( bool enabled ) {
+	help_enabled = enabled;
+}
+
+void CliqueCounter::setHelpRequestThreshold( int threshold ) {
+	help_request_threshold = threshold;
+}
+
+void CliqueCounter::setHelpRequestThresholdAdaptive( bool enabled ) {
+	help_threshold_adaptive = enabled;
+}
+
+void CliqueCounter::setHelpMatchPolicy( int policy ) {
+	help_match_policy = policy;
+}
+
+void CliqueCounter::setEnableEdgeRoots( bool enabled ) {
+	edge_roots = enabled;
+}
+
+void CliqueCounter::setNodeOrder( int order ) {
+	node_order = order;
+}
+
+void CliqueCounter::setTwinCompression( bool enabled ) {
+	twin_compression = enabled;
+}
+
+void CliqueCounter::setRecordRootCosts( bool enabled ) {
+	record_root_costs = enabled;
+}
+
+void CliqueCounter::setRecordNodeCounts( bool enabled ) {
+	record_node_counts = enabled;
+}
+
+void CliqueCounter::setCheckpointing( std::string dir, double interval, bool resume ) {
+	checkpoint_dir = dir;
+	checkpoint_interval = interval;
+	checkpoint_resume = resume;
+}
+
+void CliqueCounter::setDeadline( double seconds ) {
+	deadline = seconds;
+}
+
+void CliqueCounter::setRootProfileFileName( std::string fname ) {
+	root_profile_fname = fname;
+}
+
+void CliqueCounter::setProgressInterval( double seconds ) {
+	progress_interval = seconds;
+}
+
+void CliqueCounter::setSampling( double target_error, double confidence, unsigned int seed ) {
+	sample_target_error = target_error;
+	sample_confidence = confidence;
+	sample_seed = seed;
+}
+
+void CliqueCounter::setCliqueSizeRange( int size_min, int size_max ) {
+	clique_size_min = size_min;
+	clique_size_max = size_max;
+}
+
+void CliqueCounter::setCliqueOutput( std::string prefix, int format ) {
+	clique_output_prefix = prefix;
+	clique_output_format = format;
+}
@@ -0,0 +1,280 @@
+#ifndef CLIQUECOUNTER_H
+#define CLIQUECOUNTER_H
+
+// Includes
+// ==========
+// STL includes
+#include <string>
+
+// Program includes
+#include "../Graph/Graph.h"
+#include "../Graph/NodeOrder.h"
+#include "../Graph/TwinCompression.h"
+#include "../Results/ResultsReport.h"
+#include "../CliqueFinder/CliqueWriter.h"
+#include "../Checkpoint/Checkpointer.h"
+#include "../Process/const.h"
+
+/**
+ * Entry point of the parallelcliques library: counts the cliques of a graph held in memory, within a single process
+ * and without MPI, with one worker per thread. The graph is shared read-only by all workers, and help requests are
+ * matched through ThreadTransport. Settings mirror the program arguments of the same name.
+ *
+ * Example:
+ *   CliqueCounter counter;
+ *   counter.setNumThreads( 8 );
+ *   ResultsReport results = counter.countCliquesCSR( num_nodes, offsets, neighbours );
+ *   long long num_triangles = results.getCliquesCounts()[ 3 ];
+ */
+class CliqueCounter {
+	protected:
+		/**
+		 * Number of threads taking part in the computation
+		 */
+		int num_threads = 1;
+
+		/**
+		 * Whether to report the preparation of the graph before the search
+		 */
+		bool verbose = false;
+
+		/**
+		 * Help request settings, see the corresponding settings of Process
+		 */
+		bool help_enabled = true;
+		int help_request_threshold = 0;
+		bool help_threshold_adaptive = false;
+		int help_match_policy = HELP_MATCH_FIRST;
+
+		/**
+		 * Whether the root tasks of the search are oriented edges instead of single nodes
+		 */
+		bool edge_roots = false;
+
+		/**
+		 * Order in which the nodes of the graph are renumbered before the search, see NODE_ORDER_* in NodeOrder.h
+		 */
+		int node_order = NODE_ORDER_NONE;
+
+		/**
+		 * Whether classes of twins in the graph are collapsed into single nodes before the search, see TwinCompression
+		 */
+		bool twin_compression = false;
+
+		/**
+		 * Whether to record the cost of each root task
+		 */
+		bool record_root_costs = false;
+
+		/**
+		 * File name of the root cost profile to partition the root tasks by, or empty to partition them by ID
+		 */
+		std::string root_profile_fname = "";
+
+		/**
+		 * Whether to record the number of cliques each node belongs to
+		 */
+		bool record_node_counts = false;
+
+		/**
+		 * Smallest and largest clique size to count, or 0 for no limit
+		 */
+		int clique_size_min = 0;
+		int clique_size_max = 0;
+
+		/**
+		 * Prefix of the files to which each thread lists the cliques it finds, or empty if cliques are only counted, and
+		 * the format of these files
+		 */
+		std::string clique_output_prefix = "";
+		int clique_output_format = CLIQUE_OUTPUT_BINARY;
+
+		/**
+		 * Checkpointing settings, see Process::setCheckpointing()
+		 */
+		std::string checkpoint_dir = "";
+		double checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+		bool checkpoint_resume = false;
+
+		/**
+		 * Time budget of the search in seconds, or 0 for none, see CliqueFinder::setDeadline()
+		 */
+		double deadline = 0;
+
+		/**
+		 * Time (in seconds) between two progress lines, or 0 for none, see setProgressInterval()
+		 */
+		double progress_interval = 0;
+
+		/**
+		 * Sampling settings, see CliqueFinder::setSampling()
+		 */
+		double sample_target_error = 0;
+		double sample_confidence = 0.95;
+		unsigned int sample_seed = 0;
+
+	public:
+		/**
+		 * Count the cliques of a graph. With twin compression or a node order set, the graph is collapsed and renumbered
+		 * in place before the search, and is left that way (see setTwinCompression() and setNodeOrder()); pass a copy to
+		 * keep the original. The clique counts are those of the graph as passed
+		 *
+		 * @param Graph* graph Graph, which is collapsed and renumbered in place if enabled, and otherwise only read
+		 * @return ResultsReport Clique counts per clique size, help request counts, busy times, and the help request
+		 * threshold trajectories, root task costs, node clique counts and search statistics if enabled. No output files are
+		 * set
+		 */
+		ResultsReport countCliques( Graph *graph );
+
+		/**
+		 * Count the cliques of a graph in compressed sparse row format, without copying it
+		 *
+		 * @see Graph::useCSR()
+		 * @see CliqueCounter::countCliques()
+		 */
+		ResultsReport countCliquesCSR( int num_nodes, const long long *offsets, const int *neighbours );
+
+		/**
+		 * Count the cliques of a graph given as an array of edges. As edges have to be looked up by their end points, the
+		 * edges are copied into a graph first; use countCliquesCSR() to avoid the copy
+		 *
+		 * @param const int* edges Source and target node ID of each edge, i.e. 2 * num_edges node IDs. Edges may be given
+		 * in one or both directions
+		 * @param long long num_edges Number of edges
+		 * @see CliqueCounter::countCliques()
+		 */
+		ResultsReport countCliquesEdgeArray( const int *edges, long long num_edges );
+
+		/**
+		 * Set the number of threads taking part in the computation
+		 *
+		 * @param int threads Number of threads, or 0 for one per hardware thread
+		 */
+		void setNumThreads( int threads );
+
+		/**
+		 * Change the verbose setting. Use true if the preparation of the graph before the search should be reported
+		 *
+		 * @param bool v New verbose setting
+		 */
+		void setVerbose( bool v );
+
+		/**
+		 * @see Process::setEnableDynamicLoadBalancing()
+		 */
+		void setEnableDynamicLoadBalancing( bool enabled );
+
+		/**
+		 * @see Process::setHelpRequestThreshold()
+		 */
+		void setHelpRequestThreshold( int threshold );
+
+		/**
+		 * @see Process::setHelpRequestThresholdAdaptive()
+		 */
+		void setHelpRequestThresholdAdaptive( bool enabled );
+
+		/**
+		 * @see Process::setHelpMatchPolicy()
+		 */
+		void setHelpMatchPolicy( int policy );
+
+		/**
+		 * @see Process::setEnableEdgeRoots()
+		 */
+		void setEnableEdgeRoots( bool enabled );
+
+		/**
+		 * Set the order in which the nodes of the graph are renumbered before the search. The graph passed to
+		 * countCliques() is renumbered in place, with its external node IDs translated along. Graphs in compressed sparse
+		 * row format are not renumbered
+		 *
+		 * @see Process::setNodeOrder()
+		 * @param int order Node order, see NODE_ORDER_* in NodeOrder.h
+		 */
+		void setNodeOrder( int order );
+
+		/**
+		 * Enable/disable collapsing classes of twins into single nodes before the search. The graph passed to
+		 * countCliques() is collapsed in place, before it is renumbered
+		 *
+		 * @see Process::setTwinCompression()
+		 * @param bool enabled Whether twins should be collapsed
+		 */
+		void setTwinCompression( bool enabled );
+
+		/**
+		 * Enable/disable recording the cost of each root task
+		 *
+		 * @param bool enabled Whether root task costs should be recorded
+		 */
+		void setRecordRootCosts( bool enabled );
+
+		/**
+		 * Set the root cost profile of an earlier run on the same graph, written as root task costs (see
+		 * ResultsReport::root_costs_header), by which the root tasks are partitioned over the threads. A profile recorded
+		 * on another graph or type of root tasks is rejected, and the root tasks are then partitioned by ID
+		 *
+		 * @see CliqueFinder::setRootProfile()
+		 * @param std::string fname Path of the profile, or empty to partition by ID
+		 */
+		void setRootProfileFileName( std::string fname );
+
+		/**
+		 * Enable/disable recording the number of cliques each node belongs to, per clique size within the clique size
+		 * range. The counts of all threads are summed into ResultsReport::node_cliques_counts
+		 *
+		 * @param bool enabled Whether node clique counts should be recorded
+		 */
+		void setRecordNodeCounts( bool enabled );
+
+		/**
+		 * @see CliqueFinder::setCliqueSizeRange()
+		 */
+		void setCliqueSizeRange( int size_min, int size_max );
+
+		/**
+		 * Enable/disable listing all cliques found within the clique size range. Each thread writes the cliques it finds
+		 * to its own file, named by the prefix followed by a dot and the thread index
+		 *
+		 * @see Process::setCliqueOutput()
+		 */
+		void setCliqueOutput( std::string prefix, int format );
+
+		/**
+		 * Enable/disable checkpointing of the search, and resuming it from the last consistent checkpoint, possibly
+		 * written with a different number of threads. Each thread writes its snapshots to its own files
+		 *
+		 * @see Process::setCheckpointing()
+		 */
+		void setCheckpointing( std::string dir, double interval, bool resume );
+
+		/**
+		 * Set the time budget of the search of every thread, from the start of its search. If it runs out, the report
+		 * holds the cliques of the root tasks and help tasks completed before the deadline, see
+		 * ResultsReport::isPartial()
+		 *
+		 * @see CliqueFinder::setDeadline()
+		 */
+		void setDeadline( double seconds );
+
+		/**
+		 * Enable/disable live progress reporting. While the threads search, a progress line with the fraction of the
+		 * estimated work completed, the throughput, the estimated time left and the threads with the most work left is
+		 * periodically printed to standard output
+		 *
+		 * @param double seconds Time (in seconds) between two progress lines, or 0 to disable progress reporting
+		 */
+		void setProgressInterval( double seconds );
+
+		/**
+		 * Enable/disable estimating the number of cliques by sampling root tasks instead of counting them exactly. The
+		 * estimates and their confidence intervals are reported through ResultsReport::getCliquesCounts() and
+		 * ResultsReport::getCliquesCountsHalfWidths()
+		 *
+		 * @see CliqueFinder::setSampling()
+		 */
+		void setSampling( double target_error, double confidence, unsigned int seed );
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef PARALLELCLIQUES_H
+#define PARALLELCLIQUES_H
+
+/**
+ * Public interface of the parallelcliques library (libparallelcliques.a): count the cliques of a graph held in memory,
+ * given as a Graph, in compressed sparse row format or as an array of edges, using CliqueCounter. Results are returned
+ * as a ResultsReport, with the clique counts per clique size and the statistics of the computation.
+ */
+
+// Program includes
+#include "CliqueCounter.h"
+#include "../Graph/Graph.h"
+#include "../Results/ResultsReport.h"
+#include "../Process/const.h"
+
+#endif
@@ -0,0 +1,127 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+
+// Program includes
+#include "RootProfile.h"
+
+std::vector<unsigned long long> RootProfile::getGraphSummary( Graph *graph ) {
+	// FNV-1a hash of the forward adjacency list, which lists every edge once in a fixed order
+	unsigned long long hash = 14695981039346656037ULL;
+	AdjacencyList forwardlist = graph->getForwardAdjacencyList();
+
+	for ( const auto &node : forwardlist ) {
+		for ( int neighbour_id : node.second ) {
+			for ( unsigned long long value : { (unsigned long long) node.first, (unsigned long long) neighbour_id } ) {
+				hash = ( hash ^ value ) * 1099511628211ULL;
+			}
+		}
+	}
+
+	return { (unsigned long long) graph->getNumNodes(), (unsigned long long) graph->getNumEdges(), hash };
+}
+
+std::string RootProfile::getHeader( bool edge_roots, const std::vector<unsigned long long> &graph_summary ) {
+	char header[128];
+	snprintf( header, sizeof( header ), "# roots:%s nodes:%llu edges:%llu hash:%016llx", edge_roots ? "edge" : "node", graph_summary[0], graph_summary[1], graph_summary[2] );
+
+	return header;
+}
+
+bool RootProfile::readFile( std::string fname, std::string &contents ) {
+	std::ifstream fl_input( fname );
+
+	if ( ! fl_input ) {
+		printf( "WARNING: The root cost profile '%s' does not exist; root tasks are partitioned by ID.\n", fname.c_str() );
+		contents = "";
+		return false;
+	}
+
+	std::stringstream buffer;
+	buffer << fl_input.rdbuf();
+	contents = buffer.str();
+
+	return true;
+}
+
+bool RootProfile::parse( const std::string &contents, Graph *graph, bool edge_roots, bool verbose ) {
+	std::istringstream fl_input( contents );
+	std::string header;
+	std::getline( fl_input, header );
+
+	if ( header != getHeader( edge_roots, getGraphSummary( graph ) ) ) {
+		if ( verbose ) {
+			printf( "WARNING: The root cost profile was recorded on another graph or type of root tasks; root tasks are partitioned by ID.\n" );
+		}
+
+		return false;
+	}
+
+	for ( std::string row; std::getline( fl_input, row ); ) {
+		std::istringstream row_fields( row );
+		long long root_id;
+		long long num_candidates;
+		double seconds;
+
+		if ( row_fields >> root_id >> num_candidates >> seconds ) {
+			root_costs[ root_id ] = seconds;
+		}
+	}
+
+	return true;
+}
+
+std::vector<long long> RootProfile::partition( const std::vector<long long> &roots, int worker_id, int num_workers ) const {
+	std::vector<long long> worker_roots;
+
+	// Root tasks with a measured cost in decreasing order of cost, and the other root tasks in the given order
+	std::vector<std::pair<double, long long> > roots_measured;
+	long long num_unmeasured = 0;
+
+	for ( long long root_id : roots ) {
+		const auto root_cost = root_costs.find( root_id );
+
+		if ( root_cost != root_costs.end() ) {
+			roots_measured.push_back( std::make_pair( -root_cost->second, root_id ) );
+		}
+		else if ( num_unmeasured++ % num_workers == worker_id ) {
+			worker_roots.push_back( root_id );
+		}
+	}
+
+	std::sort( roots_measured.begin(), roots_measured.end() );
+
+	// Longest processing time first, with ties between equally loaded workers broken by the lowest index
+	std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int> >, std::greater<std::pair<double, int> > > loads;
+
+	for ( int i = 0; i < num_workers; i++ ) {
+		loads.push( std::make_pair( 0.0, i ) );
+	}
+
+	for ( const auto &root : roots_measured ) {
+		std::pair<double, int> load = loads.top();
+		loads.pop();
+
+		if ( load.second == worker_id ) {
+			worker_roots.push_back( root.second );
+		}
+
+		loads.push( std::make_pair( load.first - root.first, load.second ) );
+	}
+
+	std::sort( worker_roots.begin(), worker_roots.end() );
+
+	return worker_roots;
+}
+
+int RootProfile::getNumRoots() const {
+	return root_costs.size();
+}
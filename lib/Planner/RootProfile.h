@@ -0,0 +1,94 @@
+#ifndef ROOTPROFILE_H
+#define ROOTPROFILE_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+// Program includes
+#include "../Graph/Graph.h"
+
+// Number of values per root task in the recorded root task costs: root ID, number of candidate nodes, time in seconds
+// and number of search tree nodes
+const int ROOT_COST_RECORD_SIZE = 4;
+
+/**
+ * Profile of the costs of the root tasks of an earlier run on the same graph, as written with the root task costs (see
+ * ResultsReport::writeRootCosts()), from which the root tasks are partitioned over the workers by their measured cost
+ * instead of by ID. The first line of the profile identifies the graph and the type of root tasks it was recorded on,
+ * so that a profile of a graph that has changed since is rejected
+ */
+class RootProfile {
+	protected:
+		/**
+		 * Measured time (in seconds) of every root task in the profile
+		 * Format: [root_id] => [seconds]
+		 */
+		std::unordered_map<long long, double> root_costs;
+
+	public:
+		/**
+		 * Get the summary of a graph identifying it in a profile: its number of nodes and edges, and a hash of all of its
+		 * edges
+		 *
+		 * @param Graph* graph Graph
+		 * @return std::vector<unsigned long long> Number of nodes, number of edges and hash of the edges
+		 */
+		static std::vector<unsigned long long> getGraphSummary( Graph *graph );
+
+		/**
+		 * Get the first line of a profile, identifying the graph and the type of root tasks it is recorded on
+		 *
+		 * @param bool edge_roots Whether the root tasks are oriented edges
+		 * @param const std::vector<unsigned long long>& graph_summary Summary of the graph, see getGraphSummary()
+		 * @return std::string Header line, without line break
+		 */
+		static std::string getHeader( bool edge_roots, const std::vector<unsigned long long> &graph_summary );
+
+		/**
+		 * Read the contents of a profile file, reporting if it is missing
+		 *
+		 * @param std::string fname File name of the profile
+		 * @param std::string& contents Output. Contents of the file, or empty if it is missing
+		 * @return bool Whether the file has been read
+		 */
+		static bool readFile( std::string fname, std::string &contents );
+
+		/**
+		 * Parse the contents of a profile, unless it was recorded on another graph or type of root tasks, in which case
+		 * the root tasks are partitioned as without a profile. Parsing the same contents for the same graph gives the
+		 * same outcome on every worker
+		 *
+		 * @param const std::string& contents Contents of the profile file, see readFile()
+		 * @param Graph* graph Graph the root tasks are partitioned of
+		 * @param bool edge_roots Whether the root tasks are oriented edges
+		 * @param bool verbose Whether to report why the profile is rejected
+		 * @return bool Whether the profile has been accepted
+		 */
+		bool parse( const std::string &contents, Graph *graph, bool edge_roots, bool verbose );
+
+		/**
+		 * Partition root tasks over the workers, assigning the root tasks in decreasing order of measured cost to the
+		 * worker with the least total cost assigned so far. Root tasks without a measured cost, which are cheap when the
+		 * graph is unchanged, are assigned in a round-robin fashion. All workers get the same partitioning from the same
+		 * profile
+		 *
+		 * @param const std::vector<long long>& roots Root IDs of all root tasks
+		 * @param int worker_id Index of the worker
+		 * @param int num_workers Number of workers
+		 * @return std::vector<long long> Root IDs of the root tasks of the worker, in increasing order
+		 */
+		std::vector<long long> partition( const std::vector<long long> &roots, int worker_id, int num_workers ) const;
+
+		/**
+		 * Get the number of root tasks in the profile
+		 *
+		 * @return int Number of root tasks
+		 */
+		int getNumRoots() const;
+};
+
+#endif
@@ -0,0 +1,467 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <stdio.h>
+#include <math.h>
+
+// Program includes
+#include "WorkPlanner.h"
+#include "../CliqueFinder/CliqueFinder.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+
+void WorkPlanner::setEdgeRoots( bool enable ) {
+	edge_roots = enable;
+}
+
+void WorkPlanner::setCliqueSizeRange( int size_min, int size_max ) {
+	clique_size_min = size_min;
+	clique_size_max = size_max;
+}
+
+void WorkPlanner::setGraphLoadTime( double seconds ) {
+	graph_load_time = seconds;
+}
+
+bool WorkPlanner::isCliqueSizeInRange( int size ) {
+	return ( clique_size_min == 0 || size >= clique_size_min ) && ( clique_size_max == 0 || size <= clique_size_max );
+}
+
+int WorkPlanner::getRootCandidates( long long root_index, double weight, std::vector<int> &potential_nodes, std::vector<double> &cliques, double &num_checks ) {
+	const std::vector<int> &node_forward = forwardlist.find( roots[ root_index ].first )->second;
+	int depth = 3;
+
+	// The root task of an edge intersects the forward neighbourhoods of its end points, and each common forward
+	// neighbour completes a triangle with the root edge (see CliqueFinder::findCliquesEdgeRoot())
+	if ( edge_roots ) {
+		const std::vector<int> &neighbour_forward = forwardlist.find( roots[ root_index ].second )->second;
+		std::set_intersection( node_forward.begin(), node_forward.end(), neighbour_forward.begin(), neighbour_forward.end(), std::back_inserter( potential_nodes ) );
+
+		num_checks += weight * ( node_forward.size() + neighbour_forward.size() );
+		num_checks_performed += node_forward.size() + neighbour_forward.size();
+		cliques.resize( std::max( (int) cliques.size(), depth + 1 ), 0 );
+		cliques[ depth ] += weight * potential_nodes.size();
+		depth++;
+	}
+	else {
+		potential_nodes = node_forward;
+	}
+
+	return depth;
+}
+
+double WorkPlanner::probe( long long root_index, double weight, std::vector<double> &cliques ) {
+	std::vector<int> potential_nodes;
+	double num_checks = 0;
+	int depth = getRootCandidates( root_index, weight, potential_nodes, cliques, num_checks );
+
+	// Follow a single candidate node at every level, which stands for all candidate nodes at that level, as in
+	// CliqueFinder::findCliquesDFS(). Candidate node i of n is chosen with a probability proportional to n - i, one more
+	// than its number of edge checks, as earlier candidate nodes have larger subtrees
+	while ( potential_nodes.size() > 1 && ( clique_size_max == 0 || depth <= clique_size_max ) ) {
+		long long num_candidates = potential_nodes.size();
+		long long weights_total = num_candidates * ( num_candidates + 1 ) / 2;
+		long long u = std::uniform_int_distribution<long long>( 0, weights_total - 1 )( rng );
+
+		// Invert the cumulative weight: u falls in the range of weight k + 1 if k ( k + 1 ) / 2 <= u < ( k + 1 ) ( k + 2 ) / 2
+		long long k = (long long) ( ( sqrt( 8.0 * u + 1 ) - 1 ) / 2 );
+
+		while ( k * ( k + 1 ) / 2 > u ) {
+			k--;
+		}
+
+		while ( ( k + 1 ) * ( k + 2 ) / 2 <= u ) {
+			k++;
+		}
+
+		int i = num_candidates - k - 1;
+		weight *= (double) weights_total / ( k + 1 );
+
+		std::vector<int> new_potential_nodes;
+
+		for ( unsigned int j = i + 1; j < potential_nodes.size(); j++ ) {
+			if ( graph->isEdge( potential_nodes[ i ], potential_nodes[ j ] ) ) {
+				new_potential_nodes.push_back( potential_nodes[ j ] );
+			}
+		}
+
+		num_checks += weight * ( potential_nodes.size() - i - 1 );
+		num_checks_performed += potential_nodes.size() - i - 1;
+		cliques.resize( std::max( (int) cliques.size(), depth + 1 ), 0 );
+		cliques[ depth ] += weight * new_potential_nodes.size();
+
+		potential_nodes = std::move( new_potential_nodes );
+		depth++;
+	}
+
+	return num_checks;
+}
+
+double WorkPlanner::search( long long root_index, std::vector<double> &cliques ) {
+	std::vector<int> potential_nodes;
+	double num_checks = 0;
+	int depth = getRootCandidates( root_index, 1, potential_nodes, cliques, num_checks );
+
+	return num_checks + searchCandidates( potential_nodes, depth, cliques );
+}
+
+double WorkPlanner::searchCandidates( const std::vector<int> &potential_nodes, int depth, std::vector<double> &cliques ) {
+	if ( potential_nodes.size() <= 1 || ( clique_size_max != 0 && depth > clique_size_max ) ) {
+		return 0;
+	}
+
+	double num_checks = 0;
+	std::vector<int> new_potential_nodes;
+	cliques.resize( std::max( (int) cliques.size(), depth + 1 ), 0 );
+
+	for ( unsigned int i = 0; i + 1 < potential_nodes.size() && ! search_cut; i++ ) {
+		search_countdown -= potential_nodes.size() - i - 1;
+
+		if ( search_countdown <= 0 ) {
+			search_countdown = PLANNER_CLOCK_CHECK_INTERVAL;
+			search_cut = pm.getCurrentClockTime() >= search_deadline;
+
+			if ( search_cut ) {
+				break;
+			}
+		}
+
+		new_potential_nodes.clear();
+
+		for ( unsigned int j = i + 1; j < potential_nodes.size(); j++ ) {
+			if ( graph->isEdge( potential_nodes[ i ], potential_nodes[ j ] ) ) {
+				new_potential_nodes.push_back( potential_nodes[ j ] );
+			}
+		}
+
+		num_checks += potential_nodes.size() - i - 1;
+		num_checks_performed += potential_nodes.size() - i - 1;
+		cliques[ depth ] += new_potential_nodes.size();
+		num_checks += searchCandidates( new_potential_nodes, depth + 1, cliques );
+	}
+
+	return num_checks;
+}
+
+void WorkPlanner::estimate( unsigned int seed ) {
+	rng.seed( seed );
+	pm.reset();
+
+	// Root tasks and their weights, as in CliqueFinder::findAllCliquesSampled(): the number of candidate node pairs
+	// a root task starts with (for edge roots, including the candidate nodes themselves)
+	forwardlist = graph->getForwardAdjacencyList();
+	std::vector<int> candidates;
+
+	for ( const auto &node : forwardlist ) {
+		if ( ! edge_roots ) {
+			if ( node.second.size() > 1 ) {
+				roots.push_back( Edge( node.first, -1 ) );
+				root_weights.push_back( node.second.size() * ( node.second.size() - 1.0 ) / 2 );
+			}
+
+			continue;
+		}
+
+		for ( int neighbour_id : node.second ) {
+			const auto neighbour_forward = forwardlist.find( neighbour_id );
+
+			if ( neighbour_forward == forwardlist.end() ) {
+				continue;
+			}
+
+			candidates.clear();
+			std::set_intersection( node.second.begin(), node.second.end(), neighbour_forward->second.begin(), neighbour_forward->second.end(), std::back_inserter( candidates ) );
+
+			if ( ! candidates.empty() ) {
+				double num_candidates = candidates.size();
+				roots.push_back( Edge( node.first, neighbour_id ) );
+				root_weights.push_back( num_candidates * ( num_candidates + 1 ) / 2 );
+			}
+		}
+	}
+
+	if ( roots.empty() ) {
+		return;
+	}
+
+	// The heaviest root tasks, which would be probed at least once within the minimum number of probes, and at least
+	// PLANNER_NUM_HEAVY_ROOTS of them, form the stratum that is searched in full. Without help, no worker finishes before
+	// its heaviest root task, so their edge checks also bound the running time
+	std::vector<long long> root_order( roots.size() );
+	std::iota( root_order.begin(), root_order.end(), 0 );
+	std::sort( root_order.begin(), root_order.end(), [&]( long long a, long long b ) { return root_weights[ a ] > root_weights[ b ]; } );
+
+	double weights_total = std::accumulate( root_weights.begin(), root_weights.end(), 0.0 );
+	long long num_heavy_roots = 0;
+
+	while ( num_heavy_roots < (long long) roots.size() && ( num_heavy_roots < PLANNER_NUM_HEAVY_ROOTS || root_weights[ root_order[ num_heavy_roots ] ] * PLANNER_MIN_PROBES >= weights_total ) ) {
+		weights_total -= root_weights[ root_order[ num_heavy_roots ] ];
+		num_heavy_roots++;
+	}
+
+	// Search the heavy root tasks in full until their share of the time is up. The heavy root tasks left are probed
+	// along with the other root tasks. The root task of which the search is cut short is not, so that the cliques and
+	// edge checks found before the cut are a lower bound on its own, but the estimates are lower bounds from then on
+	search_deadline = pm.getStartTime() + PLANNER_SEARCH_TIME_SHARE * PLANNER_MAX_TIME;
+	weights_total = std::accumulate( root_weights.begin(), root_weights.end(), 0.0 );
+	double validation_search_checks = 0;
+	double validation_probe_checks = 0;
+
+	auto searchRoot = [&]( long long root_index ) {
+		std::vector<double> cliques;
+		double root_checks = search( root_index, cliques );
+		std::vector<long long> cliques_counts( cliques.size(), 0 );
+
+		for ( unsigned int size = 0; size < cliques.size(); size++ ) {
+			cliques_counts[ size ] = isCliqueSizeInRange( size ) ? (long long) cliques[ size ] : 0;
+		}
+
+		cliques_estimate.addExact( cliques_counts );
+		searched_roots_cliques.addExact( cliques_counts );
+		searched_roots_checks += root_checks;
+		weights_total -= root_weights[ root_index ];
+		root_weights[ root_index ] = 0;
+
+		if ( root_checks > heaviest_root_checks ) {
+			heaviest_root_checks = root_checks;
+			heaviest_root_id = edge_roots ? root_index : roots[ root_index ].first;
+		}
+
+		if ( ! search_cut ) {
+			num_searched_roots++;
+		}
+
+		return root_checks;
+	};
+
+	long long next_root = 0;
+
+	for ( ; next_root < num_heavy_roots && ! search_cut; next_root++ ) {
+		double root_checks = searchRoot( root_order[ next_root ] );
+
+		if ( search_cut ) {
+			break;
+		}
+
+		// Probe the root task as well, to check how well the probes estimate the work of the search trees of this graph
+		for ( int j = 0; j < PLANNER_VALIDATION_PROBES; j++ ) {
+			std::vector<double> validation_cliques;
+			validation_probe_checks += probe( root_order[ next_root ], 1, validation_cliques ) / PLANNER_VALIDATION_PROBES;
+		}
+
+		validation_search_checks += root_checks;
+	}
+
+	// Probes that estimate the searched root tasks far too low will do so for the other root tasks as well
+	lower_bound = search_cut || validation_probe_checks < PLANNER_MIN_VALIDATION_RATIO * validation_search_checks;
+
+	// Probes are of no use then, so the rest of the time goes to searching further root tasks in full, which raises the
+	// lower bounds, and makes the counts exact once all root tasks have been searched
+	if ( lower_bound ) {
+		search_deadline = pm.getStartTime() + PLANNER_MAX_TIME;
+
+		for ( ; next_root < (long long) roots.size() && ! search_cut; next_root++ ) {
+			searchRoot( root_order[ next_root ] );
+		}
+
+		lower_bound = search_cut;
+		probe_time = pm.stop();
+
+		return;
+	}
+
+	// Probe the other root tasks until the estimated number of edge checks is accurate enough, or the time limit is
+	// reached after the minimum number of probes, or probing has performed as many edge checks as the search itself would
+	if ( weights_total > 0 ) {
+		std::discrete_distribution<long long> root_distribution( root_weights.begin(), root_weights.end() );
+		double confidence = 0.95;
+
+		while ( num_probes < PLANNER_MIN_PROBES || pm.getCurrentClockTime() - pm.getStartTime() < PLANNER_MAX_TIME ) {
+			for ( int i = 0; i < SAMPLE_BATCH_SIZE; i++ ) {
+				long long root_index = root_distribution( rng );
+				std::vector<double> cliques;
+				double num_checks = probe( root_index, weights_total / root_weights[ root_index ], cliques );
+
+				for ( unsigned int size = 0; size < cliques.size(); size++ ) {
+					if ( ! isCliqueSizeInRange( size ) ) {
+						cliques[ size ] = 0;
+					}
+				}
+
+				cliques_estimate.addSample( cliques );
+				num_probes++;
+				checks_sum += num_checks;
+				checks_sum_squares += num_checks * num_checks;
+				checks_max = std::max( checks_max, num_checks );
+			}
+
+			if ( num_probes >= PLANNER_MIN_PROBES && ( getNumEdgeChecksHalfWidth( confidence ) <= PLANNER_TARGET_ERROR * getNumEdgeChecks() || num_checks_performed >= getNumEdgeChecks() ) ) {
+				break;
+			}
+		}
+
+		// The confidence interval of heavy-tailed probes is too narrow: the rare probes reaching a deep subtree hold much
+		// of the estimate, while most deep subtrees are never reached
+		if ( checks_max > PLANNER_MAX_PROBE_SHARE * checks_sum || getNumEdgeChecksHalfWidth( confidence ) > getNumEdgeChecks() ) {
+			lower_bound = true;
+		}
+	}
+
+	probe_time = pm.stop();
+}
+
+double WorkPlanner::getNumEdgeChecks() {
+	if ( lower_bound ) {
+		return searched_roots_checks;
+	}
+
+	return searched_roots_checks + ( ( num_probes > 0 ) ? checks_sum / num_probes : 0 );
+}
+
+double WorkPlanner::getNumEdgeChecksHalfWidth( double confidence ) {
+	if ( num_probes < 2 ) {
+		return 0;
+	}
+
+	double variance = std::max( 0.0, ( checks_sum_squares - checks_sum * checks_sum / num_probes ) / ( num_probes - 1 ) );
+
+	return SampleEstimate::getNormalQuantile( confidence ) * sqrt( variance / num_probes );
+}
+
+bool WorkPlanner::isLowerBound() {
+	return lower_bound;
+}
+
+SampleEstimate &WorkPlanner::getCliquesEstimate() {
+	return lower_bound ? searched_roots_cliques : cliques_estimate;
+}
+
+double WorkPlanner::getThroughput() {
+	return ( probe_time > 0 && num_checks_performed > 0 ) ? num_checks_performed / probe_time : 0;
+}
+
+double WorkPlanner::predictTime( int num_workers, bool help_enabled ) {
+	if ( getThroughput() == 0 ) {
+		return graph_load_time;
+	}
+
+	// Every worker reads the graph before the search. With help, the work is divided evenly over the workers
+	double time_search = getNumEdgeChecks() / getThroughput() / num_workers;
+
+	if ( ! help_enabled ) {
+		time_search = std::max( time_search, heaviest_root_checks / getThroughput() );
+	}
+
+	return graph_load_time + time_search;
+}
+
+int WorkPlanner::getNumUsefulWorkers( int max_workers ) {
+	int num_workers = 1;
+
+	while ( num_workers * 2 <= max_workers && predictTime( num_workers, true ) >= PLANNER_MIN_SPEEDUP * predictTime( num_workers * 2, true ) ) {
+		num_workers *= 2;
+	}
+
+	return num_workers;
+}
+
+int WorkPlanner::getRecommendedHelpRequestThreshold() {
+	if ( getThroughput() == 0 ) {
+		return 2;
+	}
+
+	// Same bound as the minimum of the adaptive help request threshold, with the measured time per edge check
+	double threshold = sqrt( 2 * HELP_LATENCY_WORK_RATIO * PLANNER_HELP_LATENCY * getThroughput() );
+
+	return (int) std::min( std::max( round( threshold ), 2.0 ), (double) HELP_MAX_THRESHOLD );
+}
+
+void WorkPlanner::write( double time_budget, int max_workers, bool verbose ) {
+	double confidence = 0.95;
+
+	printf( "Estimated from %lld root tasks searched in full and %lld probes in %.2f seconds (%.0f%% confidence):\n", num_searched_roots, num_probes, probe_time, confidence * 100 );
+
+	// Lower bounds hold the root tasks searched in full only, and have no confidence interval
+	auto printEstimate = [&]( const char *label, double estimate, double half_width ) {
+		if ( lower_bound ) {
+			printf( "%s: at least %.4g\n", label, estimate );
+		}
+		else {
+			printf( "%s: %.4g +- %.2g\n", label, estimate, half_width );
+		}
+	};
+
+	printEstimate( "Edge checks", getNumEdgeChecks(), getNumEdgeChecksHalfWidth( confidence ) );
+
+	SampleEstimate &cliques = getCliquesEstimate();
+
+	if ( verbose ) {
+		for ( int size = 0; size < cliques.getNumSizes(); size++ ) {
+			if ( cliques.getEstimate( size ) > 0 ) {
+				std::string label = "Number of " + std::to_string( size ) + "-cliques";
+				printEstimate( label.c_str(), cliques.getEstimate( size ), cliques.getHalfWidth( size, confidence ) );
+			}
+		}
+	}
+
+	printEstimate( "Total number of cliques", cliques.getEstimate( -1 ), cliques.getHalfWidth( -1, confidence ) );
+
+	if ( lower_bound ) {
+		printf( "The search tree is too irregular for a reliable estimate; counts and times are those of the root tasks searched in full, and so lower bounds\n" );
+	}
+
+	printf( "Throughput: %.4g edge checks per second per worker\n", getThroughput() );
+
+	if ( heaviest_root_id >= 0 ) {
+		printf( "Heaviest root task: %s %lld, %.4g edge checks\n", edge_roots ? "edge" : "node", heaviest_root_id, heaviest_root_checks );
+	}
+
+	printf( "Reading graph: %.2f seconds\n", graph_load_time );
+
+	// Predicted running times for doubling numbers of workers
+	printf( "%8s %16s %10s %16s %10s\n", "workers", "time (help)", "eff.", "time (no help)", "eff." );
+
+	for ( int num_workers = 1; num_workers <= max_workers; num_workers *= 2 ) {
+		double time_help = predictTime( num_workers, true );
+		double time_no_help = predictTime( num_workers, false );
+
+		printf( "%8d %14.4gs %9.0f%% %14.4gs %9.0f%%\n", num_workers, time_help, predictTime( 1, true ) / time_help / num_workers * 100, time_no_help, predictTime( 1, false ) / time_no_help / num_workers * 100 );
+
+		if ( num_workers > max_workers / 2 ) {
+			break;
+		}
+	}
+
+	int num_useful_workers = getNumUsefulWorkers( max_workers );
+	if ( num_useful_workers * 2 <= max_workers ) {
+		printf( "Useful workers: up to %d (doubling further gives less than %.1fx speedup)\n", num_useful_workers, PLANNER_MIN_SPEEDUP );
+	}
+	else {
+		printf( "Useful workers: up to %d (the largest number considered)\n", num_useful_workers );
+	}
+
+	printf( "Recommended help request threshold: %d\n", getRecommendedHelpRequestThreshold() );
+
+	if ( time_budget > 0 ) {
+		if ( predictTime( num_useful_workers, true ) > time_budget ) {
+			printf( "Not feasible within %.4g seconds: %d workers need %s %.4g seconds\n", time_budget, num_useful_workers, lower_bound ? "at least" : "an estimated", predictTime( num_useful_workers, true ) );
+		}
+		else if ( lower_bound ) {
+			printf( "Feasibility within %.4g seconds unknown: %d workers need at least %.4g seconds\n", time_budget, num_useful_workers, predictTime( num_useful_workers, true ) );
+		}
+		else {
+			int num_workers = 1;
+
+			while ( predictTime( num_workers, true ) > time_budget ) {
+				num_workers *= 2;
+			}
+
+			printf( "Feasible within %.4g seconds with %d workers\n", time_budget, num_workers );
+		}
+	}
+}
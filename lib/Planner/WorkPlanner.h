@@ -0,0 +1,299 @@
+#ifndef WORKPLANNER_H
+#define WORKPLANNER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <random>
+
+// Program includes
+#include "../Graph/Graph.h"
+#include "../CliqueFinder/SampleEstimate.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+
+// Planner settings
+// ==========
+// Maximum time (in seconds) spent on probing the search tree
+const double PLANNER_MAX_TIME = 2.0;
+
+// Minimum number of probes, and the relative error of the estimated number of edge checks at which probing stops early
+const int PLANNER_MIN_PROBES = 1000;
+const double PLANNER_TARGET_ERROR = 0.02;
+
+// Minimum number of heaviest root tasks that are searched in full rather than probed, time permitting
+const int PLANNER_NUM_HEAVY_ROOTS = 16;
+
+// Share of PLANNER_MAX_TIME spent on full searches of the heavy root tasks. Once the estimates are known to be lower
+// bounds, the rest of the time goes to full searches of further root tasks as well
+const double PLANNER_SEARCH_TIME_SHARE = 0.5;
+
+// Number of edge checks of a full search between two checks of the clock
+const int PLANNER_CLOCK_CHECK_INTERVAL = 65536;
+
+// Number of probes of every root task searched in full, and the smallest ratio of the edge checks estimated by these
+// probes to the edge checks of the searches at which the probes are trusted to estimate the other root tasks
+const int PLANNER_VALIDATION_PROBES = 64;
+const double PLANNER_MIN_VALIDATION_RATIO = 0.5;
+
+// Largest share of the estimated edge checks of the probed root tasks that a single probe may hold. A probe holding
+// more shows that the probes rarely reach the subtrees holding most of the work, so that the estimates are likely too
+// low
+const double PLANNER_MAX_PROBE_SHARE = 0.05;
+
+// Assumed round-trip latency (in seconds) of a help request between processes on different hosts
+const double PLANNER_HELP_LATENCY = 100e-6;
+
+// Minimum speedup from doubling the number of workers for the additional workers to be considered useful
+const double PLANNER_MIN_SPEEDUP = 1.1;
+
+/**
+ * Planner estimating the work of a clique counting run before committing resources to it. Root tasks are stratified
+ * by weight as for sampling (see CliqueFinder::findAllCliquesSampled()): the heaviest root tasks are searched in full,
+ * and the number of edge checks and cliques of the other root tasks is estimated with Knuth's estimator of the size of
+ * a search tree: every probe follows a single random path from a root task down the search tree, choosing a candidate
+ * node at random at every level, and weights the work and cliques at every level by the inverse of the probability of
+ * reaching it. Root tasks are chosen with a probability proportional to their weight. Probes take time linear in the
+ * candidate set sizes along their path, and full searches are cut short after a fixed time, so that even searches far
+ * too large to run, such as on complete graphs, are estimated within seconds. As single paths rarely reach the deep
+ * subtrees holding most of the work on irregular graphs, the probes are not trusted when a full search was cut short,
+ * probes estimate the searched root tasks far too low, or a single probe dominates the estimate. The planner then
+ * searches as many further root tasks in full as time permits instead, and reports their counts as lower bounds.
+ * Running times follow from the single-core throughput of edge checks measured while probing
+ */
+class WorkPlanner {
+	protected:
+		/**
+		 * Graph to plan the search of
+		 */
+		Graph *graph;
+
+		/**
+		 * Search settings, see CliqueFinder
+		 */
+		bool edge_roots = false;
+		int clique_size_min = 0;
+		int clique_size_max = 0;
+
+		/**
+		 * Time (in seconds) it took to read the graph, which every MPI process spends before the search
+		 */
+		double graph_load_time = 0;
+
+		/**
+		 * Random number generator choosing root tasks and candidate nodes
+		 */
+		std::mt19937_64 rng;
+
+		/**
+		 * Sorted higher-ID neighbours (N+) of every node, the root tasks and their sampling weights
+		 */
+		AdjacencyList forwardlist;
+		std::vector<Edge> roots;
+		std::vector<double> root_weights;
+
+		/**
+		 * Estimate of the number of cliques per clique size
+		 */
+		SampleEstimate cliques_estimate;
+
+		/**
+		 * Number of cliques per clique size of the root tasks searched in full, including the search that was cut short
+		 */
+		SampleEstimate searched_roots_cliques;
+
+		/**
+		 * Number of probes, and the sum, sum of squares and maximum of the estimated number of edge checks per probe
+		 */
+		long long num_probes = 0;
+		double checks_sum = 0;
+		double checks_sum_squares = 0;
+		double checks_max = 0;
+
+		/**
+		 * Number of root tasks searched in full, and the number of edge checks of their searches, including the search
+		 * that was cut short
+		 */
+		long long num_searched_roots = 0;
+		double searched_roots_checks = 0;
+
+		/**
+		 * Whether the estimates are lower bounds rather than unbiased estimates with a reliable confidence interval
+		 */
+		bool lower_bound = false;
+
+		/**
+		 * Clock of the estimation, the clock time at which full searches are cut short, the number of edge checks
+		 * until the clock is checked again, and whether a full search has been cut short
+		 */
+		ProgressMonitor pm;
+		double search_deadline = 0;
+		int search_countdown = 0;
+		bool search_cut = false;
+
+		/**
+		 * Number of edge checks performed while probing, and the time spent on them (in seconds)
+		 */
+		double num_checks_performed = 0;
+		double probe_time = 0;
+
+		/**
+		 * Estimated number of edge checks of the heaviest root task, and its root ID (node ID, or edge index)
+		 */
+		double heaviest_root_checks = 0;
+		long long heaviest_root_id = -1;
+
+		/**
+		 * Follow a random path down the search tree from a root task
+		 *
+		 * @param long long root_index Index of the root task
+		 * @param double weight Inverse of the probability of choosing the root task
+		 * @param std::vector<double>& cliques Output. Estimated number of cliques per clique size
+		 * @return double Estimated number of edge checks
+		 */
+		double probe( long long root_index, double weight, std::vector<double> &cliques );
+
+		/**
+		 * Search the whole search tree of a root task, unless it is cut short at the search deadline
+		 *
+		 * @param long long root_index Index of the root task
+		 * @param std::vector<double>& cliques Output. Number of cliques per clique size
+		 * @return double Number of edge checks
+		 */
+		double search( long long root_index, std::vector<double> &cliques );
+
+		/**
+		 * Search the subtree of a set of candidate nodes, as in CliqueFinder::findCliquesDFS()
+		 *
+		 * @param const std::vector<int>& potential_nodes Candidate nodes
+		 * @param int depth Depth of the candidate nodes
+		 * @param std::vector<double>& cliques Output. Number of cliques per clique size
+		 * @return double Number of edge checks
+		 */
+		double searchCandidates( const std::vector<int> &potential_nodes, int depth, std::vector<double> &cliques );
+
+		/**
+		 * Get the candidate nodes of a root task, counting the edge checks and cliques of an edge root
+		 *
+		 * @param long long root_index Index of the root task
+		 * @param double weight Inverse of the probability of choosing the root task
+		 * @param std::vector<int>& potential_nodes Output. Candidate nodes
+		 * @param std::vector<double>& cliques Output. Estimated number of cliques per clique size
+		 * @param double& num_checks Output. Estimated number of edge checks
+		 * @return int Depth of the candidate nodes
+		 */
+		int getRootCandidates( long long root_index, double weight, std::vector<int> &potential_nodes, std::vector<double> &cliques, double &num_checks );
+
+		/**
+		 * Check whether a clique size lies within the range of clique sizes to count
+		 *
+		 * @param int size Clique size
+		 * @return bool Whether cliques of this size are counted
+		 */
+		bool isCliqueSizeInRange( int size );
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param Graph* graph Graph to plan the search of, which is only read
+		 */
+		WorkPlanner( Graph *graph ) : graph(graph) {}
+
+		/**
+		 * @see CliqueFinder::setEdgeRoots()
+		 */
+		void setEdgeRoots( bool enable );
+
+		/**
+		 * @see CliqueFinder::setCliqueSizeRange()
+		 */
+		void setCliqueSizeRange( int size_min, int size_max );
+
+		/**
+		 * Set the time it took to read the graph, which is added to the predicted running times
+		 *
+		 * @param double seconds Graph load time in seconds
+		 */
+		void setGraphLoadTime( double seconds );
+
+		/**
+		 * Estimate the work of the search by searching the heaviest root tasks and probing the search trees of the others,
+		 * in about PLANNER_MAX_TIME seconds, or longer if PLANNER_MIN_PROBES probes take longer
+		 *
+		 * @param unsigned int seed Seed of the random number generator
+		 */
+		void estimate( unsigned int seed );
+
+		/**
+		 * Get the estimated number of edge checks of the search, and the half-width of its confidence interval. If the
+		 * estimates are lower bounds, the edge checks of the root tasks searched in full
+		 *
+		 * @param double confidence Confidence level, e.g. 0.95
+		 * @return double Number of edge checks
+		 */
+		double getNumEdgeChecks();
+		double getNumEdgeChecksHalfWidth( double confidence );
+
+		/**
+		 * Check whether the estimates are lower bounds, as their confidence intervals are not reliable
+		 *
+		 * @return bool Whether the estimates are lower bounds
+		 */
+		bool isLowerBound();
+
+		/**
+		 * Get the estimate of the number of cliques per clique size. If the estimates are lower bounds, the number of
+		 * cliques of the root tasks searched in full
+		 *
+		 * @return SampleEstimate& Clique counts estimate
+		 */
+		SampleEstimate &getCliquesEstimate();
+
+		/**
+		 * Get the measured single-core throughput
+		 *
+		 * @return double Edge checks per second
+		 */
+		double getThroughput();
+
+		/**
+		 * Predict the running time of the search, including reading the graph
+		 *
+		 * @param int num_workers Number of workers (processes times threads)
+		 * @param bool help_enabled Whether dynamic load balancing is enabled. Without it, no worker finishes before the
+		 * heaviest root task is done
+		 * @return double Running time in seconds
+		 */
+		double predictTime( int num_workers, bool help_enabled );
+
+		/**
+		 * Get the largest number of workers, as a power of two, for which doubling the number of workers still gave a
+		 * speedup of at least PLANNER_MIN_SPEEDUP
+		 *
+		 * @param int max_workers Largest number of workers to consider
+		 * @return int Number of workers
+		 */
+		int getNumUsefulWorkers( int max_workers );
+
+		/**
+		 * Get the recommended help request threshold, at which the work of a remaining subtree takes several help request
+		 * round-trips, given the measured time per edge check and PLANNER_HELP_LATENCY
+		 *
+		 * @return int Help request threshold
+		 */
+		int getRecommendedHelpRequestThreshold();
+
+		/**
+		 * Report the estimates, the predicted running times for worker counts from 1 to max_workers, the recommended help
+		 * request threshold, and whether the search is feasible within the time budget. If the estimates are lower bounds,
+		 * the search is only reported infeasible, never feasible
+		 *
+		 * @param double time_budget Time budget in seconds, or 0 for none
+		 * @param int max_workers Largest number of workers to consider
+		 * @param bool verbose Whether to report the estimated number of cliques per clique size
+		 */
+		void write( double time_budget, int max_workers, bool verbose );
+};
+
+#endif
@@ -0,0 +1,75 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <stdlib.h>
+
+// Program includes
+#include "HelpMatcher.h"
+
+HelpMatcher::HelpMatcher( std::vector<int> process_ids, int policy ) : process_ids(process_ids), policy(policy) {
+	std::sort( this->process_ids.begin(), this->process_ids.end() );
+
+	for ( int process_id : this->process_ids ) {
+		processes_status[ process_id ] = PROCESS_RUNNING;
+	}
+
+	num_processes_active = this->process_ids.size();
+}
+
+void HelpMatcher::markIdle( int process_id ) {
+	processes_status[ process_id ] = PROCESS_IDLE;
+	num_processes_active--;
+}
+
+int HelpMatcher::claimHelper( int requester_id ) {
+	if ( num_processes_active == (int) process_ids.size() ) {
+		return -1;
+	}
+
+	int num_candidates = process_ids.size();
+	int helper_index = -1;
+
+	if ( policy == HELP_MATCH_NEAREST ) {
+		// The idle process with the ID closest to that of the requesting process, as processes with nearby IDs usually
+		// share a node or socket
+		for ( int i = 0; i < num_candidates; i++ ) {
+			if ( processes_status[ process_ids[ i ] ] == PROCESS_IDLE && ( helper_index == -1 || abs( process_ids[ i ] - requester_id ) < abs( process_ids[ helper_index ] - requester_id ) ) ) {
+				helper_index = i;
+			}
+		}
+	}
+	else {
+		// The first idle process, searching from the lowest ID or, with round-robin, from after the previous helper
+		int start_index = ( policy == HELP_MATCH_ROUND_ROBIN ) ? next_index : 0;
+
+		for ( int i = 0; i < num_candidates; i++ ) {
+			int index = ( start_index + i ) % num_candidates;
+
+			if ( processes_status[ process_ids[ index ] ] == PROCESS_IDLE ) {
+				helper_index = index;
+				break;
+			}
+		}
+	}
+
+	if ( helper_index == -1 ) {
+		return -1;
+	}
+
+	next_index = helper_index + 1;
+	processes_status[ process_ids[ helper_index ] ] = PROCESS_HELPING;
+	num_processes_active++;
+
+	return process_ids[ helper_index ];
+}
+
+int HelpMatcher::getNumProcessesActive() {
+	return num_processes_active;
+}
+
+const std::map<int, int> &HelpMatcher::getProcessesStatus() {
+	return processes_status;
+}
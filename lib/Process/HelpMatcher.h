@@ -0,0 +1,88 @@
+#ifndef HELPMATCHER_H
+#define HELPMATCHER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <map>
+
+// Program includes
+#include "const.h"
+
+/**
+ * Matching of processes requesting help with idle processes, as done by the master process and the host brokers. Only
+ * keeps track of the status of the processes, and does not communicate itself, so that the same protocol can be run by
+ * the load balancing simulator
+ */
+class HelpMatcher {
+	private:
+		/**
+		 * IDs of the processes taking part in the computation that are matched by this matcher, in increasing order
+		 */
+		std::vector<int> process_ids;
+
+		/**
+		 * The status of each process, either PROCESS_IDLE, PROCESS_RUNNING or PROCESS_HELPING
+		 * PROCESS_IDLE: Process has completed its assigned part of the task, and is waiting for help requests
+		 * PROCESS_RUNNING: Process is performing its originally assigned part of the task
+		 * PROCESS_HELPING: Process is assisting another process with its assigned task
+		 * Format: [process_id] => [status]
+		 */
+		std::map<int, int> processes_status;
+
+		/**
+		 * Number of processes that are currently active (i.e. either running or helping)
+		 */
+		int num_processes_active;
+
+		/**
+		 * Policy for choosing among idle processes, see HELP_MATCH_* in const.h
+		 */
+		int policy;
+
+		/**
+		 * Index (in process_ids) at which the search for an idle process starts with HELP_MATCH_ROUND_ROBIN
+		 */
+		unsigned int next_index = 0;
+
+	public:
+		/**
+		 * Constructor. All processes start out running
+		 *
+		 * @param std::vector<int> process_ids IDs of the processes to match
+		 * @param int policy Optional. Policy for choosing among idle processes, see HELP_MATCH_* in const.h
+		 */
+		HelpMatcher( std::vector<int> process_ids, int policy = HELP_MATCH_FIRST );
+
+		/**
+		 * Mark a process as idle, after it has completed its subtask
+		 *
+		 * @param int process_id ID of the process
+		 */
+		void markIdle( int process_id );
+
+		/**
+		 * Find an idle process to help the requesting process, and mark it as helping
+		 *
+		 * @param int requester_id ID of the process requesting help
+		 * @return int ID of the helping process, or -1 if no process is idle
+		 */
+		int claimHelper( int requester_id );
+
+		/**
+		 * Get the number of processes that are currently active (i.e. either running or helping)
+		 *
+		 * @return int Number of active processes
+		 */
+		int getNumProcessesActive();
+
+		/**
+		 * Get the status of each process
+		 *
+		 * @return std::map<int, int> Status per process ID
+		 */
+		const std::map<int, int> &getProcessesStatus();
+};
+
+#endif
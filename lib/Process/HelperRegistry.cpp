@@ -0,0 +1,98 @@
+// Includes
+// ==========
+// STL includes
+
+// Program includes
+#include "HelperRegistry.h"
+#include "const.h"
+
+HelperRegistry::HelperRegistry( int process_id, int num_processes, int first_worker_id ) : process_id(process_id), num_processes(num_processes) {
+	// Only the master process exposes the registry
+	int win_size = ( process_id == 0 ) ? num_processes + 1 : 0;
+	MPI_Win_allocate( win_size * sizeof( int ), sizeof( int ), MPI_INFO_NULL, MPI_COMM_WORLD, &win_memory, &win );
+
+	if ( process_id == 0 ) {
+		// All processes taking part in the computation start out running. The master process remains marked as
+		// running if it does not take part, so it can never be claimed for helping
+		win_memory[0] = num_processes - first_worker_id;
+
+		for ( int i = 0; i < num_processes; i++ ) {
+			win_memory[ 1 + i ] = PROCESS_RUNNING;
+		}
+	}
+
+	// Ensure the registry is initialized before any process accesses it
+	MPI_Barrier( MPI_COMM_WORLD );
+	MPI_Win_lock_all( 0, win );
+
+	processes_status.resize( num_processes );
+}
+
+HelperRegistry::~HelperRegistry() {
+	MPI_Win_unlock_all( win );
+	MPI_Win_free( &win );
+}
+
+int HelperRegistry::claimHelper( int requester_id ) {
+	// Atomically fetch the status of all processes
+	MPI_Get_accumulate( NULL, 0, MPI_INT, &processes_status[0], num_processes, MPI_INT, 0, 1, num_processes, MPI_INT, MPI_NO_OP, win );
+	MPI_Win_flush( 0, win );
+
+	// Whether the claimed process has been registered as active
+	bool reserved = false;
+
+	// Start looking for idle processes after the requesting process, so that helpers are spread over the processes
+	for ( int offset = 1; offset < num_processes; offset++ ) {
+		int i = ( requester_id + offset ) % num_processes;
+
+		if ( processes_status[ i ] != PROCESS_IDLE ) {
+			continue;
+		}
+
+		// Register the process that will be claimed as active before claiming it. As the requesting process is itself
+		// active, the number of active processes can not reach zero while a process is being claimed
+		if ( ! reserved ) {
+			int increment = 1;
+			int num_active;
+			MPI_Fetch_and_op( &increment, &num_active, MPI_INT, 0, 0, MPI_SUM, win );
+			reserved = true;
+		}
+
+		// Claim the process, unless another process claimed it first
+		int status_idle = PROCESS_IDLE;
+		int status_helping = PROCESS_HELPING;
+		int status_previous;
+		MPI_Compare_and_swap( &status_helping, &status_idle, &status_previous, MPI_INT, 0, 1 + i, win );
+		MPI_Win_flush( 0, win );
+
+		if ( status_previous == PROCESS_IDLE ) {
+			return i;
+		}
+	}
+
+	// Undo the registration if no process could be claimed
+	if ( reserved ) {
+		int decrement = -1;
+		int num_active;
+		MPI_Fetch_and_op( &decrement, &num_active, MPI_INT, 0, 0, MPI_SUM, win );
+		MPI_Win_flush( 0, win );
+	}
+
+	return -1;
+}
+
+bool HelperRegistry::markIdle( int idle_process_id ) {
+	// Make the process available for helping
+	int status_idle = PROCESS_IDLE;
+	int status_previous;
+	MPI_Fetch_and_op( &status_idle, &status_previous, MPI_INT, 0, 1 + idle_process_id, MPI_REPLACE, win );
+	MPI_Win_flush( 0, win );
+
+	// Unregister the process as active
+	int decrement = -1;
+	int num_active;
+	MPI_Fetch_and_op( &decrement, &num_active, MPI_INT, 0, 0, MPI_SUM, win );
+	MPI_Win_flush( 0, win );
+
+	return num_active == 1;
+}
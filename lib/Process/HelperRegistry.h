@@ -0,0 +1,71 @@
+#ifndef HELPERREGISTRY_H
+#define HELPERREGISTRY_H
+
+// Includes
+// ==========
+// MPI includes
+#include <mpi.h>
+
+// STL includes
+#include <vector>
+
+class HelperRegistry {
+	private:
+		/**
+		 * MPI window exposing the registry, which is located at the master process
+		 * Format: [0] => [number of active processes], [1 + process_id] => [process status]
+		 */
+		MPI_Win win;
+
+		/**
+		 * Local memory of the window. Only the master process exposes any memory
+		 */
+		int *win_memory;
+
+		/**
+		 * MPI ID of the process and number of processes in use
+		 */
+		int process_id;
+		int num_processes;
+
+		/**
+		 * Buffer for the status of each process, as last fetched from the registry
+		 */
+		std::vector<int> processes_status;
+
+	public:
+		/**
+		 * Constructor. Collectively creates the registry window, with the status of all processes taking part in the
+		 * computation set to PROCESS_RUNNING. Should be called by all processes.
+		 *
+		 * @param int process_id MPI ID of the process
+		 * @param int num_processes Number of processes in use
+		 * @param int first_worker_id ID of the first process taking part in the computation
+		 */
+		HelperRegistry( int process_id, int num_processes, int first_worker_id );
+
+		/**
+		 * Destructor. Collectively frees the registry window. Should be called by all processes.
+		 */
+		~HelperRegistry();
+
+		/**
+		 * Claim an idle process for helping the requesting process. The status of the claimed process is atomically
+		 * changed from PROCESS_IDLE to PROCESS_HELPING, so each idle process can only be claimed by a single requester.
+		 * If no process is idle, this takes a single atomic operation on the registry.
+		 *
+		 * @param int requester_id MPI ID of the process requesting help
+		 * @return int MPI ID of the claimed process, or -1 if no process is available
+		 */
+		int claimHelper( int requester_id );
+
+		/**
+		 * Mark a process as idle after it has completed its assigned subtask or the subtask it was helping with.
+		 *
+		 * @param int idle_process_id MPI ID of the process that became idle
+		 * @return bool Whether this was the last active process, i.e. whether all processing is completed
+		 */
+		bool markIdle( int idle_process_id );
+};
+
+#endif
@@ -0,0 +1,92 @@
+// Includes
+// ==========
+// STL includes
+
+// Program includes
+#include "HostBroker.h"
+#include "Process.h"
+#include "const.h"
+#include "../Trace/Trace.h"
+
+HostBroker::HostBroker( int process_id, std::vector<int> local_process_ids, MPI_Comm comm_broker, MPI_Comm comm_master, int help_match_policy ) : process_id(process_id), comm_broker(comm_broker), comm_master(comm_master), local_process_ids(local_process_ids), help_matcher(local_process_ids, help_match_policy) {
+	// A host without processes taking part in the computation can never help, and is regarded idle from the start
+	idle_reported = ( local_process_ids.size() == 0 );
+}
+
+void HostBroker::run() {
+	Trace::setThreadName( "host broker" );
+
+	while ( ! terminated ) {
+		MPI_Status probe_status;
+		Process::waitForMessage( &comm_broker, 1, &probe_status );
+		handleMessage( &probe_status );
+	}
+}
+
+void HostBroker::handleMessage( MPI_Status *status ) {
+	int buff;
+	MPI_Recv( &buff, 1, MPI_INT, status->MPI_SOURCE, status->MPI_TAG, comm_broker, MPI_STATUS_IGNORE );
+
+	if ( status->MPI_TAG == MPI_TAG_GRAPH_PROCESSING_DONE ) {
+		// A local process has completed its subtask
+		help_matcher.markIdle( status->MPI_SOURCE );
+	}
+	else if ( status->MPI_TAG == MPI_TAG_GRAPH_REQUEST_HELP ) {
+		TraceScope trace_scope( "match help request", status->MPI_SOURCE );
+
+		// A local process requests help. Help across hosts is only requested from the master process if there are hosts
+		// on which all processes are idle
+		if ( ! grantLocalHelper( status->MPI_SOURCE ) ) {
+			if ( idle_hosts_available ) {
+				MPI_Send( &status->MPI_SOURCE, 1, MPI_INT, 0, MPI_TAG_REQUEST_REMOTE_HELP, comm_master );
+			}
+			else {
+				int response_buff = -1;
+				MPI_Send( &response_buff, 1, MPI_INT, status->MPI_SOURCE, MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE, MPI_COMM_WORLD );
+			}
+		}
+	}
+	else if ( status->MPI_TAG == MPI_TAG_CLAIM_HOST_HELPER ) {
+		// The master process has assigned this (idle) host to help a process on another host. The master process
+		// no longer regards this host idle
+		idle_reported = false;
+
+		if ( ! grantLocalHelper( buff ) ) {
+			int response_buff = -1;
+			MPI_Send( &response_buff, 1, MPI_INT, buff, MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE, MPI_COMM_WORLD );
+		}
+	}
+	else if ( status->MPI_TAG == MPI_TAG_IDLE_HOSTS_AVAILABLE ) {
+		idle_hosts_available = buff;
+	}
+	else if ( status->MPI_TAG == MPI_TAG_ALL_PROCESSING_COMPLETED ) {
+		terminated = true;
+		return;
+	}
+
+	reportIdle();
+}
+
+bool HostBroker::isTerminated() {
+	return terminated;
+}
+
+bool HostBroker::grantLocalHelper( int requester_id ) {
+	int local_process_id = help_matcher.claimHelper( requester_id );
+
+	if ( local_process_id < 0 ) {
+		return false;
+	}
+
+	MPI_Send( &local_process_id, 1, MPI_INT, requester_id, MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE, MPI_COMM_WORLD );
+
+	return true;
+}
+
+void HostBroker::reportIdle() {
+	if ( help_matcher.getNumProcessesActive() == 0 && ! idle_reported ) {
+		int buff = 0;
+		MPI_Send( &buff, 1, MPI_INT, 0, MPI_TAG_HOST_IDLE, comm_master );
+		idle_reported = true;
+	}
+}
@@ -0,0 +1,104 @@
+#ifndef HOSTBROKER_H
+#define HOSTBROKER_H
+
+// Includes
+// ==========
+// MPI includes
+#include <mpi.h>
+
+// STL includes
+#include <vector>
+#include <map>
+
+// Program includes
+#include "HelpMatcher.h"
+
+class HostBroker {
+	private:
+		/**
+		 * MPI ID of the process acting as broker for its host
+		 */
+		int process_id;
+
+		/**
+		 * Communicators for messages addressed to host brokers and to the master process, respectively
+		 */
+		MPI_Comm comm_broker;
+		MPI_Comm comm_master;
+
+		/**
+		 * MPI IDs of the processes on this host taking part in the computation
+		 */
+		std::vector<int> local_process_ids;
+
+		/**
+		 * Status of the processes on this host, for matching help requests with idle local processes
+		 */
+		HelpMatcher help_matcher;
+
+		/**
+		 * Whether the master process has been told that all processes on this host are idle, and thus that the host
+		 * can help processes on other hosts
+		 */
+		bool idle_reported;
+
+		/**
+		 * Whether, according to the master process, there are hosts on which all processes are idle
+		 */
+		bool idle_hosts_available = false;
+
+		/**
+		 * Whether the master process has signalled that all processing is completed
+		 */
+		bool terminated = false;
+
+	public:
+		/**
+		 * Constructor. All local processes taking part in the computation start out running.
+		 *
+		 * @param int process_id MPI ID of the broker process
+		 * @param vector<int> local_process_ids MPI IDs of the processes on this host taking part in the computation
+		 * @param MPI_Comm comm_broker Communicator for messages addressed to host brokers
+		 * @param MPI_Comm comm_master Communicator for messages addressed to the master process
+		 * @param int help_match_policy Policy for choosing among idle local processes, see HELP_MATCH_* in const.h
+		 */
+		HostBroker( int process_id, std::vector<int> local_process_ids, MPI_Comm comm_broker, MPI_Comm comm_master, int help_match_policy );
+
+		/**
+		 * Handle messages addressed to this broker until the master process signals that all processing is completed.
+		 * Used on hosts other than the host of the master process, which handles broker messages itself.
+		 */
+		void run();
+
+		/**
+		 * Receive and handle a single message addressed to this broker. Help requests from local processes are granted
+		 * with an idle local process if there is one. Otherwise, they are forwarded to the master process if there are
+		 * hosts on which all processes are idle, and rejected if there are not.
+		 *
+		 * @param MPI_Status *status Status of the probed message
+		 */
+		void handleMessage( MPI_Status *status );
+
+		/**
+		 * Check whether the master process has signalled that all processing is completed
+		 *
+		 * @return bool Whether all processing is completed
+		 */
+		bool isTerminated();
+
+		/**
+		 * Claim an idle local process for helping a process, and tell the requesting process which process will help.
+		 *
+		 * @param int requester_id MPI ID of the process requesting help
+		 * @return bool Whether an idle local process was available
+		 */
+		bool grantLocalHelper( int requester_id );
+
+		/**
+		 * Report to the master process that all processes on this host are idle, if this has become the case since the
+		 * last report
+		 */
+		void reportIdle();
+};
+
+#endif
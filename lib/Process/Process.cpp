@@ -1,9 +1,13 @@
 // Includes
 // ==========
 // STL includes
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 // Program includes
 #include "Process.h"
+#include "../Trace/Trace.h"
 
 bool Process::isMaster() {
 	return false;
@@ -13,6 +17,196 @@ void Process::initMPI() {
 	// Get MPI process processor name and store it
 	int process_processor_name_length;
 	MPI_Get_processor_name( process_processor_name, &process_processor_name_length );
+
+	// Prepare the checkpoint directory before any worker process starts, as resuming replaces its contents
+	if ( process_id == 0 && checkpoint_dir != "" ) {
+		checkpoint_generation = Checkpointer::prepare( checkpoint_dir, checkpoint_resume );
+	}
+
+	// Use the master process's settings on whether it takes part in the computation, on the node order and on collapsing
+	// twins, as they determine how the graph is partitioned over the processes, and on the load balancing mechanism
+	int settings_buff[10] = { master_computes, load_balancer, host_size, trace_output_fname != "", help_match_policy, root_costs_output_fname != "", node_counts_output_fname != "", checkpoint_generation, node_order, twin_compression };
+	MPI_Bcast( settings_buff, 10, MPI_INT, 0, MPI_COMM_WORLD );
+	master_computes = settings_buff[0];
+	load_balancer = settings_buff[1];
+	host_size = settings_buff[2];
+	help_match_policy = settings_buff[4];
+	record_root_costs = settings_buff[5];
+	record_node_counts = settings_buff[6];
+	checkpoint_generation = settings_buff[7];
+	node_order = settings_buff[8];
+	twin_compression = settings_buff[9];
+
+	// Record a trace on all processes if the master process writes one, with a common time zero for all processes
+	if ( settings_buff[3] ) {
+		Trace::enable();
+		Trace::setThreadName( "main" );
+		MPI_Barrier( MPI_COMM_WORLD );
+		Trace::resetEpoch();
+	}
+
+	// Separate communicator for messages addressed to the master process
+	MPI_Comm_dup( MPI_COMM_WORLD, &comm_master );
+
+	// Registry of idle processes for matching help requests without the master process
+	if ( load_balancer == LOAD_BALANCER_RMA ) {
+		helper_registry = new HelperRegistry( process_id, num_processes, getFirstWorkerId() );
+	}
+
+	// Share the root cost profile read by the master process with all processes
+	if ( process_id == 0 && root_profile_fname != "" ) {
+		RootProfile::readFile( root_profile_fname, root_profile_contents );
+	}
+
+	int root_profile_length = root_profile_contents.size();
+	MPI_Bcast( &root_profile_length, 1, MPI_INT, 0, MPI_COMM_WORLD );
+	root_profile_contents.resize( root_profile_length );
+
+	if ( root_profile_length > 0 ) {
+		MPI_Bcast( &root_profile_contents[0], root_profile_length, MPI_CHAR, 0, MPI_COMM_WORLD );
+	}
+
+	// Registry of the progress records of the worker processes, read by the master process while they search
+	MPI_Bcast( &progress_interval, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD );
+
+	if ( progress_interval > 0 ) {
+		progress_registry = new ProgressRegistry( process_id, num_processes - getFirstWorkerId() );
+	}
+
+	// Group processes per host, with the lowest process ID on each host acting as broker for the host
+	if ( load_balancer == LOAD_BALANCER_HOST ) {
+		MPI_Comm_dup( MPI_COMM_WORLD, &comm_broker );
+
+		MPI_Comm comm_host;
+
+		if ( host_size > 0 ) {
+			MPI_Comm_split( MPI_COMM_WORLD, process_id / host_size, process_id, &comm_host );
+		}
+		else {
+			MPI_Comm_split_type( MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, process_id, MPI_INFO_NULL, &comm_host );
+		}
+
+		int broker_process_id;
+		MPI_Allreduce( &process_id, &broker_process_id, 1, MPI_INT, MPI_MIN, comm_host );
+		MPI_Comm_free( &comm_host );
+
+		broker_process_ids.resize( num_processes );
+		MPI_Allgather( &broker_process_id, 1, MPI_INT, &broker_process_ids[0], 1, MPI_INT, MPI_COMM_WORLD );
+	}
+}
+
+void Process::finalizeMPI() {
+	delete helper_registry;
+	helper_registry = NULL;
+
+	delete progress_registry;
+	progress_registry = NULL;
+
+	delete host_broker;
+	host_broker = NULL;
+
+	if ( load_balancer == LOAD_BALANCER_HOST ) {
+		MPI_Comm_free( &comm_broker );
+	}
+
+	MPI_Comm_free( &comm_master );
+}
+
+void Process::writeTrace() {
+	if ( ! Trace::isEnabled() ) {
+		return;
+	}
+
+	std::string events = Trace::exportEvents( process_id );
+
+	// Gather the lengths of the exported events, followed by the events themselves
+	int num_chars = events.size();
+	std::vector<int> nums_chars( num_processes );
+	MPI_Gather( &num_chars, 1, MPI_INT, &nums_chars[0], 1, MPI_INT, 0, MPI_COMM_WORLD );
+
+	std::vector<int> displacements( num_processes, 0 );
+
+	for ( int i = 1; i < num_processes; i++ ) {
+		displacements[ i ] = displacements[ i - 1 ] + nums_chars[ i - 1 ];
+	}
+
+	std::vector<char> all_events( displacements.back() + nums_chars.back() + 1 );
+	MPI_Gatherv( events.data(), num_chars, MPI_CHAR, &all_events[0], &nums_chars[0], &displacements[0], MPI_CHAR, 0, MPI_COMM_WORLD );
+
+	long long num_dropped = Trace::getNumDroppedEvents();
+	long long num_dropped_total = 0;
+	MPI_Reduce( &num_dropped, &num_dropped_total, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+
+	if ( process_id != 0 ) {
+		return;
+	}
+
+	// Write a single trace file with the events of all processes
+	std::vector<std::string> process_events;
+
+	for ( int i = 0; i < num_processes; i++ ) {
+		process_events.push_back( std::string( &all_events[ displacements[ i ] ], nums_chars[ i ] ) );
+	}
+
+	Trace::writeFile( trace_output_fname, process_events );
+
+	if ( verbose ) {
+		printf( "Trace written to \"%s\" (%lld events dropped).\n", trace_output_fname.c_str(), num_dropped_total );
+	}
+}
+
+int Process::waitForMessage( const MPI_Comm *comms, int num_comms, MPI_Status *status ) {
+	int probe_flag = 0;
+	int sleep_time = 1;
+
+	while ( true ) {
+		for ( int i = 0; i < num_comms; i++ ) {
+			MPI_Iprobe( MPI_ANY_SOURCE, MPI_ANY_TAG, comms[ i ], &probe_flag, status );
+
+			if ( probe_flag ) {
+				return i;
+			}
+		}
+
+		std::this_thread::sleep_for( std::chrono::microseconds( sleep_time ) );
+		sleep_time = std::min( sleep_time * 2, COORDINATOR_MAX_SLEEP_TIME );
+	}
+}
+
+int Process::getCoordinatorId() {
+	if ( load_balancer == LOAD_BALANCER_HOST ) {
+		return broker_process_ids[ process_id ];
+	}
+
+	return 0;
+}
+
+MPI_Comm Process::getCoordinatorComm() {
+	if ( load_balancer == LOAD_BALANCER_HOST ) {
+		return comm_broker;
+	}
+
+	return comm_master;
+}
+
+int Process::getFirstWorkerId() {
+	return master_computes ? 0 : 1;
+}
+
+void Process::setMasterComputes( bool computes ) {
+	master_computes = computes;
+}
+
+void Process::setLoadBalancer( int balancer ) {
+	load_balancer = balancer;
+}
+
+void Process::setHelpMatchPolicy( int policy ) {
+	help_match_policy = policy;
+}
+
+void Process::setHostSize( int size ) {
+	host_size = size;
 }
 
 void Process::setVerbose( bool v ) {
@@ -27,6 +221,69 @@ void Process::setHelpRequestThreshold( int threshold ) {
 	help_request_threshold = threshold;
 }
 
+void Process::setHelpRequestThresholdAdaptive( bool enabled ) {
+	help_threshold_adaptive = enabled;
+}
+
+void Process::setEnableEdgeRoots( bool enabled ) {
+	edge_roots = enabled;
+}
+
+void Process::setNodeOrder( int order ) {
+	node_order = order;
+}
+
+void Process::setTwinCompression( bool enabled ) {
+	twin_compression = enabled;
+}
+
+void Process::setCliqueSizeRange( int size_min, int size_max ) {
+	clique_size_min = size_min;
+	clique_size_max = size_max;
+}
+
+void Process::setCliqueOutput( std::string prefix, int format ) {
+	clique_output_prefix = prefix;
+	clique_output_format = format;
+}
+
+void Process::setSampling( double target_error, double confidence, unsigned int seed ) {
+	sample_target_error = target_error;
+	sample_confidence = confidence;
+	sample_seed = seed;
+}
+
+void Process::setCheckpointing( std::string dir, double interval, bool resume ) {
+	checkpoint_dir = dir;
+	checkpoint_interval = interval;
+	checkpoint_resume = resume;
+}
+
+void Process::setDeadline( double seconds ) {
+	deadline = seconds;
+}
+
+void Process::setProgressInterval( double seconds ) {
+	progress_interval = seconds;
+}
+
+void Process::setRootProfileFileName( std::string fname ) {
+	root_profile_fname = fname;
+}
+
 void Process::setResultsOutputFileName( std::string output_fname ) {
 	results_output_fname = output_fname;
+}
+
+void Process::setTraceOutputFileName( std::string output_fname ) {
+	trace_output_fname = output_fname;
+}
+
+void Process::setRootCostsOutputFileName( std::string output_fname ) {
+	root_costs_output_fname = output_fname;
+}
+
+void Process::setNodeCountsOutput( std::string output_fname, int format ) {
+	node_counts_output_fname = output_fname;
+	node_counts_output_format = format;
 }
\ No newline at end of file
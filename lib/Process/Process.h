@@ -6,8 +6,22 @@
 // MPI includes
 #include <mpi.h>
 
+// STL includes
+#include <string>
+#include <vector>
+
 // Program includes
 #include "../ProgressMonitor/ProgressMonitor.h"
+#include "HelperRegistry.h"
+#include "ProgressRegistry.h"
+#include "HostBroker.h"
+#include "../CliqueFinder/CliqueWriter.h"
+#include "../Checkpoint/Checkpointer.h"
+#include "../Planner/RootProfile.h"
+#include "../Graph/NodeOrder.h"
+#include "../Graph/TwinCompression.h"
+#include "../Results/ResultsReport.h"
+#include "const.h"
 
 class Process {
 	protected:
@@ -26,6 +40,65 @@ class Process {
 		 */
 		char process_processor_name[MPI_MAX_PROCESSOR_NAME];
 
+		/**
+		 * Communicator for messages addressed to the master process in its role of coordinator (subtask completion, help
+		 * requests and results). Messages addressed to a process in its role of worker use MPI_COMM_WORLD, so that the
+		 * coordinator and the computation on the master process never receive each other's messages
+		 */
+		MPI_Comm comm_master;
+
+		/**
+		 * Whether the master process takes part in the computation, running its coordinator duties on a separate thread
+		 */
+		bool master_computes = false;
+
+		/**
+		 * Mechanism for matching processes requesting help with idle processes, either LOAD_BALANCER_MASTER (through the
+		 * master process), LOAD_BALANCER_RMA (through the helper registry) or LOAD_BALANCER_HOST (through a broker per
+		 * host, and through the master process across hosts). The setting of the master process is used by all processes
+		 */
+		int load_balancer = LOAD_BALANCER_MASTER;
+
+		/**
+		 * Policy for choosing an idle process to help a process requesting help, see HELP_MATCH_* in const.h. The setting
+		 * of the master process is used by all processes
+		 */
+		int help_match_policy = HELP_MATCH_FIRST;
+
+		/**
+		 * Registry of idle processes in one-sided MPI memory, used if the load balancer is LOAD_BALANCER_RMA
+		 */
+		HelperRegistry *helper_registry = NULL;
+
+		/**
+		 * Registry of the progress records of the worker processes in one-sided MPI memory, used if progress reporting is
+		 * enabled
+		 */
+		ProgressRegistry *progress_registry = NULL;
+
+		/**
+		 * Communicator for messages addressed to a process in its role of host broker, used if the load balancer is
+		 * LOAD_BALANCER_HOST
+		 */
+		MPI_Comm comm_broker;
+
+		/**
+		 * MPI ID of the host broker of each process, i.e. the process with the lowest ID on the same host
+		 * Format: [process_id] => [broker_process_id]
+		 */
+		std::vector<int> broker_process_ids;
+
+		/**
+		 * Number of consecutive processes to group as a host. If 0, processes are grouped by the shared-memory node they
+		 * run on
+		 */
+		int host_size = 0;
+
+		/**
+		 * Broker for the host of this process, if this process is the host broker
+		 */
+		HostBroker *host_broker = NULL;
+
 		/**
 		 * File name of the graph data file
 		 */
@@ -46,11 +119,114 @@ class Process {
 		 */
 		int help_request_threshold;
 
+		/**
+		 * Whether the help request threshold is adjusted at runtime
+		 */
+		bool help_threshold_adaptive = false;
+
+		/**
+		 * Whether oriented edges instead of single nodes are used as root tasks of the search
+		 */
+		bool edge_roots = false;
+
+		/**
+		 * Order in which the nodes are renumbered after reading the graph, see NODE_ORDER_* in NodeOrder.h
+		 */
+		int node_order = NODE_ORDER_NONE;
+
+		/**
+		 * Whether classes of twins are collapsed into single nodes after reading the graph, see TwinCompression
+		 */
+		bool twin_compression = false;
+
+		/**
+		 * Smallest and largest clique size to count, or 0 for no limit
+		 */
+		int clique_size_min = 0;
+		int clique_size_max = 0;
+
+		/**
+		 * Prefix of the files to which each worker process lists the cliques it finds, or empty if cliques are only
+		 * counted, and the format of these files
+		 */
+		std::string clique_output_prefix = "";
+		int clique_output_format = CLIQUE_OUTPUT_BINARY;
+
+		/**
+		 * Sampling settings, see CliqueFinder::setSampling()
+		 */
+		double sample_target_error = 0;
+		double sample_confidence = 0.95;
+		unsigned int sample_seed = 0;
+
+		/**
+		 * Directory to which every worker process periodically writes checkpoints of its part of the search, or empty if
+		 * checkpointing is disabled, the time between two checkpoints in seconds, and whether to resume the search from
+		 * the last consistent checkpoint in the directory
+		 */
+		std::string checkpoint_dir = "";
+		double checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+		bool checkpoint_resume = false;
+
+		/**
+		 * Generation of the checkpoints of this run, set by the master process when it prepares the checkpoint directory
+		 */
+		int checkpoint_generation = 0;
+
+		/**
+		 * Time budget of the search in seconds, or 0 for none, see CliqueFinder::setDeadline()
+		 */
+		double deadline = 0;
+
+		/**
+		 * Time (in seconds) between two progress lines printed by the master process, or 0 for none. The setting of the
+		 * master process is used by all processes
+		 */
+		double progress_interval = 0;
+
 		/**
 		 * The file name to which any results should be written
 		 */
 		std::string results_output_fname = "";
 
+		/**
+		 * The file name to which the trace of the computation should be written, or empty if no trace is recorded. The
+		 * setting of the master process is used by all processes
+		 */
+		std::string trace_output_fname = "";
+
+		/**
+		 * The file name to which the cost of each root task should be written, for replaying the computation in the load
+		 * balancing simulator. Only used by the master process
+		 */
+		std::string root_costs_output_fname = "";
+
+		/**
+		 * The file name of the root cost profile of an earlier run to partition the root tasks by, or empty to partition
+		 * them by ID, and the contents of the profile as read by the master process, which are shared with all processes
+		 * so that they all partition the root tasks alike
+		 */
+		std::string root_profile_fname = "";
+		std::string root_profile_contents = "";
+
+		/**
+		 * Whether the cost of each root task is recorded. The setting of the master process is used by all processes
+		 */
+		bool record_root_costs = false;
+
+		/**
+		 * The file name to which the number of cliques each node belongs to should be written, and its format. Only used
+		 * by the master process
+		 */
+		std::string node_counts_output_fname = "";
+		int node_counts_output_format = NODE_COUNTS_OUTPUT_TSV;
+
+		/**
+		 * Whether the number of cliques each node belongs to is recorded. The setting of the master process is used by
+		 * all processes
+		 */
+		bool record_node_counts = false;
+
 		/**
 		 * Progress monitor object to track time
 		 */
@@ -84,6 +260,81 @@ class Process {
 		 */
 		void initMPI();
 
+		/**
+		 * Free the MPI resources held by the process. Should be called by all processes
+		 */
+		void finalizeMPI();
+
+		/**
+		 * Combine the traces recorded by all processes at the master process, and write them to the trace output file in
+		 * the Chrome trace event format. Should be called by all processes, after all threads of the process have finished
+		 */
+		void writeTrace();
+
+		/**
+		 * Wait until a message is available on any of the given communicators. Blocking MPI calls busy-wait in common MPI
+		 * implementations, which would take up a full core next to the computation on the same process. Instead, probe
+		 * with an exponentially increasing sleep time, bounded to keep help latency low.
+		 *
+		 * @param const MPI_Comm *comms Communicators to probe
+		 * @param int num_comms Number of communicators to probe
+		 * @param MPI_Status *status Status of the available message
+		 * @return int Index of the communicator on which the message is available
+		 */
+		static int waitForMessage( const MPI_Comm *comms, int num_comms, MPI_Status *status );
+
+		/**
+		 * Get the ID of the process that handles help requests and subtask completion of this process, i.e. the host
+		 * broker if the load balancer is LOAD_BALANCER_HOST and the master process otherwise
+		 *
+		 * @return int Process ID of coordinator
+		 */
+		int getCoordinatorId();
+
+		/**
+		 * Get the communicator for messages addressed to the coordinator of this process
+		 *
+		 * @return MPI_Comm Coordinator communicator
+		 */
+		MPI_Comm getCoordinatorComm();
+
+		/**
+		 * Get the ID of the first process taking part in the computation, which is 0 if the master process computes
+		 * and 1 otherwise
+		 *
+		 * @return int Process ID of first worker process
+		 */
+		int getFirstWorkerId();
+
+		/**
+		 * Enable/disable the master process taking part in the computation. Requires MPI_THREAD_MULTIPLE support, as the
+		 * coordinator duties then run on a separate thread. The setting of the master process is used by all processes
+		 *
+		 * @param bool computes Whether the master process should take part in the computation
+		 */
+		void setMasterComputes( bool computes );
+
+		/**
+		 * Change the mechanism used for matching processes requesting help with idle processes
+		 *
+		 * @param int balancer Either LOAD_BALANCER_MASTER or LOAD_BALANCER_RMA
+		 */
+		void setLoadBalancer( int balancer );
+
+		/**
+		 * Change the policy for choosing an idle process to help a process requesting help
+		 *
+		 * @param int policy Either HELP_MATCH_FIRST, HELP_MATCH_ROUND_ROBIN or HELP_MATCH_NEAREST
+		 */
+		void setHelpMatchPolicy( int policy );
+
+		/**
+		 * Change the number of consecutive processes that are grouped as a host for host-level load balancing
+		 *
+		 * @param int size Number of processes per host, or 0 to group processes by shared-memory node
+		 */
+		void setHostSize( int size );
+
 		/**
 		 * Change the verbose setting. Use true if debugging information should be outputted for this process, false otherwise
 		 *
@@ -105,6 +356,85 @@ class Process {
 		 */
 		void setHelpRequestThreshold( int threshold );
 
+		/**
+		 * Enable/disable adjusting the help request threshold at runtime, based on the rejection rate and latency of help
+		 * requests
+		 *
+		 * @param bool enabled Whether the help request threshold should be adaptive
+		 */
+		void setHelpRequestThresholdAdaptive( bool enabled );
+
+		/**
+		 * Enable/disable the use of oriented edges as root tasks of the search
+		 *
+		 * @param bool enabled Whether edges (true) or single nodes (false) should be used as root tasks
+		 */
+		void setEnableEdgeRoots( bool enabled );
+
+		/**
+		 * Set the order in which the nodes are renumbered after reading the graph, so that the neighbour lists and
+		 * edges touched together by the search are close together in memory. Only the setting of the master process is
+		 * used
+		 *
+		 * @param int order Node order, see NODE_ORDER_* in NodeOrder.h
+		 */
+		void setNodeOrder( int order );
+
+		/**
+		 * Enable/disable collapsing classes of twins into single nodes after reading the graph, before renumbering the
+		 * nodes. The search counts the cliques of the input graph combinatorially from the cliques of the collapsed
+		 * graph, so that node clique counts and clique listings are not supported. Only the setting of the master process
+		 * is used
+		 *
+		 * @param bool enabled Whether twins should be collapsed
+		 */
+		void setTwinCompression( bool enabled );
+
+		/**
+		 * @see CliqueFinder::setCliqueSizeRange()
+		 */
+		void setCliqueSizeRange( int size_min, int size_max );
+
+		/**
+		 * Enable/disable listing all cliques found within the clique size range. Each worker process writes the cliques
+		 * it finds to its own file, named by the prefix followed by a dot and the process ID
+		 *
+		 * @param std::string prefix Prefix of the output file names, or empty to only count cliques
+		 * @param int format Output format, CLIQUE_OUTPUT_BINARY or CLIQUE_OUTPUT_TEXT
+		 */
+		void setCliqueOutput( std::string prefix, int format );
+
+		/**
+		 * @see CliqueFinder::setSampling()
+		 */
+		void setSampling( double target_error, double confidence, unsigned int seed );
+
+		/**
+		 * Enable/disable checkpointing of the search, and resuming it from the last consistent checkpoint. Should be set
+		 * on all processes
+		 *
+		 * @param std::string dir Checkpoint directory, or empty to disable checkpointing
+		 * @param double interval Time (in seconds) between two checkpoints
+		 * @param bool resume Whether to resume the search from the checkpoint directory
+		 */
+		void setCheckpointing( std::string dir, double interval, bool resume );
+
+		/**
+		 * Set the time budget of the search of every worker process, from the start of its search. Should be set on all
+		 * processes
+		 *
+		 * @see CliqueFinder::setDeadline()
+		 */
+		void setDeadline( double seconds );
+
+		/**
+		 * Enable/disable live progress reporting. The master process periodically prints the progress of the search,
+		 * its throughput, the estimated time left and the worker processes with the most work left
+		 *
+		 * @param double seconds Time (in seconds) between two progress lines, or 0 to disable progress reporting
+		 */
+		void setProgressInterval( double seconds );
+
 		/**
 		 * Change the output file name to which any results should be written. Leave empty or at "0" to
 		 * prevent writing output to any file
@@ -112,6 +442,43 @@ class Process {
 		 * @param std::string output_fname Path of output file
 		 */
 		void setResultsOutputFileName( std::string output_fname );
+
+		/**
+		 * Change the file name to which a trace of the computation (graph loading, root tasks, help requests and
+		 * transfers, idle time and result aggregation per process and thread) should be written. Leave empty to disable
+		 * tracing
+		 *
+		 * @param std::string output_fname Path of trace file
+		 */
+		void setTraceOutputFileName( std::string output_fname );
+
+		/**
+		 * Change the file name to which the cost of each root task should be written, as tab-separated root ID, number
+		 * of candidate nodes, time in seconds and number of search tree nodes per line, after a header line identifying
+		 * the graph. Leave empty to disable recording root task costs
+		 *
+		 * @param std::string output_fname Path of root task costs file
+		 */
+		void setRootCostsOutputFileName( std::string output_fname );
+
+		/**
+		 * Set the root cost profile of an earlier run, written as root task costs, by which the root tasks are
+		 * partitioned over the worker processes. A profile recorded on another graph or type of root tasks is rejected,
+		 * and the root tasks are then partitioned by ID. Only the setting of the master process is used
+		 *
+		 * @see CliqueFinder::setRootProfile()
+		 * @param std::string fname Path of the profile, or empty to partition by ID
+		 */
+		void setRootProfileFileName( std::string fname );
+
+		/**
+		 * Change the file to which the number of cliques each node belongs to should be written, per clique size within
+		 * the clique size range. Leave empty to disable recording node clique counts
+		 *
+		 * @param std::string output_fname Path of node clique counts file
+		 * @param int format Output format, NODE_COUNTS_OUTPUT_TSV or NODE_COUNTS_OUTPUT_BINARY
+		 */
+		void setNodeCountsOutput( std::string output_fname, int format );
 };
 
 #endif
@@ -2,10 +2,14 @@
 // ==========
 // STL includes
 #include <fstream>
+#include <thread>
 
 // Program includes
 #include "ProcessMaster.h"
 #include "const.h"
+#include "../Trace/Trace.h"
+#include "../Results/ResultsReport.h"
+#include "../Progress/ProgressReporter.h"
 
 void ProcessMaster::run() {
 	// Initialize MPI settings
@@ -16,83 +20,207 @@ void ProcessMaster::run() {
 
 	// Oversee clique finding process
 	manageFindCliques();
+
+	// Combine the traces of all processes and write them to file
+	writeTrace();
+
+	// Free MPI resources
+	finalizeMPI();
 }
 
 void ProcessMaster::manageFindCliques() {
 	// Reset indicators of process status and number of active processes
 	resetProcessesStatus();
 
-	// Manage load balancing until clique finding process is complete
-	manageLoadBalancing();
+	// Print the progress of the worker processes periodically while they search
+	ProgressReporter *progress_reporter = NULL;
 
-	// At this point, all processes have completed their jobs, and therefore the entire graph has
-	// been processed. Relay this information to processes so they can finalize.
-	transmitFindCliquesComplete();
+	if ( progress_registry != NULL ) {
+		progress_reporter = new ProgressReporter( progress_registry, progress_interval, getFirstWorkerId() );
+		progress_reporter->start();
+	}
+
+	if ( load_balancer == LOAD_BALANCER_RMA ) {
+		// Help requests are matched through the helper registry, so no coordination is needed
+		if ( master_computes ) {
+			performFindCliques();
+		}
+		else {
+			waitForFindCliquesComplete();
+		}
+	}
+	else if ( master_computes ) {
+		// The master process is the host broker of its own host
+		if ( load_balancer == LOAD_BALANCER_HOST ) {
+			createHostBroker();
+		}
+
+		// Run the coordinator duties on a separate thread, and take part in the computation on this thread
+		std::thread coordinator( &ProcessMaster::coordinateFindCliques, this );
+		performFindCliques();
+		coordinator.join();
+	}
+	else {
+		if ( load_balancer == LOAD_BALANCER_HOST ) {
+			createHostBroker();
+		}
+
+		coordinateFindCliques();
+	}
+
+	delete progress_reporter;
 
 	// Aggregate results
 	aggregateResults();
 }
 
-void ProcessMaster::manageLoadBalancing() {
+void ProcessMaster::waitForFindCliquesComplete() {
 	int buff;
+	MPI_Recv( &buff, 1, MPI_INT, MPI_ANY_SOURCE, MPI_TAG_ALL_PROCESSING_COMPLETED, comm_master, MPI_STATUS_IGNORE );
+}
 
-	// Main loop for governing processes requesting assistance from other processes to take over
-	// part of their computational needs
-	while ( num_processes_active > 0 ) {
-		int probe_flag;
-		MPI_Status probe_status;
+void ProcessMaster::coordinateFindCliques() {
+	if ( master_computes ) {
+		Trace::setThreadName( "coordinator" );
+	}
 
-		// Probe for any processes that have completed
-		MPI_Iprobe( MPI_ANY_SOURCE, MPI_TAG_GRAPH_PROCESSING_DONE, MPI_COMM_WORLD, &probe_flag, &probe_status );
+	TraceScope trace_scope( "coordinate" );
 
-		if ( probe_flag ) {
-			MPI_Recv( &buff, 1, MPI_INT, probe_status.MPI_SOURCE, probe_status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+	// Manage load balancing until clique finding process is complete
+	if ( load_balancer == LOAD_BALANCER_HOST ) {
+		manageHostLoadBalancing();
+	}
+	else {
+		manageLoadBalancing();
+	}
 
-			num_processes_active--;
-			processes_status[ probe_status.MPI_SOURCE ] = PROCESS_IDLE;
+	// At this point, all processes have completed their jobs, and therefore the entire graph has
+	// been processed. Relay this information to processes so they can finalize.
+	transmitFindCliquesComplete();
+}
 
-			// Output new process statuses (should be and was commented out when running final experiments)
-			if ( verbose ) {
-				printf( "\r" );
+void ProcessMaster::manageHostLoadBalancing() {
+	// Whether all processes on each host are idle, and the number of processes taking part in the computation per host
+	// Format: [broker_process_id] => [value]
+	std::map<int, bool> hosts_idle;
+	std::map<int, int> hosts_num_workers;
+
+	for ( int i = 0; i < num_processes; i++ ) {
+		hosts_idle[ broker_process_ids[ i ] ] = false;
+		hosts_num_workers[ broker_process_ids[ i ] ] += ( i >= getFirstWorkerId() );
+	}
+
+	// Hosts without processes taking part in the computation are idle from the start, but can never help
+	int num_hosts_idle = 0;
+
+	for ( auto &host : hosts_idle ) {
+		if ( hosts_num_workers[ host.first ] == 0 ) {
+			host.second = true;
+			num_hosts_idle++;
+		}
+	}
 
-				for ( int i = 1; i < num_processes; i++ ) {
-					printf( "%d ", processes_status[ i ] );
+	// Number of hosts that are idle and can help processes on other hosts
+	int num_hosts_available = 0;
+
+	MPI_Comm comms[2] = { comm_master, comm_broker };
+
+	// Main loop for governing hosts requesting assistance from other hosts, and for acting as broker for the host of
+	// the master process
+	while ( num_hosts_idle < (int) hosts_idle.size() ) {
+		MPI_Status probe_status;
+
+		if ( waitForMessage( comms, 2, &probe_status ) == 1 ) {
+			host_broker->handleMessage( &probe_status );
+			continue;
+		}
+
+		int buff;
+		MPI_Recv( &buff, 1, MPI_INT, probe_status.MPI_SOURCE, probe_status.MPI_TAG, comm_master, MPI_STATUS_IGNORE );
+
+		int num_hosts_available_previous = num_hosts_available;
+
+		if ( probe_status.MPI_TAG == MPI_TAG_HOST_IDLE ) {
+			// All processes on the host of the broker have become idle
+			hosts_idle[ probe_status.MPI_SOURCE ] = true;
+			num_hosts_idle++;
+			num_hosts_available++;
+		}
+		else if ( probe_status.MPI_TAG == MPI_TAG_REQUEST_REMOTE_HELP ) {
+			TraceScope trace_scope( "match remote help request", buff );
+
+			// A host broker requests help for one of its processes (buff) from another host. Assign the first idle host,
+			// which no longer counts as idle until its broker reports so again
+			int helper_broker_id = -1;
+
+			for ( auto &host : hosts_idle ) {
+				if ( host.second && hosts_num_workers[ host.first ] > 0 ) {
+					helper_broker_id = host.first;
+					host.second = false;
+					num_hosts_idle--;
+					num_hosts_available--;
+					break;
 				}
+			}
+
+			if ( helper_broker_id >= 0 ) {
+				MPI_Send( &buff, 1, MPI_INT, helper_broker_id, MPI_TAG_CLAIM_HOST_HELPER, comm_broker );
+			}
+			else {
+				int response_buff = -1;
+				MPI_Send( &response_buff, 1, MPI_INT, buff, MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE, MPI_COMM_WORLD );
+			}
+		}
 
-				fflush( stdout );
+		// Tell all host brokers whether help can be requested from other hosts when this changes, so that brokers only
+		// forward help requests when there are idle hosts
+		if ( ( num_hosts_available > 0 ) != ( num_hosts_available_previous > 0 ) ) {
+			int available_buff = ( num_hosts_available > 0 );
+
+			for ( const auto &host : hosts_idle ) {
+				MPI_Send( &available_buff, 1, MPI_INT, host.first, MPI_TAG_IDLE_HOSTS_AVAILABLE, comm_broker );
 			}
 		}
+	}
 
-		// Probe for any processes requesting balancing
-		MPI_Iprobe( MPI_ANY_SOURCE, MPI_TAG_GRAPH_REQUEST_HELP, MPI_COMM_WORLD, &probe_flag, &probe_status );
+	// Signal all other host brokers that all processing is completed
+	for ( const auto &host : hosts_idle ) {
+		if ( host.first != process_id ) {
+			int buff = 1;
+			MPI_Send( &buff, 1, MPI_INT, host.first, MPI_TAG_ALL_PROCESSING_COMPLETED, comm_broker );
+		}
+	}
+}
 
-		if ( probe_flag ) {
-			int response_buff = 0;
-			MPI_Recv( &buff, 1, MPI_INT, probe_status.MPI_SOURCE, probe_status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+void ProcessMaster::manageLoadBalancing() {
+	int buff;
+
+	// Main loop for governing processes requesting assistance from other processes to take over
+	// part of their computational needs
+	while ( help_matcher->getNumProcessesActive() > 0 ) {
+		MPI_Status probe_status;
 
-			// Check whether there are any idle processes
-			if ( num_processes_active < num_processes - 1 ) {
-				// Find the first idle process and change its status
-				for ( int i = 1; i < num_processes; i++ ) {
-					if ( processes_status[ i ] == PROCESS_IDLE ) {
-						response_buff = i;
-						processes_status[ i ] = PROCESS_HELPING;
-						num_processes_active++;
+		// Wait for any process that has completed or that requests balancing
+		waitForMessage( &comm_master, 1, &probe_status );
+		MPI_Recv( &buff, 1, MPI_INT, probe_status.MPI_SOURCE, probe_status.MPI_TAG, comm_master, MPI_STATUS_IGNORE );
 
-						// Output new process statuses (should be and was commented out when running final experiments)
-						if ( verbose ) {
-							printf( "\r" );
+		if ( probe_status.MPI_TAG == MPI_TAG_GRAPH_PROCESSING_DONE ) {
+			help_matcher->markIdle( probe_status.MPI_SOURCE );
 
-							for ( int i = 1; i < num_processes; i++ ) {
-								printf( "%d ", processes_status[ i ] );
-							}
+			// Output new process statuses (should be and was commented out when running final experiments)
+			if ( verbose ) {
+				printProcessesStatus();
+			}
+		}
+		else if ( probe_status.MPI_TAG == MPI_TAG_GRAPH_REQUEST_HELP ) {
+			TraceScope trace_scope( "match help request", probe_status.MPI_SOURCE );
 
-							fflush( stdout );
-						}
+			// Find an idle process and change its status
+			int response_buff = help_matcher->claimHelper( probe_status.MPI_SOURCE );
 
-						break;
-					}
-				}
+			// Output new process statuses (should be and was commented out when running final experiments)
+			if ( verbose && response_buff >= 0 ) {
+				printProcessesStatus();
 			}
 
 			// Tell the process requesting help whether its request has been granted, and if so, pass
@@ -102,24 +230,32 @@ void ProcessMaster::manageLoadBalancing() {
 	}
 }
 
-void ProcessMaster::transmitFindCliquesComplete() {
-	for ( int i = 1; i < num_processes; i++ ) {
-		int buff = 1;
-		MPI_Send( &buff, 1, MPI_INT, i, MPI_TAG_ALL_PROCESSING_COMPLETED, MPI_COMM_WORLD );
+void ProcessMaster::printProcessesStatus() {
+	// The overwritten status line would end up in the middle of the progress lines
+	if ( progress_registry != NULL ) {
+		return;
 	}
+
+	printf( "\r" );
+
+	for ( const auto &process_status : help_matcher->getProcessesStatus() ) {
+		printf( "%d ", process_status.second );
+	}
+
+	fflush( stdout );
 }
 
 void ProcessMaster::resetProcessesStatus() {
-	// Set all process statuses to "running"
-	processes_status.resize( num_processes );
-	std::fill( processes_status.begin(), processes_status.end(), PROCESS_RUNNING );
+	// Set all process statuses to "running". Unless it takes part in the computation, the master process is not
+	// involved in the actual computation of the number of cliques, and is not matched with processes requesting help
+	std::vector<int> worker_process_ids;
 
-	// Set the status of this process (the master process) to idle. The master process is regarded a process, but is
-	// not involved in the actual computation of the number of cliques
-	processes_status[0] = PROCESS_IDLE;
+	for ( int i = getFirstWorkerId(); i < num_processes; i++ ) {
+		worker_process_ids.push_back( i );
+	}
 
-	// Update the number of currently active processes
-	num_processes_active = num_processes - 1;
+	delete help_matcher;
+	help_matcher = new HelpMatcher( worker_process_ids, help_match_policy );
 }
 
 void ProcessMaster::handleInputFilePath( std::string dataset_name, std::string file_path ) {
@@ -165,83 +301,51 @@ void ProcessMaster::transmitInputFilePath( std::string file_path ) {
 }
 
 void ProcessMaster::aggregateResults() {
-	// Total clique counts for graph
-	std::map<int,long long> cliques_counts;
-
-	// List of clique counts per clique size
-	std::vector<long long> cliques_counts_slave;
-
-	// Help request counts
-	long long num_help_requests_sent = 0;
-	long long num_help_requests_sent_accepted = 0;
-	long long num_help_requests_sent_rejected = 0;
-
-	// Add clique counts for slave processes
-	for ( int i = 1; i < num_processes; i++ ) {
-		MPI_Status status;
-		int max_clique_size;
-
-		// Buffer number of clique sizes
-		MPI_Probe( i, MPI_TAG_CLIQUE_COUNTS, MPI_COMM_WORLD, &status );
-		MPI_Get_count( &status, MPI_LONG_LONG, &max_clique_size );
-
-		// Reserve space for cliques
-		cliques_counts_slave.resize( max_clique_size );
-
-		// Receive number of cliques per clique size
-		MPI_Recv( &cliques_counts_slave[0], max_clique_size, MPI_LONG_LONG, i, MPI_TAG_CLIQUE_COUNTS, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-
-		for ( int j = 0; j < max_clique_size; j++ ) {
-			cliques_counts[ j ] += cliques_counts_slave[ j ];
-		}
-
-		// Receive help request counts
-		long long num_help_requests_sent_slave;
-		long long num_help_requests_sent_accepted_slave;
-		long long num_help_requests_sent_rejected_slave;
-		MPI_Recv( &num_help_requests_sent_slave, 1, MPI_LONG_LONG, i, MPI_TAG_HELP_REQUESTS_SENT, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-		MPI_Recv( &num_help_requests_sent_accepted_slave, 1, MPI_LONG_LONG, i, MPI_TAG_HELP_REQUESTS_SENT_ACCEPTED, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-		MPI_Recv( &num_help_requests_sent_rejected_slave, 1, MPI_LONG_LONG, i, MPI_TAG_HELP_REQUESTS_SENT_REJECTED, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-
-		num_help_requests_sent += num_help_requests_sent_slave;
-		num_help_requests_sent_accepted += num_help_requests_sent_accepted_slave;
-		num_help_requests_sent_rejected += num_help_requests_sent_rejected_slave;
-	}
-
-	// Report clique counts
-	long long num_cliques_total = 0;
-
-	for ( int i = 0; i < cliques_counts.size(); i++ ) {
-		if ( verbose ) {
-			printf( "Number of %d-cliques: %lld\n", i, cliques_counts[ i ] );
-		}
-
-		num_cliques_total += cliques_counts[ i ];
-	}
-
-	float time_past = pm.stop();
-	
-	// Write results to file
-	if ( results_output_fname != "" && results_output_fname != "0" ) {
-		// Log process
-		char output_line_buffer[2048];
-
-		sprintf( output_line_buffer, "%d\t%d\t%.5f\t%lld\t%lld\t%lld\t%lld", num_processes, help_request_threshold, time_past, num_cliques_total, num_help_requests_sent, num_help_requests_sent_accepted, num_help_requests_sent_rejected );
-		std::string output_line = output_line_buffer;
-
-		std::ofstream fh_log_output( results_output_fname, std::fstream::app|std::fstream::out );
-		fh_log_output << output_line << "\n";
-	}
-
-	// Write final results
-	printf( "Total number of cliques: %lld\n", num_cliques_total );
-
-	if ( verbose ) {
-		printf( "Requests: %lld/%lld accepted (%lld rejected)\n", num_help_requests_sent_accepted, num_help_requests_sent, num_help_requests_sent_rejected );
-	}
+	TraceScope trace_scope( "aggregate results" );
+
+	ResultsReport report;
+
+	// Combine the result records of all processes, including this process if it took part in the computation
+	report.record = reduceFindCliquesResults();
+
+	// Trajectories of the adaptive help request threshold per process, as alternating time and threshold
+	report.help_threshold_trajectories = gatherHelpRequestThresholdTrajectories();
+
+	// Costs of all root tasks
+	report.root_costs = gatherRootCosts();
+	report.root_costs_header = reduceRootCostsHeader();
+
+	// Number of cliques each node belongs to
+	report.node_cliques_counts = reduceNodeCliquesCounts( report.node_id_min, report.num_nodes );
+	report.node_external_ids = transmitNodeExternalIds();
+
+	// Estimate of the number of cliques from the root tasks sampled by all processes
+	report.sample_record = reduceSampleRecords();
+	report.sample_target_error = sample_target_error;
+	report.sample_confidence = sample_confidence;
+
+#ifdef CLIQUES_STATS
+	// Search statistics summed over all processes
+	report.stats = reduceSearchStats();
+#endif
+
+	report.num_processes = num_processes;
+	report.num_workers = num_processes - getFirstWorkerId();
+	report.help_request_threshold = help_request_threshold;
+	report.help_threshold_adaptive = help_threshold_adaptive;
+	report.time_past = pm_run.stop();
+	report.verbose = verbose;
+	report.results_output_fname = results_output_fname;
+	report.root_costs_output_fname = record_root_costs ? root_costs_output_fname : "";
+	report.node_counts_output_fname = node_counts_output_fname;
+	report.node_counts_output_format = node_counts_output_format;
+
+	// Report clique counts, and write results to file
+	report.write();
+}
 
-	printf( "%.5f seconds past\n", time_past );
-	printf( "\n" );
+void ProcessMaster::transmitFindCliquesResult() {
+	// The results of the master process are added directly when aggregating the results
 }
 
 bool ProcessMaster::isMaster() {
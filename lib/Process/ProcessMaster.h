@@ -5,27 +5,26 @@
 // ==========
 // STL includes
 #include <vector>
+#include <map>
 
 // Program includes
-#include "Process.h"
+#include "ProcessSlave.h"
 
-class ProcessMaster : public Process {
+class ProcessMaster : public ProcessSlave {
 	protected:
 		/**
-		 * The status of each process, either PROCESS_IDLE, PROCESS_RUNNING or PROCESS_HELPING
-		 * PROCESS_IDLE: Process has completed its assigned part of the task, and is waiting for help requests
-		 * PROCESS_RUNNING: Process is performing its originally assigned part of the task
-		 * PROCESS_HELPING: Process is assisting another process with its assigned task
+		 * Status of the processes taking part in the computation, for matching help requests with idle processes
 		 */
-		std::vector<int> processes_status;
+		HelpMatcher *help_matcher = NULL;
 
 		/**
-		 * Number of processes that are currently active (i.e. either running or helping)
+		 * Progress monitor object to track the time of the entire run, separately from the time tracking of the
+		 * computation on the master process
 		 */
-		int num_processes_active;
+		ProgressMonitor pm_run;
 
 	public:
-		ProcessMaster( int process_id, int num_processes ) : Process( process_id, num_processes ) {}
+		ProcessMaster( int process_id, int num_processes ) : ProcessSlave( process_id, num_processes ) {}
 
 		/**
 		 * @see Process::run()
@@ -59,10 +58,23 @@ class ProcessMaster : public Process {
 		void transmitInputFilePath( std::string file_path = "" );
 
 		/**
-		 * Manage the clique-finding process. Handle and relay help requests from processes, and maintain status of processes
+		 * Manage the clique-finding process. Handle and relay help requests from processes, and maintain status of processes.
+		 * If the master process takes part in the computation, the coordination is done on a separate thread
 		 */
 		void manageFindCliques();
 
+		/**
+		 * Wait until the last active process signals that all clique finding has been completed. Used if help requests
+		 * are matched through the helper registry and the master process does not take part in the computation
+		 */
+		void waitForFindCliquesComplete();
+
+		/**
+		 * Perform the coordinator duties of the master process: manage load balancing until all processes have completed,
+		 * and signal completion to all processes
+		 */
+		void coordinateFindCliques();
+
 		/**
 		 * Reset variables indicating the status of each process and the number of active processes
 		 */
@@ -75,9 +87,21 @@ class ProcessMaster : public Process {
 		void manageLoadBalancing();
 
 		/**
-		 * Transmit messages to all slave processes that all clique finding has been completed
+		 * Manage load balancing across hosts. Host brokers handle help requests within their host, and only forward
+		 * help requests to the master process if all processes on another host are idle. The master process keeps track
+		 * of which hosts are idle, assigns idle hosts to help other hosts, and acts as host broker for its own host
+		 */
+		void manageHostLoadBalancing();
+
+		/**
+		 * Output the status of each process on a single, overwritten line, unless progress is reported
+		 */
+		void printProcessesStatus();
+
+		/**
+		 * @see ProcessSlave::transmitFindCliquesResult()
 		 */
-		void transmitFindCliquesComplete();
+		void transmitFindCliquesResult();
 
 		/**
 		 * Aggregate results of child processes
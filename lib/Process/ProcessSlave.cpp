@@ -1,12 +1,16 @@
 // Includes
 // ==========
 // STL includes
+#include <thread>
+#include <algorithm>
+#include <climits>
 
 // Program includes
 #include "ProcessSlave.h"
 #include "const.h"
 #include "../Graph/Graph.h"
 #include "../CliqueFinder/CliqueFinder.h"
+#include "../Trace/Trace.h"
 
 void ProcessSlave::run() {
 	// Initialize MPI settings
@@ -15,6 +19,17 @@ void ProcessSlave::run() {
 	// Receive dataset input file path from master process
 	receiveInputFilePath();
 
+	// Perform this process's part of the computation
+	performFindCliques();
+
+	// Combine the traces of all processes at the master process
+	writeTrace();
+
+	// Free MPI resources
+	finalizeMPI();
+}
+
+void ProcessSlave::performFindCliques() {
 	// Create graph
 	createGraph();
 
@@ -24,8 +39,37 @@ void ProcessSlave::run() {
 	// Read graph
 	readGraphFromInputFile();
 
+	// Partition the root tasks by the root cost profile, if one is given and was recorded on this graph
+	if ( root_profile_contents != "" && root_profile.parse( root_profile_contents, graph, edge_roots, process_id == getFirstWorkerId() ) ) {
+		cliquefinder->setRootProfile( &root_profile );
+	}
+
+	// Act as broker for the host of this process on a separate thread, unless the master process acts as broker
+	std::thread broker;
+
+	if ( load_balancer == LOAD_BALANCER_HOST && ! isMaster() && getCoordinatorId() == process_id ) {
+		createHostBroker();
+		broker = std::thread( &HostBroker::run, host_broker );
+	}
+
 	// Find cliques
 	findCliques();
+
+	if ( broker.joinable() ) {
+		broker.join();
+	}
+}
+
+void ProcessSlave::createHostBroker() {
+	std::vector<int> local_process_ids;
+
+	for ( int i = getFirstWorkerId(); i < num_processes; i++ ) {
+		if ( broker_process_ids[ i ] == process_id ) {
+			local_process_ids.push_back( i );
+		}
+	}
+
+	host_broker = new HostBroker( process_id, local_process_ids, comm_broker, comm_master, help_match_policy );
 }
 
 void ProcessSlave::handleInputFilePath( std::string dataset_name, std::string file_path ) {
@@ -55,32 +99,74 @@ void ProcessSlave::createGraph() {
 }
 
 void ProcessSlave::readGraphFromInputFile() {
+	TraceScope trace_scope( "graph load" );
+
 	if ( verbose ) pm.reset();
 	graph->readEdgeList( graph_input_fname );
 
-	if ( verbose ) {
+	bool report = verbose && ( ! isMaster() || num_processes == 1 );
+
+	if ( report ) {
 		// Report information on graph
 		printf( "Read graph: %d nodes, %d edges, %d degree threshold, estimated power-law exponent %.2f\n", graph->getNumNodes(), graph->getNumEdges(), cliquefinder->getHelpRequestThreshold(), graph->getPowerLawExponent() );
 		printf( "Reading graph took %.2f seconds.\n", pm.lap() );
 	}
+
+	// Collapse twins and renumber the nodes, which all processes do alike as both are deterministic
+	if ( twin_compression ) {
+		TraceScope trace_scope_twins( "twin compression" );
+		TwinCompression::apply( graph, report );
+	}
+
+	{
+		TraceScope trace_scope_order( "node order" );
+		NodeOrder::apply( graph, node_order, report );
+	}
 }
 
 void ProcessSlave::createCliqueFinder( Graph *g ) {
-	cliquefinder = new CliqueFinder( this, g );
-	cliquefinder->initParallelComputation( process_id, num_processes - 1, help_enabled );
+	// Help can only be provided if there are other processes taking part in the computation
+	int num_workers = num_processes - getFirstWorkerId();
+
+	worker = new Worker( this, help_enabled && num_workers > 1 );
+	cliquefinder = new CliqueFinder( worker, g );
+	worker->setCliqueFinder( cliquefinder );
+
+	cliquefinder->initParallelComputation( process_id - getFirstWorkerId(), num_workers, help_enabled && num_workers > 1 );
 	cliquefinder->setHelpRequestThreshold( help_request_threshold );
-}
+	cliquefinder->setHelpRequestThresholdAdaptive( help_threshold_adaptive );
+	cliquefinder->setEdgeRoots( edge_roots );
+	cliquefinder->setRecordRootCosts( record_root_costs );
+	cliquefinder->setCliqueSizeRange( clique_size_min, clique_size_max );
+	cliquefinder->setRecordNodeCounts( record_node_counts );
+	cliquefinder->setSampling( sample_target_error, sample_confidence, sample_seed );
+	cliquefinder->setDeadline( deadline );
+
+	if ( progress_registry != NULL ) {
+		cliquefinder->setProgressBoard( progress_registry, progress_interval );
+	}
 
-void ProcessSlave::findCliques() {
-	// Perform clique finding on subtask assigned to this processor
-	if ( verbose ) pm.reset();
-	cliquefinder->findAllCliquesDFS();
+	if ( clique_output_prefix != "" ) {
+		clique_writer = new CliqueWriter( clique_output_prefix + "." + std::to_string( process_id ), clique_output_format );
+		clique_writer->setGraph( g );
+		cliquefinder->setCliqueWriter( clique_writer );
+	}
 
-	// Relay to master process that this slave process has completed its subtask
-	transmitSubtaskCompleted();
+	if ( checkpoint_dir != "" ) {
+		checkpointer = new Checkpointer( checkpoint_dir, checkpoint_generation, process_id - getFirstWorkerId(), process_id, num_workers, num_processes, checkpoint_interval );
+		worker->setCheckpointer( checkpointer );
+
+		CheckpointSnapshot resumed;
+		bool is_resumed = Checkpointer::readResumed( checkpoint_dir, checkpoint_generation, process_id - getFirstWorkerId(), num_workers, resumed );
+		cliquefinder->setCheckpointer( checkpointer, is_resumed ? &resumed : NULL );
+	}
+}
 
-	// Wait for a help request from another process
-	standbyForHelpRequest();
+void ProcessSlave::findCliques() {
+	// Perform clique finding on subtask assigned to this processor, and help other processes until all processing is
+	// completed
+	pm.reset();
+	worker->findCliques();
 
 	// At this point, all processes have completed their subtasks, and all cliques have been found
 	if ( verbose ) {
@@ -88,132 +174,457 @@ void ProcessSlave::findCliques() {
 		printf( "Process %d: finding cliques took %.2f seconds (%d processes).\n", process_id, pm.lap(), num_processes );
 	}
 
+	// Write the remaining checkpoint snapshots
+	if ( checkpointer != NULL ) {
+		checkpointer->close();
+	}
+
+	// Write the remaining listed cliques
+	if ( clique_writer != NULL ) {
+		clique_writer->close();
+
+		if ( verbose ) {
+			printf( "Process %d: listed %lld cliques.\n", process_id, clique_writer->getNumCliques() );
+		}
+	}
+
 	// Report found cliques to master process
 	transmitFindCliquesResult();
 }
 
-bool ProcessSlave::requestHelp() {
+int ProcessSlave::requestHelper() {
+	// Claim an idle process directly through the helper registry
+	if ( load_balancer == LOAD_BALANCER_RMA ) {
+		return helper_registry->claimHelper( process_id );
+	}
+
 	// Request help from other process through master process
 	int buff = 0;
-	MPI_Send( &buff, 1, MPI_INT, 0, MPI_TAG_GRAPH_REQUEST_HELP, MPI_COMM_WORLD );
+	MPI_Send( &buff, 1, MPI_INT, getCoordinatorId(), MPI_TAG_GRAPH_REQUEST_HELP, getCoordinatorComm() );
 
-	// Retrieve response to help request
+	// Retrieve response to help request, which is sent by the host broker of the helping process if help is provided
+	// by another host. If a non-negative number was returned, help is available
 	int response_buff;
-	MPI_Recv( &response_buff, 1, MPI_INT, 0, MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-
-	// If a positive number was returned, help is available
-	if ( response_buff ) {
-		helper_process_id = response_buff;
-	}
-	else {
-		helper_process_id = -1;
-	}
+	MPI_Recv( &response_buff, 1, MPI_INT, MPI_ANY_SOURCE, MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
 
 	return response_buff;
 }
 
-void ProcessSlave::grantHelp( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int helper_start, int helper_end ) {
+void ProcessSlave::sendHelpTask( int helper_id, HelpTask &task ) {
 	// Send DFS arguments to helper node
-	MPI_Send( &depth, 1, MPI_INT, helper_process_id, MPI_TAG_GRAPH_HELP_DATA_DEPTH, MPI_COMM_WORLD );
-	MPI_Send( &helper_start, 1, MPI_INT, helper_process_id, MPI_TAG_GRAPH_HELP_DATA_START, MPI_COMM_WORLD );
-	MPI_Send( &helper_end, 1, MPI_INT, helper_process_id, MPI_TAG_GRAPH_HELP_DATA_END, MPI_COMM_WORLD );
+	MPI_Send( &task.depth, 1, MPI_INT, helper_id, MPI_TAG_GRAPH_HELP_DATA_DEPTH, MPI_COMM_WORLD );
+	MPI_Send( &task.start, 1, MPI_INT, helper_id, MPI_TAG_GRAPH_HELP_DATA_START, MPI_COMM_WORLD );
+	MPI_Send( &task.end, 1, MPI_INT, helper_id, MPI_TAG_GRAPH_HELP_DATA_END, MPI_COMM_WORLD );
+
+	if ( checkpoint_dir != "" ) {
+		MPI_Send( &task.checkpoint_epoch, 1, MPI_INT, helper_id, MPI_TAG_GRAPH_HELP_DATA_CHECKPOINT_EPOCH, MPI_COMM_WORLD );
+	}
 
-	MPI_Send( &base_nodes[0], base_nodes.size(), MPI_INT, helper_process_id, MPI_TAG_GRAPH_HELP_DATA_BASE_NODES, MPI_COMM_WORLD );
-	MPI_Send( &potential_nodes[0], potential_nodes.size(), MPI_INT, helper_process_id, MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES, MPI_COMM_WORLD );
+	MPI_Send( task.base_nodes.data(), task.base_nodes.size(), MPI_INT, helper_id, MPI_TAG_GRAPH_HELP_DATA_BASE_NODES, MPI_COMM_WORLD );
+	MPI_Send( task.potential_nodes.data(), task.potential_nodes.size(), MPI_INT, helper_id, MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES, MPI_COMM_WORLD );
+}
+
+bool ProcessSlave::receiveHelpTask( HelpTask &task ) {
+	MPI_Status probe_status;
+
+	// Wait for either a process requesting this process's help, or the master process signalling that all processing
+	// is completed
+	MPI_Probe( MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &probe_status );
+
+	if ( probe_status.MPI_TAG == MPI_TAG_ALL_PROCESSING_COMPLETED ) {
+		int buff;
+		MPI_Recv( &buff, 1, MPI_INT, probe_status.MPI_SOURCE, probe_status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+
+		return false;
+	}
+
+	// A process has requested help, so receive the part of its subtask
+	// The process ID of the process requesting help
+	int request_process_id = probe_status.MPI_SOURCE;
+	task.requester_id = request_process_id;
+
+	TraceScope trace_scope( "help receive", request_process_id );
+
+	int num_help_base_nodes;
+	int num_help_potential_nodes;
+
+	// Retrieve: Simple values
+	MPI_Recv( &task.depth, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_DEPTH, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+	MPI_Recv( &task.start, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_START, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+	MPI_Recv( &task.end, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_END, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+
+	if ( checkpoint_dir != "" ) {
+		MPI_Recv( &task.checkpoint_epoch, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_CHECKPOINT_EPOCH, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+	}
+
+	// Retrieve: Base nodes
+	// Buffer number of elements in base nodes list
+	MPI_Probe( request_process_id, MPI_TAG_GRAPH_HELP_DATA_BASE_NODES, MPI_COMM_WORLD, &probe_status );
+	MPI_Get_count( &probe_status, MPI_INT, &num_help_base_nodes );
+
+	// Reserve space for base nodes, and receive them
+	task.base_nodes.resize( num_help_base_nodes );
+	MPI_Recv( task.base_nodes.data(), num_help_base_nodes, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_BASE_NODES, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+
+	// Retrieve: Potential nodes
+	// Buffer number of elements in potential nodes list
+	MPI_Probe( request_process_id, MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES, MPI_COMM_WORLD, &probe_status );
+	MPI_Get_count( &probe_status, MPI_INT, &num_help_potential_nodes );
+
+	// Reserve space for potential nodes, and receive them
+	task.potential_nodes.resize( num_help_potential_nodes );
+	MPI_Recv( task.potential_nodes.data(), num_help_potential_nodes, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+
+	return true;
+}
+
+void ProcessSlave::reportDone() {
+	transmitSubtaskCompleted();
 }
 
 void ProcessSlave::transmitSubtaskCompleted() {
-	// Send notification to master process that node processing is done
-	int buff = 0;
-	MPI_Send( &buff, 1, MPI_INT, 0, MPI_TAG_GRAPH_PROCESSING_DONE, MPI_COMM_WORLD );
-}
-
-void ProcessSlave::standbyForHelpRequest() {
-	while ( help_enabled ) {
-		int probe_flag;
-		MPI_Status probe_status;
-
-		// Probe for any processes requesting this process's help
-		MPI_Iprobe( MPI_ANY_SOURCE, MPI_TAG_GRAPH_HELP_DATA_DEPTH, MPI_COMM_WORLD, &probe_flag, &probe_status );
-
-		// If the probe is successfull (i.e. a process has requested help), provide help. Otherwise, re-probe
-		if ( probe_flag ) {
-			// The process ID of the process requesting help
-			int request_process_id = probe_status.MPI_SOURCE;
-			//printf( "Process %d receiving from process %d.\n", process_id, request_process_id );
-
-			int help_depth;
-			std::vector<int> help_base_nodes;
-			std::vector<int> help_potential_nodes;
-			int help_start;
-			int help_end;
-
-			int num_help_base_nodes;
-			int num_help_potential_nodes;
-
-			// Retrieve: Simple values
-			MPI_Recv( &help_depth, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_DEPTH, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-			MPI_Recv( &help_start, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_START, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-			MPI_Recv( &help_end, 1, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_END, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-
-			// Retrieve: Base nodes
-			// Buffer number of elements in base nodes list
-			MPI_Probe( request_process_id, MPI_TAG_GRAPH_HELP_DATA_BASE_NODES, MPI_COMM_WORLD, &probe_status );
-			MPI_Get_count( &probe_status, MPI_INT, &num_help_base_nodes );
-
-			// Reserve space for cliques
-			help_base_nodes.resize( num_help_base_nodes );
-
-			// Receive number of cliques per clique size
-			MPI_Recv( &help_base_nodes[0], num_help_base_nodes, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_BASE_NODES, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-
-			// Retrieve: Potential nodes
-			// Buffer number of elements in potential nodes list
-			MPI_Probe( request_process_id, MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES, MPI_COMM_WORLD, &probe_status );
-			MPI_Get_count( &probe_status, MPI_INT, &num_help_potential_nodes );
-
-			// Reserve space for cliques
-			help_potential_nodes.resize( num_help_potential_nodes );
-
-			// Receive number of cliques per clique size
-			MPI_Recv( &help_potential_nodes[0], num_help_potential_nodes, MPI_INT, request_process_id, MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
-
-			// Perform operations requested by other process
-			cliquefinder->temporarilyDisableHelp();
-			cliquefinder->findCliquesDFS( help_depth, help_base_nodes, help_potential_nodes, help_start, help_end );
-			cliquefinder->setHelpEnabled( true );
-			
-			// Send notification to master process that node processing is done
-			int buff = 0;
-			MPI_Send( &buff, 1, MPI_INT, 0, MPI_TAG_GRAPH_PROCESSING_DONE, MPI_COMM_WORLD );
+	// Mark this process as idle in the helper registry, and if it was the last active process, relay to all processes
+	// that all processing is completed
+	if ( load_balancer == LOAD_BALANCER_RMA ) {
+		if ( helper_registry->markIdle( process_id ) ) {
+			transmitFindCliquesComplete();
 		}
 
-		// Probe for master process signalling that all processing is completed
-		MPI_Iprobe( 0, MPI_TAG_ALL_PROCESSING_COMPLETED, MPI_COMM_WORLD, &probe_flag, &probe_status );
+		return;
+	}
 
-		if ( probe_flag ) {
-			break;
-		}
+	// Send notification to master process or host broker that node processing is done
+	int buff = 0;
+	MPI_Send( &buff, 1, MPI_INT, getCoordinatorId(), MPI_TAG_GRAPH_PROCESSING_DONE, getCoordinatorComm() );
+}
+
+void ProcessSlave::transmitFindCliquesComplete() {
+	int buff = 1;
+
+	for ( int i = getFirstWorkerId(); i < num_processes; i++ ) {
+		MPI_Send( &buff, 1, MPI_INT, i, MPI_TAG_ALL_PROCESSING_COMPLETED, MPI_COMM_WORLD );
+	}
+
+	// A master process that does not take part in the computation waits for completion in its role of coordinator
+	if ( ! isMaster() && ! master_computes ) {
+		MPI_Send( &buff, 1, MPI_INT, 0, MPI_TAG_ALL_PROCESSING_COMPLETED, comm_master );
 	}
 }
 
 void ProcessSlave::transmitFindCliquesResult() {
-	// List of clique counts per clique size
-	std::vector<long long> cliques_counts_slave = cliquefinder->getCliquesCountsVector();
+	TraceScope trace_scope( "aggregate results" );
+
+	// Combine the results of all processes at the master process
+	reduceFindCliquesResults();
+	gatherHelpRequestThresholdTrajectories();
+	gatherRootCosts();
+	reduceRootCostsHeader();
 
-	// Number of help requests
-	long long num_help_requests_sent, num_help_requests_sent_accepted, num_help_requests_sent_rejected;
-	num_help_requests_sent = cliquefinder->getNumHelpRequestsSent();
-	num_help_requests_sent_accepted = cliquefinder->getNumHelpRequestsSentAccepted();
-	num_help_requests_sent_rejected = cliquefinder->getNumHelpRequestsSentRejected();
+	int node_id_min, num_nodes;
+	reduceNodeCliquesCounts( node_id_min, num_nodes );
+	transmitNodeExternalIds();
+	reduceSampleRecords();
 
-	// Send clique counts to master process
-	MPI_Send( &cliques_counts_slave[0], cliques_counts_slave.size(), MPI_LONG_LONG, 0, MPI_TAG_CLIQUE_COUNTS, MPI_COMM_WORLD );
-	MPI_Send( &num_help_requests_sent, 1, MPI_LONG_LONG, 0, MPI_TAG_HELP_REQUESTS_SENT, MPI_COMM_WORLD );
-	MPI_Send( &num_help_requests_sent_accepted, 1, MPI_LONG_LONG, 0, MPI_TAG_HELP_REQUESTS_SENT_ACCEPTED, MPI_COMM_WORLD );
-	MPI_Send( &num_help_requests_sent_rejected, 1, MPI_LONG_LONG, 0, MPI_TAG_HELP_REQUESTS_SENT_REJECTED, MPI_COMM_WORLD );
+	SEARCH_STATS( reduceSearchStats() );
 
 	if ( verbose ) {
-		printf( "Process %d: %lld/%lld requests rejecected (%lld accepted)\n", process_id, num_help_requests_sent_rejected, num_help_requests_sent, num_help_requests_sent_accepted );
+		printf( "Process %d: %lld/%lld requests rejecected (%lld accepted)\n", process_id, cliquefinder->getNumHelpRequestsSentRejected(), cliquefinder->getNumHelpRequestsSent(), cliquefinder->getNumHelpRequestsSentAccepted() );
+	}
+}
+
+/**
+ * MPI reduction operation combining two result records (see RESULT_* in const.h). All fields are summed, except for the
+ * maximum busy time of a process.
+ *
+ * @param void* in Input result record
+ * @param void* inout Input and output result record
+ * @param int* len Number of fields in the result records
+ * @param MPI_Datatype* datatype Data type of the fields, MPI_LONG_LONG
+ */
+void reduceResultRecords( void *in, void *inout, int *len, MPI_Datatype *datatype ) {
+	long long *record_in = (long long *) in;
+	long long *record_inout = (long long *) inout;
+
+	for ( int i = 0; i < *len; i++ ) {
+		if ( i == RESULT_BUSY_TIME_MAX ) {
+			record_inout[ i ] = std::max( record_inout[ i ], record_in[ i ] );
+		}
+		else {
+			record_inout[ i ] += record_in[ i ];
+		}
+	}
+}
+
+std::vector<long long> ProcessSlave::reduceFindCliquesResults() {
+	// Result record of this process, empty if this process did not take part in the computation
+	std::vector<long long> record;
+
+	if ( worker != NULL ) {
+		record = worker->getResultRecord();
+	}
+
+	// Agree on the number of clique sizes, so that all processes contribute records with the same layout
+	int num_clique_sizes = std::max( (int) record.size() - RESULT_CLIQUE_COUNTS, 0 );
+	int num_clique_sizes_max;
+	MPI_Allreduce( &num_clique_sizes, &num_clique_sizes_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+
+	// Pad the clique counts, and combine records of all processes at the master process
+	record.resize( RESULT_CLIQUE_COUNTS + num_clique_sizes_max, 0 );
+
+	return reduceResults( record );
+}
+
+std::vector<long long> ProcessSlave::reduceResults( std::vector<long long> record ) {
+	MPI_Op op;
+	MPI_Op_create( &reduceResultRecords, 1, &op );
+
+	std::vector<long long> record_total( record.size() );
+	MPI_Reduce( &record[0], &record_total[0], record.size(), MPI_LONG_LONG, op, 0, MPI_COMM_WORLD );
+
+	MPI_Op_free( &op );
+
+	return record_total;
+}
+
+std::vector<double> ProcessSlave::gatherRootCosts() {
+	std::vector<double> all_root_costs;
+
+	if ( ! record_root_costs ) {
+		return all_root_costs;
 	}
+
+	std::vector<double> root_costs;
+
+	if ( cliquefinder != NULL ) {
+		root_costs = cliquefinder->getRootCosts();
+	}
+
+	// Gather the number of values, followed by the root task costs themselves
+	int num_values = root_costs.size();
+	std::vector<int> nums_values( num_processes );
+	MPI_Gather( &num_values, 1, MPI_INT, &nums_values[0], 1, MPI_INT, 0, MPI_COMM_WORLD );
+
+	std::vector<int> displacements( num_processes, 0 );
+
+	for ( int i = 1; i < num_processes; i++ ) {
+		displacements[ i ] = displacements[ i - 1 ] + nums_values[ i - 1 ];
+	}
+
+	if ( process_id == 0 ) {
+		all_root_costs.resize( displacements.back() + nums_values.back() );
+	}
+
+	MPI_Gatherv( root_costs.data(), num_values, MPI_DOUBLE, all_root_costs.data(), &nums_values[0], &displacements[0], MPI_DOUBLE, 0, MPI_COMM_WORLD );
+
+	return all_root_costs;
+}
+
+std::string ProcessSlave::reduceRootCostsHeader() {
+	if ( ! record_root_costs ) {
+		return "";
+	}
+
+	// All processes taking part in the computation read the same graph, and the master process may not read it at all
+	std::vector<unsigned long long> graph_summary( 3, 0 );
+	std::vector<unsigned long long> graph_summary_max( 3, 0 );
+
+	if ( cliquefinder != NULL ) {
+		graph_summary = RootProfile::getGraphSummary( graph );
+	}
+
+	MPI_Reduce( &graph_summary[0], &graph_summary_max[0], 3, MPI_UNSIGNED_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD );
+
+	return RootProfile::getHeader( edge_roots, graph_summary_max );
+}
+
+std::vector<double> ProcessSlave::reduceSampleRecords() {
+	std::vector<double> record_total;
+
+	if ( sample_target_error <= 0 ) {
+		return record_total;
+	}
+
+	// Agree on the number of clique sizes, so that all processes contribute records with the same layout
+	SampleEstimate sample_estimate;
+
+	if ( cliquefinder != NULL ) {
+		sample_estimate = cliquefinder->getSampleEstimate();
+	}
+
+	int num_sizes = sample_estimate.getNumSizes();
+	int num_sizes_max;
+	MPI_Allreduce( &num_sizes, &num_sizes_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+
+	// Sum the records of all processes at the master process
+	std::vector<double> record = sample_estimate.getRecord( num_sizes_max );
+	record_total.resize( record.size() );
+	MPI_Reduce( &record[0], &record_total[0], record.size(), MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
+	return record_total;
+}
+
+std::vector<std::vector<long long> > ProcessSlave::reduceNodeCliquesCounts( int &node_id_min, int &num_nodes ) {
+	std::vector<std::vector<long long> > node_cliques_counts;
+	node_id_min = 0;
+	num_nodes = 0;
+
+	if ( ! record_node_counts ) {
+		return node_cliques_counts;
+	}
+
+	// Node clique counts of this process, empty if this process did not take part in the computation or found no cliques
+	std::vector<std::vector<long long> > counts;
+	int counts_node_id_min = 0;
+
+	if ( cliquefinder != NULL ) {
+		counts = cliquefinder->getNodeCliquesCounts();
+		counts_node_id_min = cliquefinder->getNodeCliquesCountsIdMin();
+	}
+
+	// Agree on the node ID range and the range of clique sizes with cliques, so that all processes contribute arrays
+	// with the same layout. The node ID range covers the graph as well, so that nodes are written even if no process
+	// found any cliques. The smallest values are negated, so that a single maximum reduction covers all of them
+	int range_local[4] = { INT_MIN, INT_MIN, INT_MIN, INT_MIN };
+
+	if ( graph != NULL && graph->getNodeIdMax() >= graph->getNodeIdMin() ) {
+		range_local[0] = -graph->getNodeIdMin();
+		range_local[1] = graph->getNodeIdMax();
+	}
+
+	for ( unsigned int size = 0; size < counts.size(); size++ ) {
+		if ( ! counts[ size ].empty() ) {
+			range_local[0] = std::max( range_local[0], -counts_node_id_min );
+			range_local[1] = std::max( range_local[1], counts_node_id_min + (int) counts[ size ].size() - 1 );
+			range_local[2] = std::max( range_local[2], -(int) size );
+			range_local[3] = std::max( range_local[3], (int) size );
+		}
+	}
+
+	int range[4];
+	MPI_Allreduce( range_local, range, 4, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+
+	// The graph has no nodes
+	if ( range[1] == INT_MIN ) {
+		return node_cliques_counts;
+	}
+
+	node_id_min = -range[0];
+	num_nodes = range[1] - node_id_min + 1;
+
+	// No process found any cliques
+	if ( range[3] == INT_MIN ) {
+		return node_cliques_counts;
+	}
+
+	// Sum the counts of each clique size over all processes, within the common node ID range. Every clique size between
+	// the smallest and largest size with cliques has cliques, as every clique contains cliques of all smaller sizes
+	if ( process_id == 0 ) {
+		node_cliques_counts.resize( range[3] + 1 );
+	}
+
+	std::vector<long long> size_counts( num_nodes );
+
+	for ( int size = -range[2]; size <= range[3]; size++ ) {
+		std::fill( size_counts.begin(), size_counts.end(), 0 );
+
+		if ( size < (int) counts.size() ) {
+			std::copy( counts[ size ].begin(), counts[ size ].end(), size_counts.begin() + ( counts_node_id_min - node_id_min ) );
+		}
+
+		if ( process_id == 0 ) {
+			node_cliques_counts[ size ].resize( num_nodes );
+		}
+
+		MPI_Reduce( size_counts.data(), process_id == 0 ? node_cliques_counts[ size ].data() : NULL, num_nodes, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+	}
+
+	return node_cliques_counts;
+}
+
+std::vector<long long> ProcessSlave::transmitNodeExternalIds() {
+	std::vector<long long> node_external_ids;
+
+	if ( ! record_node_counts ) {
+		return node_external_ids;
+	}
+
+	if ( graph != NULL ) {
+		node_external_ids = graph->getExternalNodeIds();
+	}
+
+	if ( getFirstWorkerId() == 0 ) {
+		return node_external_ids;
+	}
+
+	if ( process_id == getFirstWorkerId() ) {
+		MPI_Send( node_external_ids.data(), node_external_ids.size(), MPI_LONG_LONG, 0, MPI_TAG_NODE_EXTERNAL_IDS, MPI_COMM_WORLD );
+	}
+	else if ( process_id == 0 ) {
+		MPI_Status status;
+		int num_nodes;
+		MPI_Probe( getFirstWorkerId(), MPI_TAG_NODE_EXTERNAL_IDS, MPI_COMM_WORLD, &status );
+		MPI_Get_count( &status, MPI_LONG_LONG, &num_nodes );
+
+		node_external_ids.resize( num_nodes );
+		MPI_Recv( node_external_ids.data(), num_nodes, MPI_LONG_LONG, getFirstWorkerId(), MPI_TAG_NODE_EXTERNAL_IDS, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+	}
+
+	return node_external_ids;
+}
+
+#ifdef CLIQUES_STATS
+std::vector<long long> ProcessSlave::reduceSearchStats() {
+	SearchStats stats;
+
+	if ( cliquefinder != NULL ) {
+		stats = cliquefinder->stats;
+	}
+
+	// Agree on the number of depths, so that all processes contribute records with the same layout
+	int num_depths = stats.getNumDepths();
+	int num_depths_max;
+	MPI_Allreduce( &num_depths, &num_depths_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+
+	std::vector<long long> record = stats.getRecord( num_depths_max );
+	std::vector<long long> record_total( record.size() );
+	MPI_Reduce( &record[0], &record_total[0], record.size(), MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+
+	return record_total;
+}
+#endif
+
+std::vector<std::vector<double> > ProcessSlave::gatherHelpRequestThresholdTrajectories() {
+	std::vector<std::vector<double> > help_threshold_trajectories;
+
+	if ( ! help_threshold_adaptive ) {
+		return help_threshold_trajectories;
+	}
+
+	std::vector<double> help_threshold_trajectory;
+
+	if ( cliquefinder != NULL ) {
+		help_threshold_trajectory = cliquefinder->getHelpRequestThresholdTrajectory();
+	}
+
+	// Gather trajectory lengths, followed by the trajectories themselves
+	int num_trajectory_values = help_threshold_trajectory.size();
+	std::vector<int> nums_trajectory_values( num_processes );
+	MPI_Gather( &num_trajectory_values, 1, MPI_INT, &nums_trajectory_values[0], 1, MPI_INT, 0, MPI_COMM_WORLD );
+
+	std::vector<int> displacements( num_processes, 0 );
+
+	for ( int i = 1; i < num_processes; i++ ) {
+		displacements[ i ] = displacements[ i - 1 ] + nums_trajectory_values[ i - 1 ];
+	}
+
+	std::vector<double> trajectories( displacements.back() + nums_trajectory_values.back() + 1 );
+	MPI_Gatherv( help_threshold_trajectory.data(), num_trajectory_values, MPI_DOUBLE, &trajectories[0], &nums_trajectory_values[0], &displacements[0], MPI_DOUBLE, 0, MPI_COMM_WORLD );
+
+	if ( process_id == 0 ) {
+		for ( int i = getFirstWorkerId(); i < num_processes; i++ ) {
+			help_threshold_trajectories.push_back( std::vector<double>( trajectories.begin() + displacements[ i ], trajectories.begin() + displacements[ i ] + nums_trajectory_values[ i ] ) );
+		}
+	}
+
+	return help_threshold_trajectories;
 }
@@ -9,28 +9,45 @@
 #include "Process.h"
 #include "../Graph/Graph.h"
 #include "../CliqueFinder/CliqueFinder.h"
+#include "../Transport/Transport.h"
+#include "../Transport/Worker.h"
 
 // Temporary class definitions
 // ==========
 class Graph;
 class CliqueFinder;
 
-class ProcessSlave : public Process {
+class ProcessSlave : public Process, public Transport {
 	protected:
 		/**
 		 * The graph on which calculations have to be done
 		 */
-		Graph *graph;
+		Graph *graph = NULL;
 		
 		/**
 		 * The object implementing the clique finding using the graph
 		 */
-		CliqueFinder *cliquefinder;
+		CliqueFinder *cliquefinder = NULL;
 
 		/**
-		 * ID of the process currently helping or available for helping complete this process's subtask
+		 * The worker driving the clique finder, with this process as its transport
 		 */
-		int helper_process_id;
+		Worker *worker = NULL;
+
+		/**
+		 * The writer listing the cliques found by the clique finder, or NULL if cliques are only counted
+		 */
+		CliqueWriter *clique_writer = NULL;
+
+		/**
+		 * The checkpointer of the clique finder and the worker, or NULL if checkpointing is disabled
+		 */
+		Checkpointer *checkpointer = NULL;
+
+		/**
+		 * Root cost profile by which the root tasks are partitioned, if one is given and was recorded on the graph
+		 */
+		RootProfile root_profile;
 
 	public:
 		ProcessSlave( int process_id, int num_processes ) : Process( process_id, num_processes ) {}
@@ -45,6 +62,18 @@ class ProcessSlave : public Process {
 		 */
 		void handleInputFilePath( std::string dataset_name, std::string file_path );
 
+		/**
+		 * Perform this process's part of the computation: read the graph, find the cliques in the assigned subtask and
+		 * help other processes until all processing is completed
+		 */
+		void performFindCliques();
+
+		/**
+		 * Construct the broker for the host of this process, managing the processes on the host taking part in the
+		 * computation. Should only be called on the host broker process
+		 */
+		void createHostBroker();
+
 		/**
 		 * Receive file path from master process
 		 */
@@ -73,36 +102,130 @@ class ProcessSlave : public Process {
 		void findCliques();
 
 		/**
-		 * Send a help request to other processes through the main process. Returns true if other processes are available,
-		 * false otherwise. If another process is available, it is immediately reserved by the master process. Thus, any help
-		 * request formed through this method should be followed by granting the help request through the grantHelp() method.
+		 * Send a help request to other processes through the main process, or claim an idle process directly through the
+		 * helper registry. If another process is available, it is immediately reserved
 		 *
-		 * If a process is available for help, store the process ID in helper_process_id.
+		 * @see Transport::requestHelper()
+		 */
+		int requestHelper();
+
+		/**
+		 * Send the help task to the helping process
+		 *
+		 * @see Transport::sendHelpTask()
+		 */
+		void sendHelpTask( int helper_id, HelpTask &task );
+
+		/**
+		 * Wait for either a process sending a help task, or the master process signalling that all processing is
+		 * completed
 		 *
-		 * @return bool Whether other processes are available
+		 * @see Transport::receiveHelpTask()
 		 */
-		bool requestHelp();
+		bool receiveHelpTask( HelpTask &task );
 
 		/**
+		 * @see Transport::reportDone()
+		 */
+		void reportDone();
+
+		/**
+		 * Combine the result records of all processes at the master process, using a single reduction with a custom
+		 * MPI operation. Should be called by all processes, with records of the same length
 		 *
+		 * @see Transport::reduceResults()
 		 */
-		void grantHelp( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int helper_start, int helper_end );
+		std::vector<long long> reduceResults( std::vector<long long> record );
 
 		/**
 		 * Transmit a message to the master process that the slave process has completed its initially assigned subtask
+		 * or the subtask it was helping with, or mark the process as idle in the helper registry
 		 */
 		void transmitSubtaskCompleted();
 
 		/**
-		 * Continually probe the master process to see if the slave process can assist other processes. If it can, take
-		 * over part of another process's subtask
+		 * Transmit messages to all processes taking part in the computation that all clique finding has been completed
+		 */
+		void transmitFindCliquesComplete();
+
+		/**
+		 * Transmit the list of cliques per clique size and help request statistics to the master process
+		 */
+		virtual void transmitFindCliquesResult();
+
+		/**
+		 * Combine the result records of all processes at the master process, using a single reduction. A result record
+		 * contains the help request counts, busy time and clique counts per clique size, padded to the largest clique
+		 * size found by any process (see RESULT_* in const.h). Should be called by all processes.
+		 *
+		 * @return vector<long long> Combined result record. Only valid at the master process
+		 */
+		std::vector<long long> reduceFindCliquesResults();
+
+		/**
+		 * Gather the trajectories of the adaptive help request threshold of all processes taking part in the computation
+		 * at the master process. Should be called by all processes.
+		 *
+		 * @return vector<vector<double> > Trajectory per process. Only filled at the master process
 		 */
-		void standbyForHelpRequest();
+		std::vector<std::vector<double> > gatherHelpRequestThresholdTrajectories();
 
 		/**
-		 * Transmit the list of cliques per clique size to the master process
+		 * Gather the costs of the root tasks of all processes taking part in the computation at the master process, if
+		 * recording root task costs is enabled. Should be called by all processes.
+		 *
+		 * @return vector<double> Root ID, number of candidate nodes, time in seconds and number of search tree nodes per
+		 * root task. Only filled at the master process
 		 */
-		void transmitFindCliquesResult();
+		std::vector<double> gatherRootCosts();
+
+		/**
+		 * Get the header line of the root task costs at the master process, identifying the graph read by the processes
+		 * taking part in the computation, if recording root task costs is enabled. Should be called by all processes.
+		 *
+		 * @return std::string Header line, see RootProfile::getHeader(). Only filled at the master process
+		 */
+		std::string reduceRootCostsHeader();
+
+		/**
+		 * Combine the node clique counts of all processes taking part in the computation at the master process by
+		 * summing them over the node ID range, if recording node clique counts is enabled. Should be called by all
+		 * processes.
+		 *
+		 * @param int& node_id_min Output. Smallest node ID of the combined node clique counts
+		 * @param int& num_nodes Output. Number of nodes in the node ID range, also if no process found any cliques
+		 * @return vector<vector<long long> > Node clique counts, indexed by clique size and by node ID minus the smallest
+		 * node ID. Only filled at the master process
+		 */
+		std::vector<std::vector<long long> > reduceNodeCliquesCounts( int &node_id_min, int &num_nodes );
+
+		/**
+		 * Get the external node IDs of the graph at the master process, with which the node clique counts are written,
+		 * if recording node clique counts is enabled. A master process that does not take part in the computation does
+		 * not read the graph, and receives them from the first worker. Should be called by all processes.
+		 *
+		 * @return vector<long long> External node ID per node ID, see Graph::getExternalNodeIds(). Only filled at the
+		 * master process
+		 */
+		std::vector<long long> transmitNodeExternalIds();
+
+		/**
+		 * Combine the sampling records of all processes at the master process by summing them (see SAMPLE_* in
+		 * SampleEstimate.h), if sampling is enabled. Should be called by all processes.
+		 *
+		 * @return vector<double> Combined sampling record. Only valid at the master process
+		 */
+		std::vector<double> reduceSampleRecords();
+
+#ifdef CLIQUES_STATS
+		/**
+		 * Combine the search statistics of all processes at the master process by summing them (see STATS_* in
+		 * SearchStats.h). Should be called by all processes.
+		 *
+		 * @return vector<long long> Combined statistics record. Only valid at the master process
+		 */
+		std::vector<long long> reduceSearchStats();
+#endif
 };
 
 #endif
@@ -0,0 +1,40 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+// Program includes
+#include "ProgressRegistry.h"
+
+ProgressRegistry::ProgressRegistry( int process_id, int num_workers ) : ProgressBoard( num_workers ) {
+	// Only the master process exposes the registry
+	int win_size = ( process_id == 0 ) ? num_workers * PROGRESS_RECORD_SIZE : 0;
+	MPI_Win_allocate( win_size * sizeof( long long ), sizeof( long long ), MPI_INFO_NULL, MPI_COMM_WORLD, &win_memory, &win );
+
+	for ( int i = 0; i < win_size; i++ ) {
+		win_memory[ i ] = 0;
+	}
+
+	// Ensure the registry is initialized before any process accesses it
+	MPI_Barrier( MPI_COMM_WORLD );
+	MPI_Win_lock_all( 0, win );
+}
+
+ProgressRegistry::~ProgressRegistry() {
+	MPI_Win_unlock_all( win );
+	MPI_Win_free( &win );
+}
+
+void ProgressRegistry::publish( int worker_id, const std::vector<long long> &record ) {
+	// Atomically replace the record of the worker process, so the master process never reads a partially written record
+	MPI_Accumulate( &record[0], PROGRESS_RECORD_SIZE, MPI_LONG_LONG, 0, worker_id * PROGRESS_RECORD_SIZE, PROGRESS_RECORD_SIZE, MPI_LONG_LONG, MPI_REPLACE, win );
+	MPI_Win_flush( 0, win );
+}
+
+std::vector<long long> ProgressRegistry::read() {
+	// Atomically fetch the records of all worker processes
+	MPI_Get_accumulate( NULL, 0, MPI_LONG_LONG, &records[0], num_workers * PROGRESS_RECORD_SIZE, MPI_LONG_LONG, 0, 0, num_workers * PROGRESS_RECORD_SIZE, MPI_LONG_LONG, MPI_NO_OP, win );
+	MPI_Win_flush( 0, win );
+
+	return records;
+}
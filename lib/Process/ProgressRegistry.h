@@ -0,0 +1,64 @@
+#ifndef PROGRESSREGISTRY_H
+#define PROGRESSREGISTRY_H
+
+// Includes
+// ==========
+// MPI includes
+#include <mpi.h>
+
+// STL includes
+#include <vector>
+
+// Program includes
+#include "../Progress/ProgressBoard.h"
+
+/**
+ * Progress board shared by all MPI processes. The records are exposed through an MPI window located at the master
+ * process, to which every worker process writes its own record with one-sided operations, so publishing never waits for the
+ * master process
+ */
+class ProgressRegistry : public ProgressBoard {
+	private:
+		/**
+		 * MPI window exposing the progress records, which is located at the master process
+		 * Format: see ProgressBoard::records, with one record per worker process
+		 */
+		MPI_Win win;
+
+		/**
+		 * Local memory of the window. Only the master process exposes any memory
+		 */
+		long long *win_memory;
+
+	public:
+		/**
+		 * Constructor. Collectively creates the registry window, with all progress records zeroed. Should be called by
+		 * all processes.
+		 *
+		 * @param int process_id MPI ID of the process
+		 * @param int num_workers Number of processes taking part in the computation
+		 */
+		ProgressRegistry( int process_id, int num_workers );
+
+		/**
+		 * Destructor. Collectively frees the registry window. Should be called by all processes.
+		 */
+		~ProgressRegistry();
+
+		/**
+		 * Publish the progress record of a worker process
+		 *
+		 * @param int worker_id Index of the process among the processes taking part in the computation
+		 * @param const std::vector<long long>& record Progress record, of PROGRESS_RECORD_SIZE fields
+		 */
+		void publish( int worker_id, const std::vector<long long> &record );
+
+		/**
+		 * Read the latest progress records of all worker processes
+		 *
+		 * @return std::vector<long long> Progress records, see ProgressBoard::records
+		 */
+		std::vector<long long> read();
+};
+
+#endif
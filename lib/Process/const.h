@@ -1,3 +1,6 @@
+#ifndef CONST_H
+#define CONST_H
+
 const int MPI_TAG_GRAPH_PROCESSING_DONE				= 10;
 const int MPI_TAG_GRAPH_REQUEST_HELP				= 11;
 const int MPI_TAG_GRAPH_REQUEST_HELP_RESPONSE		= 12;
@@ -7,11 +10,43 @@ const int MPI_TAG_GRAPH_HELP_DATA_POTENTIAL_NODES	= 15;
 const int MPI_TAG_GRAPH_HELP_DATA_START				= 16;
 const int MPI_TAG_GRAPH_HELP_DATA_END				= 17;
 const int MPI_TAG_ALL_PROCESSING_COMPLETED			= 18;
-const int MPI_TAG_CLIQUE_COUNTS						= 19;
-const int MPI_TAG_HELP_REQUESTS_SENT				= 20;
-const int MPI_TAG_HELP_REQUESTS_SENT_ACCEPTED		= 21;
-const int MPI_TAG_HELP_REQUESTS_SENT_REJECTED		= 22;
+const int MPI_TAG_GRAPH_HELP_DATA_CHECKPOINT_EPOCH	= 19;
+const int MPI_TAG_REQUEST_REMOTE_HELP				= 23;
+const int MPI_TAG_CLAIM_HOST_HELPER					= 24;
+const int MPI_TAG_IDLE_HOSTS_AVAILABLE				= 25;
+const int MPI_TAG_HOST_IDLE							= 26;
+const int MPI_TAG_NODE_EXTERNAL_IDS					= 27;
 
 const int PROCESS_IDLE = 0;
 const int PROCESS_RUNNING = 1;
-const int PROCESS_HELPING = 2;
\ No newline at end of file
+const int PROCESS_HELPING = 2;
+
+// Fields of the result record of a process, followed by the number of cliques per clique size
+const int RESULT_HELP_REQUESTS_SENT = 0;
+const int RESULT_HELP_REQUESTS_SENT_ACCEPTED = 1;
+const int RESULT_HELP_REQUESTS_SENT_REJECTED = 2;
+const int RESULT_BUSY_TIME_MAX = 3;
+const int RESULT_BUSY_TIME_TOTAL = 4;
+const int RESULT_CHECKPOINTS_WRITTEN = 5;
+const int RESULT_CHECKPOINT_TIME_TOTAL = 6;
+const int RESULT_CHECKPOINT_WRITE_TIME_TOTAL = 7;
+const int RESULT_DEADLINE_REACHED = 8;
+const int RESULT_ROOTS_TOTAL = 9;
+const int RESULT_ROOTS_COMPLETED = 10;
+const int RESULT_WORK_TOTAL = 11;
+const int RESULT_WORK_COMPLETED = 12;
+const int RESULT_CLIQUE_COUNTS = 13;
+
+const int LOAD_BALANCER_MASTER = 0;
+const int LOAD_BALANCER_RMA = 1;
+const int LOAD_BALANCER_HOST = 2;
+
+// Policies for choosing an idle process to help a process requesting help
+const int HELP_MATCH_FIRST = 0;
+const int HELP_MATCH_ROUND_ROBIN = 1;
+const int HELP_MATCH_NEAREST = 2;
+
+// Maximum time (in microseconds) the coordinator sleeps between probes for new messages
+const int COORDINATOR_MAX_SLEEP_TIME = 200;
+
+#endif
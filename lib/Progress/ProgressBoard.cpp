@@ -0,0 +1,27 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+// Program includes
+#include "ProgressBoard.h"
+
+ProgressBoard::ProgressBoard( int num_workers ) : num_workers(num_workers) {
+	records.resize( num_workers * PROGRESS_RECORD_SIZE, 0 );
+}
+
+void ProgressBoard::publish( int worker_id, const std::vector<long long> &record ) {
+	std::lock_guard<std::mutex> lock( mutex );
+	std::copy( record.begin(), record.begin() + PROGRESS_RECORD_SIZE, records.begin() + worker_id * PROGRESS_RECORD_SIZE );
+}
+
+std::vector<long long> ProgressBoard::read() {
+	std::lock_guard<std::mutex> lock( mutex );
+	return records;
+}
+
+int ProgressBoard::getNumWorkers() {
+	return num_workers;
+}
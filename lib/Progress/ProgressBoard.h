@@ -0,0 +1,79 @@
+#ifndef PROGRESSBOARD_H
+#define PROGRESSBOARD_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <mutex>
+
+// Fields of the progress record of a worker
+// ==========
+const int PROGRESS_ROOTS_TOTAL = 0;
+const int PROGRESS_ROOTS_COMPLETED = 1;
+const int PROGRESS_WORK_TOTAL = 2;
+const int PROGRESS_WORK_COMPLETED = 3;
+const int PROGRESS_EDGE_CHECKS = 4;
+const int PROGRESS_RECORD_SIZE = 5;
+
+/**
+ * Board to which every worker publishes its progress record (see PROGRESS_* above), from which the progress of the
+ * computation is read while it runs. Publishing overwrites the previous record of the worker, and neither publishing
+ * nor reading waits for the other side, so that workers never block on the reader. This board is shared by the threads
+ * of a single process; ProgressRegistry exposes it to MPI processes
+ */
+class ProgressBoard {
+	protected:
+		/**
+		 * Number of workers taking part in the computation
+		 */
+		int num_workers;
+
+		/**
+		 * Latest progress record of every worker
+		 * Format: [worker_id * PROGRESS_RECORD_SIZE + field] => [value]
+		 */
+		std::vector<long long> records;
+
+		/**
+		 * Lock of the records
+		 */
+		std::mutex mutex;
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param int num_workers Number of workers taking part in the computation
+		 */
+		ProgressBoard( int num_workers );
+
+		/**
+		 * Destructor
+		 */
+		virtual ~ProgressBoard() {}
+
+		/**
+		 * Publish the progress record of a worker
+		 *
+		 * @param int worker_id Index of the worker among the workers taking part in the computation
+		 * @param const std::vector<long long>& record Progress record, of PROGRESS_RECORD_SIZE fields
+		 */
+		virtual void publish( int worker_id, const std::vector<long long> &record );
+
+		/**
+		 * Read the latest progress records of all workers
+		 *
+		 * @return std::vector<long long> Progress records, see records
+		 */
+		virtual std::vector<long long> read();
+
+		/**
+		 * Get the number of workers taking part in the computation
+		 *
+		 * @return int Number of workers
+		 */
+		int getNumWorkers();
+};
+
+#endif
@@ -0,0 +1,105 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+
+// Program includes
+#include "ProgressReporter.h"
+
+ProgressReporter::ProgressReporter( ProgressBoard *board, double interval, int id_offset ) : board(board), interval(interval), id_offset(id_offset) {
+}
+
+ProgressReporter::~ProgressReporter() {
+	stop();
+}
+
+void ProgressReporter::start() {
+	pm.reset();
+	previous_time = pm.getStartTime();
+	reporter_thread = std::thread( &ProgressReporter::run, this );
+}
+
+void ProgressReporter::stop() {
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		stopping = true;
+	}
+
+	condition.notify_all();
+
+	if ( reporter_thread.joinable() ) {
+		reporter_thread.join();
+	}
+}
+
+void ProgressReporter::run() {
+	std::unique_lock<std::mutex> lock( mutex );
+
+	while ( ! condition.wait_for( lock, std::chrono::duration<double>( interval ), [this]() { return stopping; } ) ) {
+		report();
+	}
+}
+
+void ProgressReporter::report() {
+	std::vector<long long> records = board->read();
+	int num_workers = board->getNumWorkers();
+	double time = pm.getCurrentClockTime();
+
+	// Totals of all workers, and the work left per worker
+	std::vector<long long> totals( PROGRESS_RECORD_SIZE, 0 );
+	std::vector<std::pair<long long, int> > work_left;
+
+	for ( int i = 0; i < num_workers; i++ ) {
+		const long long *record = &records[ i * PROGRESS_RECORD_SIZE ];
+
+		for ( int field = 0; field < PROGRESS_RECORD_SIZE; field++ ) {
+			totals[ field ] += record[ field ];
+		}
+
+		if ( record[ PROGRESS_WORK_TOTAL ] > record[ PROGRESS_WORK_COMPLETED ] ) {
+			work_left.push_back( std::make_pair( record[ PROGRESS_WORK_TOTAL ] - record[ PROGRESS_WORK_COMPLETED ], i ) );
+		}
+	}
+
+	// Workers only publish their records once they have started their search
+	if ( totals[ PROGRESS_WORK_TOTAL ] == 0 && totals[ PROGRESS_EDGE_CHECKS ] == 0 ) {
+		return;
+	}
+
+	double fraction = ( totals[ PROGRESS_WORK_TOTAL ] > 0 ) ? std::min( (double) totals[ PROGRESS_WORK_COMPLETED ] / totals[ PROGRESS_WORK_TOTAL ], 1.0 ) : 0;
+	double throughput = ( time > previous_time ) ? ( totals[ PROGRESS_EDGE_CHECKS ] - previous_edge_checks ) / ( time - previous_time ) : 0;
+
+	previous_time = time;
+	previous_edge_checks = totals[ PROGRESS_EDGE_CHECKS ];
+
+	// The remaining time follows from the rate at which the fraction of the work completed has grown since the first
+	// progress line, which leaves out the time spent before the search started
+	std::string eta = "unknown";
+
+	if ( first_time < 0 ) {
+		first_time = time;
+		first_fraction = fraction;
+	}
+	else if ( fraction > first_fraction ) {
+		char eta_buffer[64];
+		snprintf( eta_buffer, sizeof( eta_buffer ), "%.1f s", ( 1 - fraction ) * ( time - first_time ) / ( fraction - first_fraction ) );
+		eta = eta_buffer;
+	}
+
+	// Workers with the most work left, relative to the total work
+	std::sort( work_left.rbegin(), work_left.rend() );
+	std::string slowest = "";
+
+	for ( int i = 0; i < (int) work_left.size() && i < PROGRESS_NUM_SLOWEST; i++ ) {
+		char slowest_buffer[64];
+		snprintf( slowest_buffer, sizeof( slowest_buffer ), "%s%d (%.1f%% left)", ( i > 0 ) ? ", " : "", work_left[ i ].second + id_offset, 100.0 * work_left[ i ].first / totals[ PROGRESS_WORK_TOTAL ] );
+		slowest += slowest_buffer;
+	}
+
+	printf( "Progress: %.1f s, %.2f%% of the estimated work (%lld/%lld root tasks), %.3g edge checks/s, ETA %s%s%s\n", time - pm.getStartTime(), fraction * 100, totals[ PROGRESS_ROOTS_COMPLETED ], totals[ PROGRESS_ROOTS_TOTAL ], throughput, eta.c_str(), slowest != "" ? ", slowest: " : "", slowest.c_str() );
+	fflush( stdout );
+}
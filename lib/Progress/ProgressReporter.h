@@ -0,0 +1,103 @@
+#ifndef PROGRESSREPORTER_H
+#define PROGRESSREPORTER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Program includes
+#include "ProgressBoard.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+
+// Number of workers with the most work left listed in a progress line
+const int PROGRESS_NUM_SLOWEST = 3;
+
+/**
+ * Background thread periodically reading the progress records of all workers from a progress board, and printing a
+ * progress line with the fraction of the estimated work completed, the throughput in edge checks per second, the
+ * estimated time left and the workers with the most work left
+ */
+class ProgressReporter {
+	protected:
+		/**
+		 * Board holding the progress records of the workers
+		 */
+		ProgressBoard *board;
+
+		/**
+		 * Time (in seconds) between two progress lines
+		 */
+		double interval;
+
+		/**
+		 * Offset added to the worker indices to obtain the IDs printed, i.e. the ID of the first worker
+		 */
+		int id_offset;
+
+		/**
+		 * Clock time and fraction of the work completed at the first progress line after the search started, from which
+		 * the remaining time is estimated, or a negative time if the search has not started yet
+		 */
+		double first_time = -1;
+		double first_fraction = 0;
+
+		/**
+		 * Clock time and number of edge checks at the previous progress line, from which the throughput is measured
+		 */
+		double previous_time = 0;
+		long long previous_edge_checks = 0;
+
+		/**
+		 * Background thread, and the synchronisation for stopping it
+		 */
+		std::thread reporter_thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool stopping = false;
+
+		/**
+		 * Progress monitor object to track time
+		 */
+		ProgressMonitor pm;
+
+		/**
+		 * Main loop of the background thread
+		 */
+		void run();
+
+		/**
+		 * Print a progress line from the current progress records, unless the search has not started yet
+		 */
+		void report();
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param ProgressBoard* board Board holding the progress records of the workers
+		 * @param double interval Time (in seconds) between two progress lines
+		 * @param int id_offset Optional. ID of the first worker, added to the worker indices printed
+		 */
+		ProgressReporter( ProgressBoard *board, double interval, int id_offset = 0 );
+
+		/**
+		 * Destructor. Stops the background thread
+		 */
+		~ProgressReporter();
+
+		/**
+		 * Start the background thread
+		 */
+		void start();
+
+		/**
+		 * Stop the background thread, without printing a final progress line
+		 */
+		void stop();
+};
+
+#endif
@@ -9,7 +9,7 @@
 #include <stdio.h>
 
 // Program includes
-#include "progressmonitor.h"
+#include "ProgressMonitor.h"
 
 // OS-dependent includes
 #ifdef __MACH__
@@ -66,6 +66,10 @@ double ProgressMonitor::lap() {
 	}
 }
 
+double ProgressMonitor::getStartTime() {
+	return start;
+}
+
 double ProgressMonitor::stop() {
 	end = getCurrentClockTime();
 
@@ -51,6 +51,13 @@ class ProgressMonitor {
 		 */
 		double stop();
 
+		/**
+		 * Get the time (in seconds) the monitor started recording.
+		 *
+		 * @return double Start time
+		 */
+		double getStartTime();
+
 		/**
 		 * Get the current clock time in seconds.
 		 *
@@ -0,0 +1,394 @@
+// Includes
+// ==========
+// STL includes
+#include <fstream>
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+
+// Program includes
+#include "ResultsReport.h"
+#include "../Process/const.h"
+#include "../CliqueFinder/SearchStats.h"
+#include "../CliqueFinder/SampleEstimate.h"
+#include "../Planner/RootProfile.h"
+
+std::vector<long long> ResultsReport::getCliquesCounts() {
+	if ( sample_record.empty() ) {
+		return std::vector<long long>( record.begin() + RESULT_CLIQUE_COUNTS, record.end() );
+	}
+
+	SampleEstimate sample_estimate( sample_record );
+	std::vector<long long> cliques_counts;
+
+	for ( int size = 0; size < sample_estimate.getNumSizes(); size++ ) {
+		cliques_counts.push_back( llround( sample_estimate.getEstimate( size ) ) );
+	}
+
+	return cliques_counts;
+}
+
+std::vector<double> ResultsReport::getCliquesCountsHalfWidths() {
+	if ( sample_record.empty() ) {
+		return std::vector<double>( getCliquesCounts().size(), 0 );
+	}
+
+	SampleEstimate sample_estimate( sample_record );
+	std::vector<double> half_widths;
+
+	for ( int size = 0; size < sample_estimate.getNumSizes(); size++ ) {
+		half_widths.push_back( sample_estimate.getHalfWidth( size, sample_confidence ) );
+	}
+
+	return half_widths;
+}
+
+long long ResultsReport::getNumCliquesTotal() {
+	if ( ! sample_record.empty() ) {
+		return llround( SampleEstimate( sample_record ).getEstimate( -1 ) );
+	}
+
+	long long num_cliques_total = 0;
+
+	for ( long long count : getCliquesCounts() ) {
+		num_cliques_total += count;
+	}
+
+	return num_cliques_total;
+}
+
+double ResultsReport::getNumCliquesTotalHalfWidth() {
+	if ( sample_record.empty() ) {
+		return 0;
+	}
+
+	return SampleEstimate( sample_record ).getHalfWidth( -1, sample_confidence );
+}
+
+long long ResultsReport::getNumHelpRequestsSent() {
+	return record[ RESULT_HELP_REQUESTS_SENT ];
+}
+
+long long ResultsReport::getNumHelpRequestsSentAccepted() {
+	return record[ RESULT_HELP_REQUESTS_SENT_ACCEPTED ];
+}
+
+long long ResultsReport::getNumHelpRequestsSentRejected() {
+	return record[ RESULT_HELP_REQUESTS_SENT_REJECTED ];
+}
+
+double ResultsReport::getBusyTimeMax() {
+	return record[ RESULT_BUSY_TIME_MAX ] / 1000000.0;
+}
+
+double ResultsReport::getBusyTimeAverage() {
+	return record[ RESULT_BUSY_TIME_TOTAL ] / 1000000.0 / num_workers;
+}
+
+long long ResultsReport::getNumCheckpointsWritten() {
+	return record[ RESULT_CHECKPOINTS_WRITTEN ];
+}
+
+double ResultsReport::getCheckpointTimeAverage() {
+	return record[ RESULT_CHECKPOINT_TIME_TOTAL ] / 1000000.0 / num_workers;
+}
+
+double ResultsReport::getCheckpointWriteTimeAverage() {
+	return record[ RESULT_CHECKPOINT_WRITE_TIME_TOTAL ] / 1000000.0 / num_workers;
+}
+
+bool ResultsReport::isPartial() {
+	return record[ RESULT_DEADLINE_REACHED ] > 0;
+}
+
+long long ResultsReport::getNumRootsTotal() {
+	return record[ RESULT_ROOTS_TOTAL ];
+}
+
+long long ResultsReport::getNumRootsCompleted() {
+	return record[ RESULT_ROOTS_COMPLETED ];
+}
+
+double ResultsReport::getWorkCompletedFraction() {
+	return ( record[ RESULT_WORK_TOTAL ] > 0 ) ? (double) record[ RESULT_WORK_COMPLETED ] / record[ RESULT_WORK_TOTAL ] : 1;
+}
+
+void ResultsReport::addNodeCliquesCounts( int counts_node_id_min, const std::vector<std::vector<long long> > &counts ) {
+	if ( node_cliques_counts.size() < counts.size() ) {
+		node_cliques_counts.resize( counts.size() );
+	}
+
+	for ( unsigned int size = 0; size < counts.size(); size++ ) {
+		if ( counts[ size ].empty() ) {
+			continue;
+		}
+
+		// Workers of the same computation share the node ID range, so the first worker with cliques of a size sets it
+		if ( node_cliques_counts[ size ].empty() ) {
+			node_cliques_counts[ size ].resize( counts[ size ].size(), 0 );
+			node_id_min = counts_node_id_min;
+		}
+
+		for ( unsigned int i = 0; i < counts[ size ].size(); i++ ) {
+			node_cliques_counts[ size ][ i ] += counts[ size ][ i ];
+		}
+	}
+}
+
+void ResultsReport::write() {
+	std::vector<long long> cliques_counts = getCliquesCounts();
+	std::vector<double> cliques_counts_half_widths = getCliquesCountsHalfWidths();
+
+	// Report clique counts, with the confidence interval of estimated counts
+	if ( verbose ) {
+		for ( unsigned int i = 0; i < cliques_counts.size(); i++ ) {
+			if ( sample_record.empty() ) {
+				printf( "Number of %u-cliques: %lld\n", i, cliques_counts[ i ] );
+			}
+			else {
+				printf( "Number of %u-cliques: %lld +- %.0f\n", i, cliques_counts[ i ], cliques_counts_half_widths[ i ] );
+			}
+		}
+	}
+
+	// Write results to file
+	if ( results_output_fname != "" && results_output_fname != "0" ) {
+		writeLog();
+	}
+
+	if ( root_costs_output_fname != "" && root_costs_output_fname != "0" ) {
+		writeRootCosts();
+	}
+
+	if ( node_counts_output_fname != "" && node_counts_output_fname != "0" ) {
+		writeNodeCliquesCounts();
+	}
+
+	// Write final results
+	printf( "Total number of cliques: %lld\n", getNumCliquesTotal() );
+
+	if ( isPartial() ) {
+		printf( "Partial result: deadline reached after %lld of %lld root tasks (%.2f%% of the estimated work); the counts hold the cliques of the completed tasks.\n", getNumRootsCompleted(), getNumRootsTotal(), getWorkCompletedFraction() * 100 );
+	}
+
+	if ( ! sample_record.empty() ) {
+		SampleEstimate sample_estimate( sample_record );
+		double estimate = sample_estimate.getEstimate( -1 );
+		double half_width = getNumCliquesTotalHalfWidth();
+		double relative_error = ( estimate > 0 ) ? half_width / estimate : 0;
+
+		printf( "Estimated from %lld sampled root tasks: %.0f +- %.0f (%.2f%% relative error at %.0f%% confidence)\n", sample_estimate.getNumSamples(), estimate, half_width, relative_error * 100, sample_confidence * 100 );
+
+		if ( relative_error > sample_target_error ) {
+			printf( "Target relative error of %.2f%% not reached within the sample budget.\n", sample_target_error * 100 );
+		}
+	}
+
+	if ( verbose ) {
+		printf( "Requests: %lld/%lld accepted (%lld rejected)\n", getNumHelpRequestsSentAccepted(), getNumHelpRequestsSent(), getNumHelpRequestsSentRejected() );
+
+		// Load balance: the busy time of the busiest worker compared to the average busy time
+		printf( "Busy time: %.5f seconds maximum, %.5f seconds average per process\n", getBusyTimeMax(), getBusyTimeAverage() );
+
+		// Checkpointing overhead: the time the search waited for taking snapshots, relative to the busy time
+		if ( getNumCheckpointsWritten() > 0 ) {
+			double overhead = ( getBusyTimeAverage() > 0 ) ? getCheckpointTimeAverage() / getBusyTimeAverage() : 0;
+			printf( "Checkpoints: %lld snapshots written, %.5f seconds average per process taking them (%.2f%% of busy time), %.5f seconds writing them in the background\n", getNumCheckpointsWritten(), getCheckpointTimeAverage(), overhead * 100, getCheckpointWriteTimeAverage() );
+		}
+
+		if ( help_threshold_adaptive ) {
+			printf( "Final help request thresholds:" );
+
+			for ( const auto &help_threshold_trajectory : help_threshold_trajectories ) {
+				printf( " %d", int( help_threshold_trajectory.back() ) );
+			}
+
+			printf( "\n" );
+		}
+
+#ifdef CLIQUES_STATS
+		int stats_num_depths = ( stats.size() - STATS_DEPTHS ) / STATS_DEPTH_SIZE;
+
+		printf( "Edge checks: %lld\n", stats[ STATS_EDGE_CHECKS ] );
+		printf( "Help transfers: %lld bytes sent, %.5f seconds blocked in help requests\n", stats[ STATS_HELP_BYTES_SENT ], stats[ STATS_HELP_REQUEST_TIME ] / 1000000.0 );
+
+		for ( int depth = 0; depth < stats_num_depths; depth++ ) {
+			if ( stats[ STATS_DEPTHS + depth * STATS_DEPTH_SIZE ] == 0 ) {
+				continue;
+			}
+
+			printf( "Depth %d: %lld nodes visited, candidate set sizes (log2 buckets):", depth, stats[ STATS_DEPTHS + depth * STATS_DEPTH_SIZE ] );
+
+			for ( int bucket = 0; bucket < STATS_NUM_BUCKETS; bucket++ ) {
+				printf( " %lld", stats[ STATS_DEPTHS + depth * STATS_DEPTH_SIZE + 1 + bucket ] );
+			}
+
+			printf( "\n" );
+		}
+#endif
+	}
+
+	printf( "%.5f seconds past\n", time_past );
+	printf( "\n" );
+}
+
+void ResultsReport::writeLog() {
+	// Log process
+	char output_line_buffer[2048];
+
+	sprintf( output_line_buffer, "%d\t%d\t%.5f\t%lld\t%lld\t%lld\t%lld", num_processes, help_request_threshold, time_past, getNumCliquesTotal(), getNumHelpRequestsSent(), getNumHelpRequestsSentAccepted(), getNumHelpRequestsSentRejected() );
+	std::string output_line = output_line_buffer;
+
+	// Add the threshold trajectory of each worker, as comma-separated time:threshold pairs, with workers separated by
+	// semicolons
+	if ( help_threshold_adaptive ) {
+		output_line += "\t";
+
+		for ( unsigned int i = 0; i < help_threshold_trajectories.size(); i++ ) {
+			for ( unsigned int j = 0; j + 1 < help_threshold_trajectories[ i ].size(); j += 2 ) {
+				sprintf( output_line_buffer, "%s%.3f:%d", ( j > 0 ) ? "," : ( i > 0 ? ";" : "" ), help_threshold_trajectories[ i ][ j ], int( help_threshold_trajectories[ i ][ j + 1 ] ) );
+				output_line += output_line_buffer;
+			}
+		}
+	}
+
+#ifdef CLIQUES_STATS
+	// Add the search statistics: edge checks, bytes sent in help transfers, time blocked in help requests
+	// (microseconds), the number of DFS nodes visited per depth (comma-separated) and the candidate set size
+	// histogram per depth (depths separated by commas, buckets by slashes)
+	int stats_num_depths = ( stats.size() - STATS_DEPTHS ) / STATS_DEPTH_SIZE;
+
+	sprintf( output_line_buffer, "\t%lld\t%lld\t%lld\t", stats[ STATS_EDGE_CHECKS ], stats[ STATS_HELP_BYTES_SENT ], stats[ STATS_HELP_REQUEST_TIME ] );
+	output_line += output_line_buffer;
+
+	for ( int depth = 0; depth < stats_num_depths; depth++ ) {
+		output_line += ( depth > 0 ? "," : "" ) + std::to_string( stats[ STATS_DEPTHS + depth * STATS_DEPTH_SIZE ] );
+	}
+
+	output_line += "\t";
+
+	for ( int depth = 0; depth < stats_num_depths; depth++ ) {
+		for ( int bucket = 0; bucket < STATS_NUM_BUCKETS; bucket++ ) {
+			output_line += ( bucket > 0 ? "/" : ( depth > 0 ? "," : "" ) ) + std::to_string( stats[ STATS_DEPTHS + depth * STATS_DEPTH_SIZE + 1 + bucket ] );
+		}
+	}
+#endif
+
+	// Mark a partial result by the fraction of the estimated work completed before the deadline
+	if ( isPartial() ) {
+		sprintf( output_line_buffer, "\tpartial:%.4f", getWorkCompletedFraction() );
+		output_line += output_line_buffer;
+	}
+
+	std::ofstream fh_log_output( results_output_fname, std::fstream::app|std::fstream::out );
+	fh_log_output << output_line << "\n";
+}
+
+void ResultsReport::writeRootCosts() {
+	std::vector<std::vector<double> > root_costs_sorted;
+
+	for ( unsigned int i = 0; i + ROOT_COST_RECORD_SIZE <= root_costs.size(); i += ROOT_COST_RECORD_SIZE ) {
+		root_costs_sorted.push_back( std::vector<double>( root_costs.begin() + i, root_costs.begin() + i + ROOT_COST_RECORD_SIZE ) );
+	}
+
+	std::sort( root_costs_sorted.begin(), root_costs_sorted.end() );
+
+	FILE *fh_root_costs = fopen( root_costs_output_fname.c_str(), "w" );
+
+	if ( fh_root_costs != NULL ) {
+		if ( root_costs_header != "" ) {
+			fprintf( fh_root_costs, "%s\n", root_costs_header.c_str() );
+		}
+
+		for ( const auto &root_cost : root_costs_sorted ) {
+			fprintf( fh_root_costs, "%lld\t%lld\t%.9f\t%lld\n", (long long) root_cost[0], (long long) root_cost[1], root_cost[2], (long long) root_cost[3] );
+		}
+
+		fclose( fh_root_costs );
+	}
+}
+
+void ResultsReport::writeNodeCliquesCounts() {
+	// Clique sizes with cliques, and the number of nodes in the node ID range
+	long long size_min = 0;
+	long long num_nodes = this->num_nodes;
+
+	while ( size_min < (long long) node_cliques_counts.size() && node_cliques_counts[ size_min ].empty() ) {
+		size_min++;
+	}
+
+	long long num_sizes = node_cliques_counts.size() - size_min;
+
+	for ( long long size = size_min; size < (long long) node_cliques_counts.size(); size++ ) {
+		num_nodes = std::max( num_nodes, (long long) node_cliques_counts[ size ].size() );
+	}
+
+	FILE *fh_node_counts = fopen( node_counts_output_fname.c_str(), node_counts_output_format == NODE_COUNTS_OUTPUT_BINARY ? "wb" : "w" );
+
+	if ( fh_node_counts == NULL ) {
+		printf( "ERROR: The node clique counts output file '%s' could not be opened.\n", node_counts_output_fname.c_str() );
+		return;
+	}
+
+	std::vector<long long> node_counts( num_sizes );
+
+	// Nodes are written in ascending order of external node ID, which differs from the order of node IDs if the nodes
+	// were renumbered (see NodeOrder)
+	std::vector<long long> rows( num_nodes );
+
+	for ( long long i = 0; i < num_nodes; i++ ) {
+		rows[ i ] = i;
+	}
+
+	std::stable_sort( rows.begin(), rows.end(), [this]( long long a, long long b ) {
+		return getNodeExternalId( node_id_min + a ) < getNodeExternalId( node_id_min + b );
+	} );
+
+	if ( node_counts_output_format == NODE_COUNTS_OUTPUT_BINARY ) {
+		long long header[4] = { node_id_min, num_nodes, size_min, num_sizes };
+		fwrite( header, sizeof( long long ), 4, fh_node_counts );
+	}
+	else {
+		fprintf( fh_node_counts, "# node" );
+
+		for ( long long size = size_min; size < size_min + num_sizes; size++ ) {
+			fprintf( fh_node_counts, "\t%lld", size );
+		}
+
+		fprintf( fh_node_counts, "\n" );
+	}
+
+	for ( long long i : rows ) {
+		for ( long long j = 0; j < num_sizes; j++ ) {
+			const std::vector<long long> &size_counts = node_cliques_counts[ size_min + j ];
+			node_counts[ j ] = ( i < (long long) size_counts.size() ) ? size_counts[ i ] : 0;
+		}
+
+		if ( node_counts_output_format == NODE_COUNTS_OUTPUT_BINARY ) {
+			fwrite( node_counts.data(), sizeof( long long ), num_sizes, fh_node_counts );
+			continue;
+		}
+
+		fprintf( fh_node_counts, "%lld", getNodeExternalId( node_id_min + i ) );
+
+		for ( long long count : node_counts ) {
+			fprintf( fh_node_counts, "\t%lld", count );
+		}
+
+		fprintf( fh_node_counts, "\n" );
+	}
+
+	// The binary format lists the external node ID of every node after the counts, in the same order
+	if ( node_counts_output_format == NODE_COUNTS_OUTPUT_BINARY ) {
+		for ( long long i : rows ) {
+			long long external_id = getNodeExternalId( node_id_min + i );
+			fwrite( &external_id, sizeof( long long ), 1, fh_node_counts );
+		}
+	}
+
+	fclose( fh_node_counts );
+}
+
+long long ResultsReport::getNodeExternalId( long long node_id ) {
+	return ( node_id >= 0 && node_id < (long long) node_external_ids.size() ) ? node_external_ids[ node_id ] : node_id;
+}
@@ -0,0 +1,237 @@
+#ifndef RESULTSREPORT_H
+#define RESULTSREPORT_H
+
+// Includes
+// ==========
+// STL includes
+#include <string>
+#include <vector>
+
+// Output formats of node clique counts
+// ==========
+// TSV: per node a line with the node ID and the number of cliques it belongs to per clique size, separated by tab
+// characters, preceded by a header line starting with "#"
+const int NODE_COUNTS_OUTPUT_TSV = 0;
+
+// Binary: the smallest node ID, the number of nodes, the smallest clique size and the number of clique sizes, followed
+// by the clique counts per node (node-major), all as 64-bit integers in host byte order
+const int NODE_COUNTS_OUTPUT_BINARY = 1;
+
+/**
+ * Combined results of all workers taking part in the computation, reported on standard output and written to the
+ * results log and root task costs files. Independent of the way the results were combined, so that it is shared by the
+ * MPI and shared-memory computations
+ */
+class ResultsReport {
+	public:
+		/**
+		 * Combined result record (see RESULT_* in const.h)
+		 */
+		std::vector<long long> record;
+
+		/**
+		 * Trajectories of the adaptive help request threshold per worker, as alternating time and threshold
+		 */
+		std::vector<std::vector<double> > help_threshold_trajectories;
+
+		/**
+		 * Root ID, number of candidate nodes, time in seconds and number of search tree nodes per root task, in any
+		 * order, and the header line identifying the graph they are recorded on (see RootProfile::getHeader())
+		 */
+		std::vector<double> root_costs;
+		std::string root_costs_header = "";
+
+		/**
+		 * Number of cliques each node belongs to, indexed by clique size and by node ID minus node_id_min, if recorded.
+		 * Sizes without cliques have empty arrays. The node ID range is that of the graph, so that nodes are written
+		 * even if there are no cliques at all
+		 */
+		std::vector<std::vector<long long> > node_cliques_counts;
+		int node_id_min = 0;
+		int num_nodes = 0;
+
+		/**
+		 * External node ID, as used in the input file, per node ID, which the node clique counts are written with. Node
+		 * IDs beyond its end are their own external node ID
+		 */
+		std::vector<long long> node_external_ids;
+
+		/**
+		 * Sampling record summed over all workers (see SAMPLE_* in SampleEstimate.h) if the number of cliques was
+		 * estimated by sampling root tasks, or empty if cliques were counted exactly, and the target relative error and
+		 * confidence level of the estimate
+		 */
+		std::vector<double> sample_record;
+		double sample_target_error = 0;
+		double sample_confidence = 0.95;
+
+#ifdef CLIQUES_STATS
+		/**
+		 * Search statistics summed over all workers (see STATS_* in SearchStats.h)
+		 */
+		std::vector<long long> stats;
+#endif
+
+		/**
+		 * Number of processes or threads in use, and the number of them taking part in the computation
+		 */
+		int num_processes = 1;
+		int num_workers = 1;
+
+		/**
+		 * Help request settings of the computation
+		 */
+		int help_request_threshold = 0;
+		bool help_threshold_adaptive = false;
+
+		/**
+		 * Running time of the computation in seconds
+		 */
+		double time_past = 0;
+
+		/**
+		 * Whether to report details beyond the total number of cliques and the running time
+		 */
+		bool verbose = false;
+
+		/**
+		 * File to append the results log line to, and file to write the root task costs to. Not written if empty or "0"
+		 */
+		std::string results_output_fname = "";
+		std::string root_costs_output_fname = "";
+
+		/**
+		 * File to write the node clique counts to, not written if empty or "0", and its format (NODE_COUNTS_OUTPUT_TSV
+		 * or NODE_COUNTS_OUTPUT_BINARY)
+		 */
+		std::string node_counts_output_fname = "";
+		int node_counts_output_format = NODE_COUNTS_OUTPUT_TSV;
+
+		/**
+		 * Get the number of cliques per clique size, rounded estimates if the number of cliques was estimated by sampling
+		 *
+		 * @return std::vector<long long> Clique counts, indexed by clique size
+		 */
+		std::vector<long long> getCliquesCounts();
+
+		/**
+		 * Get the half-width of the confidence interval of the estimated number of cliques per clique size, or zeros if
+		 * cliques were counted exactly
+		 *
+		 * @return std::vector<double> Half-widths, indexed by clique size
+		 */
+		std::vector<double> getCliquesCountsHalfWidths();
+
+		/**
+		 * Get the total number of cliques of all sizes
+		 *
+		 * @return long long Total number of cliques
+		 */
+		long long getNumCliquesTotal();
+
+		/**
+		 * Get the half-width of the confidence interval of the estimated total number of cliques, or 0 if cliques were
+		 * counted exactly
+		 *
+		 * @return double Half-width
+		 */
+		double getNumCliquesTotalHalfWidth();
+
+		/**
+		 * Get the number of help requests sent by all workers, and the number of them accepted and rejected
+		 *
+		 * @return long long Number of help requests
+		 */
+		long long getNumHelpRequestsSent();
+		long long getNumHelpRequestsSentAccepted();
+		long long getNumHelpRequestsSentRejected();
+
+		/**
+		 * Get the busy time of the busiest worker, and the average busy time per worker
+		 *
+		 * @return double Busy time in seconds
+		 */
+		double getBusyTimeMax();
+		double getBusyTimeAverage();
+
+		/**
+		 * Get the number of checkpoint snapshots written by all workers
+		 *
+		 * @return long long Number of snapshots
+		 */
+		long long getNumCheckpointsWritten();
+
+		/**
+		 * Get the average time per worker the search waited for taking checkpoint snapshots, and the average time per
+		 * worker spent writing them in the background
+		 *
+		 * @return double Time in seconds
+		 */
+		double getCheckpointTimeAverage();
+		double getCheckpointWriteTimeAverage();
+
+		/**
+		 * Check whether the search of some worker stopped at the deadline, in which case the clique counts only hold the
+		 * cliques of the root tasks and help tasks completed before it
+		 *
+		 * @return bool Whether the result is partial
+		 */
+		bool isPartial();
+
+		/**
+		 * Get the number of root tasks of all workers, and the number of them completed before the deadline. Only
+		 * recorded if there is a deadline
+		 *
+		 * @return long long Number of root tasks
+		 */
+		long long getNumRootsTotal();
+		long long getNumRootsCompleted();
+
+		/**
+		 * Get the fraction of the estimated work of the root tasks completed before the deadline, with the work of a
+		 * root task estimated by the number of candidate node pairs it starts with
+		 *
+		 * @return double Fraction between 0 and 1
+		 */
+		double getWorkCompletedFraction();
+
+		/**
+		 * Add the node clique counts of a worker to the node clique counts
+		 *
+		 * @param int counts_node_id_min Smallest node ID of the node clique counts of the worker
+		 * @param const std::vector<std::vector<long long> >& counts Node clique counts of the worker, indexed by clique
+		 * size and by node ID minus its smallest node ID
+		 */
+		void addNodeCliquesCounts( int counts_node_id_min, const std::vector<std::vector<long long> > &counts );
+
+		/**
+		 * Report the results on standard output, and write the results log line and root task costs if requested
+		 */
+		void write();
+
+	protected:
+		/**
+		 * Append the results to the results log file, as a tab-separated line
+		 */
+		void writeLog();
+
+		/**
+		 * Write the root task costs sorted by root ID, for replaying the computation in the load balancing simulator
+		 */
+		void writeRootCosts();
+
+		/**
+		 * Write the node clique counts, for the clique sizes from the smallest size with cliques to the largest
+		 */
+		void writeNodeCliquesCounts();
+
+		/**
+		 * Get the external node ID of a node ID, as written with the node clique counts
+		 *
+		 * @param long long node_id Node ID
+		 * @return long long External node ID
+		 */
+		long long getNodeExternalId( long long node_id );
+};
+
+#endif
@@ -0,0 +1,267 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <queue>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+// Program includes
+#include "Simulator.h"
+
+// Simulated event types
+// ==========
+const int EVENT_CONTINUE = 0;
+const int EVENT_MASTER_DONE = 1;
+const int EVENT_MASTER_REQUEST_HELP = 2;
+const int EVENT_REQUEST_HELP_RESPONSE = 3;
+const int EVENT_HELP_DATA = 4;
+
+bool Simulator::readRootCosts( std::string fname, std::vector<RootTask> &roots ) {
+	std::ifstream fl_input( fname );
+
+	if ( ! fl_input ) {
+		printf( "ERROR: The input file '%s' does not exist.\n", fname.c_str() );
+		return false;
+	}
+
+	for ( std::string row; std::getline( fl_input, row ); ) {
+		std::istringstream row_fields( row );
+		RootTask root;
+
+		if ( row_fields >> root.id >> root.num_candidates >> root.cost ) {
+			roots.push_back( root );
+		}
+	}
+
+	return true;
+}
+
+void Simulator::setNumProcesses( int num ) {
+	num_processes = num;
+}
+
+void Simulator::setHelpEnabled( bool enabled ) {
+	help_enabled = enabled;
+}
+
+void Simulator::setHelpRequestThreshold( int threshold ) {
+	help_request_threshold = threshold;
+}
+
+void Simulator::setLatency( double seconds ) {
+	latency = seconds;
+}
+
+void Simulator::setCoordinatorTime( double seconds ) {
+	coordinator_time = seconds;
+}
+
+void Simulator::setPartitioner( int partitioner_id ) {
+	partitioner = partitioner_id;
+}
+
+void Simulator::setHelpMatchPolicy( int policy ) {
+	help_match_policy = policy;
+}
+
+void Simulator::schedule( double time, int type, int process_id, int arg ) {
+	events.push( { time, num_events++, type, process_id, arg } );
+}
+
+void Simulator::partitionRoots() {
+	// Root tasks in increasing order of ID, which is the order in which processes handle them
+	std::sort( roots.begin(), roots.end(), []( const RootTask &a, const RootTask &b ) { return a.id < b.id; } );
+
+	if ( partitioner == PARTITION_MODULO ) {
+		for ( unsigned int i = 0; i < roots.size(); i++ ) {
+			processes[ roots[ i ].id % num_processes ].roots.push_back( i );
+		}
+	}
+	else if ( partitioner == PARTITION_BLOCK ) {
+		long long block_size = ( roots.size() + num_processes - 1 ) / num_processes;
+
+		for ( unsigned int i = 0; i < roots.size(); i++ ) {
+			processes[ i / block_size ].roots.push_back( i );
+		}
+	}
+	else {
+		// Longest processing time first: assign root tasks in decreasing order of cost to the least loaded process
+		std::vector<int> order( roots.size() );
+
+		for ( unsigned int i = 0; i < roots.size(); i++ ) {
+			order[ i ] = i;
+		}
+
+		std::sort( order.begin(), order.end(), [this]( int a, int b ) { return roots[ a ].cost > roots[ b ].cost; } );
+
+		std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int> >, std::greater<std::pair<double, int> > > loads;
+
+		for ( int i = 0; i < num_processes; i++ ) {
+			loads.push( std::make_pair( 0.0, i ) );
+		}
+
+		for ( int root : order ) {
+			std::pair<double, int> load = loads.top();
+			loads.pop();
+
+			processes[ load.second ].roots.push_back( root );
+			loads.push( std::make_pair( load.first + roots[ root ].cost, load.second ) );
+		}
+
+		for ( auto &process : processes ) {
+			std::sort( process.roots.begin(), process.roots.end() );
+		}
+	}
+}
+
+double Simulator::getCost( int root, int start, int end ) {
+	double num_candidates = roots[ root ].num_candidates;
+
+	if ( num_candidates <= 0 ) {
+		return roots[ root ].cost;
+	}
+
+	// Total weight of the candidate nodes from index i on is (r - i)(r - i + 1) / 2
+	double weight_start = ( num_candidates - start ) * ( num_candidates - start + 1 ) / 2;
+	double weight_end = ( num_candidates - end ) * ( num_candidates - end + 1 ) / 2;
+	double weight_total = num_candidates * ( num_candidates + 1 ) / 2;
+
+	return roots[ root ].cost * ( weight_start - weight_end ) / weight_total;
+}
+
+void Simulator::continueProcess( int process_id, double time, SimulationResult &result ) {
+	SimulatedProcess &process = processes[ process_id ];
+
+	while ( true ) {
+		// Start the next root task, or report to the master process that this process has become idle
+		if ( ! process.has_task ) {
+			if ( process.next_root >= process.roots.size() ) {
+				schedule( time + latency, EVENT_MASTER_DONE, process_id );
+				return;
+			}
+
+			int root = process.roots[ process.next_root++ ];
+			process.task = { root, 0, roots[ root ].num_candidates };
+			process.has_task = true;
+		}
+
+		Task &task = process.task;
+
+		if ( help_enabled && num_processes > 1 && task.end - task.start > help_request_threshold ) {
+			// Request help, and wait for the response
+			if ( ! process.skip_help_request ) {
+				result.num_help_requests_sent++;
+				schedule( time + latency, EVENT_MASTER_REQUEST_HELP, process_id );
+				return;
+			}
+
+			// After a rejected help request, or at the start of a task received from another process, process a single
+			// candidate node before requesting help again
+			process.skip_help_request = false;
+
+			double cost = getCost( task.root, task.start, task.start + 1 );
+			task.start++;
+			process.busy_time += cost;
+			schedule( time + cost, EVENT_CONTINUE, process_id );
+			return;
+		}
+
+		// No help is requested for the remaining candidate nodes of the task. As no messages are sent to a busy
+		// process, the process can move on to its next task without waiting for an event
+		double cost = getCost( task.root, task.start, task.end );
+		process.busy_time += cost;
+		process.has_task = false;
+		process.skip_help_request = false;
+		time += cost;
+	}
+}
+
+SimulationResult Simulator::run() {
+	SimulationResult result;
+
+	// Reset simulation state
+	events = std::priority_queue<Event, std::vector<Event>, std::greater<Event> >();
+	num_events = 0;
+	processes.assign( num_processes, SimulatedProcess() );
+	tasks_in_transit.clear();
+	master_free_time = 0;
+
+	partitionRoots();
+
+	std::vector<int> process_ids;
+
+	for ( int i = 0; i < num_processes; i++ ) {
+		process_ids.push_back( i );
+		schedule( 0, EVENT_CONTINUE, i );
+	}
+
+	HelpMatcher help_matcher( process_ids, help_match_policy );
+
+	while ( ! events.empty() ) {
+		Event event = events.top();
+		events.pop();
+
+		if ( event.type == EVENT_CONTINUE ) {
+			continueProcess( event.process_id, event.time, result );
+		}
+		else if ( event.type == EVENT_MASTER_DONE || event.type == EVENT_MASTER_REQUEST_HELP ) {
+			// The master process handles one message at a time
+			master_free_time = std::max( master_free_time, event.time ) + coordinator_time;
+
+			if ( event.type == EVENT_MASTER_DONE ) {
+				help_matcher.markIdle( event.process_id );
+
+				// All processes are done once the master process has relayed that all processing is completed
+				if ( help_matcher.getNumProcessesActive() == 0 ) {
+					result.makespan = master_free_time + latency;
+				}
+			}
+			else {
+				int helper_id = help_matcher.claimHelper( event.process_id );
+				schedule( master_free_time + latency, EVENT_REQUEST_HELP_RESPONSE, event.process_id, helper_id );
+			}
+		}
+		else if ( event.type == EVENT_REQUEST_HELP_RESPONSE ) {
+			SimulatedProcess &process = processes[ event.process_id ];
+
+			if ( event.arg >= 0 ) {
+				// Hand over the remaining candidate nodes of the current task to the helper
+				result.num_help_requests_sent_accepted++;
+				tasks_in_transit.push_back( process.task );
+				schedule( event.time + latency, EVENT_HELP_DATA, event.arg, tasks_in_transit.size() - 1 );
+				process.has_task = false;
+			}
+			else {
+				result.num_help_requests_sent_rejected++;
+				process.skip_help_request = true;
+			}
+
+			continueProcess( event.process_id, event.time, result );
+		}
+		else if ( event.type == EVENT_HELP_DATA ) {
+			SimulatedProcess &process = processes[ event.process_id ];
+			process.task = tasks_in_transit[ event.arg ];
+			process.has_task = true;
+			process.skip_help_request = true;
+
+			continueProcess( event.process_id, event.time, result );
+		}
+	}
+
+	// Summarise
+	for ( const auto &root : roots ) {
+		result.total_cost += root.cost;
+	}
+
+	for ( const auto &process : processes ) {
+		result.busy_time_max = std::max( result.busy_time_max, process.busy_time );
+		result.busy_time_average += process.busy_time / num_processes;
+	}
+
+	result.num_events = num_events;
+
+	return result;
+}
@@ -0,0 +1,201 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <queue>
+
+// Program includes
+#include "../Process/HelpMatcher.h"
+
+// Partitioners distributing the root tasks over the processes
+// ==========
+// PARTITION_MODULO: root task with ID r goes to process r % num_processes, as in the actual computation
+// PARTITION_BLOCK: consecutive blocks of root tasks of equal size
+// PARTITION_COST: greedily assign the most costly remaining root task to the least loaded process, using the recorded
+// costs. Not realisable in practice, but gives a bound on what a cost model could achieve
+const int PARTITION_MODULO = 0;
+const int PARTITION_BLOCK = 1;
+const int PARTITION_COST = 2;
+
+/**
+ * Root task of the search, with its recorded cost
+ */
+struct RootTask {
+	long long id;
+	int num_candidates;
+	double cost;
+};
+
+/**
+ * Outcome of a simulated computation
+ */
+struct SimulationResult {
+	double makespan = 0;
+	double total_cost = 0;
+	double busy_time_max = 0;
+	double busy_time_average = 0;
+	long long num_help_requests_sent = 0;
+	long long num_help_requests_sent_accepted = 0;
+	long long num_help_requests_sent_rejected = 0;
+	long long num_events = 0;
+};
+
+/**
+ * Deterministic discrete-event simulator of the dynamic load balancing protocol with a master process, replaying
+ * recorded root task costs on any number of virtual processes. Processes request help from the master process while
+ * more candidate nodes than the help request threshold remain in their current root task, and hand over the remaining
+ * candidate nodes to the helper assigned by the master process, which uses the same HelpMatcher as the actual
+ * computation. All messages take a fixed latency, and the master process handles one message at a time.
+ *
+ * The cost of a root task with r candidate nodes is spread over its candidate nodes in proportion to r - i for the i-th
+ * candidate node, i.e. the number of candidate nodes from the i-th on, matching the number of edge checks at the top
+ * level of the search. Help requests deeper in the search are not modelled.
+ */
+class Simulator {
+	private:
+		/**
+		 * Root tasks of the search
+		 */
+		std::vector<RootTask> roots;
+
+		/**
+		 * Settings
+		 */
+		int num_processes = 1;
+		bool help_enabled = true;
+		int help_request_threshold = 10;
+		double latency = 5e-6;
+		double coordinator_time = 1e-6;
+		int partitioner = PARTITION_MODULO;
+		int help_match_policy = HELP_MATCH_FIRST;
+
+		/**
+		 * Simulated event: the arrival of a message, or a process continuing its current task
+		 */
+		struct Event {
+			double time;
+			long long sequence;
+			int type;
+			int process_id;
+			int arg;
+
+			bool operator>( const Event &other ) const {
+				return time > other.time || ( time == other.time && sequence > other.sequence );
+			}
+		};
+
+		/**
+		 * Part of a root task being processed by a process: candidate nodes start up to end of root task root
+		 */
+		struct Task {
+			int root;
+			int start;
+			int end;
+		};
+
+		/**
+		 * State of a simulated process
+		 */
+		struct SimulatedProcess {
+			std::vector<int> roots;
+			unsigned int next_root = 0;
+			bool has_task = false;
+			Task task;
+			bool skip_help_request = false;
+			double busy_time = 0;
+		};
+
+		/**
+		 * Simulation state
+		 */
+		std::priority_queue<Event, std::vector<Event>, std::greater<Event> > events;
+		long long num_events = 0;
+		std::vector<SimulatedProcess> processes;
+		std::vector<Task> tasks_in_transit;
+		double master_free_time = 0;
+
+		/**
+		 * Schedule an event
+		 *
+		 * @param double time Time of the event
+		 * @param int type Event type
+		 * @param int process_id Process the event applies to
+		 * @param int arg Optional. Event argument
+		 */
+		void schedule( double time, int type, int process_id, int arg = 0 );
+
+		/**
+		 * Distribute the root tasks over the processes using the partitioner
+		 */
+		void partitionRoots();
+
+		/**
+		 * Get the cost of processing the candidate nodes from start to end (exclusive) of a root task
+		 *
+		 * @param int root Index of the root task
+		 * @param int start Index of the first candidate node
+		 * @param int end Index after the last candidate node
+		 * @return double Cost in seconds
+		 */
+		double getCost( int root, int start, int end );
+
+		/**
+		 * Let a process continue with its current task, or with its next root task, until it requests help, has to wait
+		 * for the next step, or becomes idle
+		 *
+		 * @param int process_id Process ID
+		 * @param double time Current time
+		 * @param SimulationResult &result Result counters
+		 */
+		void continueProcess( int process_id, double time, SimulationResult &result );
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param std::vector<RootTask> roots Root tasks of the search
+		 */
+		Simulator( std::vector<RootTask> roots ) : roots(roots) {}
+
+		/**
+		 * Read root tasks from a file written with the -costs argument of the program, containing a root ID, number of
+		 * candidate nodes and time in seconds per line, separated by tabs
+		 *
+		 * @param std::string fname Input file name
+		 * @param std::vector<RootTask> &roots Root tasks read
+		 * @return bool Whether the file could be read
+		 */
+		static bool readRootCosts( std::string fname, std::vector<RootTask> &roots );
+
+		/**
+		 * Settings of the simulated computation
+		 *
+		 * @param int num Number of processes taking part in the computation
+		 * @param bool enabled Whether dynamic load balancing is enabled
+		 * @param int threshold Help request threshold
+		 * @param double seconds One-way message latency
+		 * @param double seconds Time the master process takes to handle a message
+		 * @param int partitioner_id Partitioner, see PARTITION_*
+		 * @param int policy Policy for choosing idle processes, see HELP_MATCH_* in const.h
+		 */
+		void setNumProcesses( int num );
+		void setHelpEnabled( bool enabled );
+		void setHelpRequestThreshold( int threshold );
+		void setLatency( double seconds );
+		void setCoordinatorTime( double seconds );
+		void setPartitioner( int partitioner_id );
+		void setHelpMatchPolicy( int policy );
+
+		/**
+		 * Simulate the computation
+		 *
+		 * @return SimulationResult Outcome of the simulation
+		 */
+		SimulationResult run();
+};
+
+#endif
@@ -0,0 +1,135 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <fstream>
+#include <stdio.h>
+
+// Program includes
+#include "Trace.h"
+
+bool Trace::enabled = false;
+unsigned int Trace::capacity = 0;
+long long Trace::epoch = 0;
+std::vector<TraceBuffer *> Trace::buffers;
+
+/**
+ * Mutex guarding the registration of per-thread buffers
+ */
+static std::mutex buffers_mutex;
+
+/**
+ * Buffer of the current thread
+ */
+static thread_local TraceBuffer *thread_buffer = NULL;
+
+void Trace::enable( unsigned int buffer_capacity ) {
+	capacity = buffer_capacity;
+	enabled = true;
+	resetEpoch();
+}
+
+bool Trace::isEnabled() {
+	return enabled;
+}
+
+long long Trace::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+void Trace::resetEpoch() {
+	epoch = now();
+}
+
+TraceBuffer *Trace::getThreadBuffer() {
+	if ( thread_buffer == NULL ) {
+		std::lock_guard<std::mutex> lock( buffers_mutex );
+
+		thread_buffer = new TraceBuffer();
+		thread_buffer->thread_id = buffers.size();
+		thread_buffer->events.resize( capacity );
+		buffers.push_back( thread_buffer );
+	}
+
+	return thread_buffer;
+}
+
+void Trace::setThreadName( std::string name ) {
+	if ( enabled ) {
+		getThreadBuffer()->thread_name = name;
+	}
+}
+
+void Trace::record( const char *name, long long start, long long end, long long arg ) {
+	if ( ! enabled || capacity == 0 ) {
+		return;
+	}
+
+	TraceBuffer *buffer = getThreadBuffer();
+	TraceEvent &event = buffer->events[ buffer->num_events++ % capacity ];
+	event.name = name;
+	event.start = start;
+	event.end = end;
+	event.arg = arg;
+}
+
+long long Trace::getNumDroppedEvents() {
+	long long num_dropped = 0;
+
+	for ( const TraceBuffer *buffer : buffers ) {
+		if ( buffer->num_events > capacity ) {
+			num_dropped += buffer->num_events - capacity;
+		}
+	}
+
+	return num_dropped;
+}
+
+std::string Trace::exportEvents( int process_id ) {
+	std::string output;
+	char buff[512];
+
+	// Name the process after its ID
+	sprintf( buff, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"process %d\"}}", process_id, process_id );
+	output += buff;
+
+	for ( const TraceBuffer *buffer : buffers ) {
+		if ( buffer->thread_name != "" ) {
+			sprintf( buff, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", process_id, buffer->thread_id, buffer->thread_name.c_str() );
+			output += buff;
+		}
+
+		// Export the events in the ring buffer from oldest to newest, with times in microseconds
+		long long first_event = ( buffer->num_events > capacity ) ? buffer->num_events - capacity : 0;
+
+		for ( long long i = first_event; i < buffer->num_events; i++ ) {
+			const TraceEvent &event = buffer->events[ i % capacity ];
+
+			sprintf( buff, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", event.name, process_id, buffer->thread_id, ( event.start - epoch ) / 1000.0, ( event.end - event.start ) / 1000.0 );
+			output += buff;
+
+			if ( event.arg >= 0 ) {
+				sprintf( buff, ",\"args\":{\"id\":%lld}", event.arg );
+				output += buff;
+			}
+
+			output += "}";
+		}
+	}
+
+	return output;
+}
+
+void Trace::writeFile( std::string fname, const std::vector<std::string> &process_events ) {
+	std::ofstream fh_trace_output( fname, std::fstream::out );
+	fh_trace_output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	for ( unsigned int i = 0; i < process_events.size(); i++ ) {
+		fh_trace_output << ( i > 0 ? ",\n" : "" ) << process_events[ i ];
+	}
+
+	fh_trace_output << "\n]}\n";
+}
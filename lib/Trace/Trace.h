@@ -0,0 +1,158 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+
+/**
+ * Single traced event: a named phase of the computation on a thread, with an optional integer argument
+ */
+struct TraceEvent {
+	const char *name;
+	long long start;
+	long long end;
+	long long arg;
+};
+
+/**
+ * Ring buffer of the events recorded on a single thread. When the buffer is full, the oldest events are overwritten
+ */
+struct TraceBuffer {
+	int thread_id;
+	std::string thread_name;
+	std::vector<TraceEvent> events;
+	long long num_events = 0;
+};
+
+class Trace {
+	private:
+		/**
+		 * Whether events are recorded
+		 */
+		static bool enabled;
+
+		/**
+		 * Number of events each per-thread ring buffer can hold
+		 */
+		static unsigned int capacity;
+
+		/**
+		 * Clock time (in nanoseconds) regarded as time zero in the trace
+		 */
+		static long long epoch;
+
+		/**
+		 * Buffers of all threads that recorded events. Buffers outlive their threads, so they can be exported after the
+		 * threads have finished
+		 */
+		static std::vector<TraceBuffer *> buffers;
+
+		/**
+		 * Get the buffer of the calling thread, creating it on first use
+		 *
+		 * @return TraceBuffer* Buffer of the calling thread
+		 */
+		static TraceBuffer *getThreadBuffer();
+
+	public:
+		/**
+		 * Enable recording events
+		 *
+		 * @param unsigned int buffer_capacity Number of events each per-thread ring buffer can hold
+		 */
+		static void enable( unsigned int buffer_capacity = 65536 );
+
+		/**
+		 * Check whether events are recorded
+		 *
+		 * @return bool Whether tracing is enabled
+		 */
+		static bool isEnabled();
+
+		/**
+		 * Get the current time of the monotonic clock
+		 *
+		 * @return long long Current time in nanoseconds
+		 */
+		static long long now();
+
+		/**
+		 * Set time zero of the trace to the current time. Should be called by all processes at the same moment (e.g. after
+		 * a barrier), so that the traces of different processes line up
+		 */
+		static void resetEpoch();
+
+		/**
+		 * Set the name of the calling thread, as displayed in the trace viewer
+		 *
+		 * @param std::string name Thread name
+		 */
+		static void setThreadName( std::string name );
+
+		/**
+		 * Record an event on the calling thread
+		 *
+		 * @param const char* name Event name. Should be a string literal, as only the pointer is stored
+		 * @param long long start Start time in nanoseconds
+		 * @param long long end End time in nanoseconds
+		 * @param long long arg Optional. Integer argument of the event, or -1 for none
+		 */
+		static void record( const char *name, long long start, long long end, long long arg = -1 );
+
+		/**
+		 * Get the number of events that were overwritten in the ring buffers of all threads
+		 *
+		 * @return long long Number of dropped events
+		 */
+		static long long getNumDroppedEvents();
+
+		/**
+		 * Export all recorded events as comma-separated Chrome trace event objects, to be wrapped in the "traceEvents" array
+		 * of a Chrome/Perfetto trace file. Should only be called after all threads recording events have finished.
+		 *
+		 * @param int process_id ID of the process, used as process ID in the trace
+		 * @return std::string Trace event objects
+		 */
+		static std::string exportEvents( int process_id );
+
+		/**
+		 * Write a single trace file in the Chrome trace event format, which can be opened in chrome://tracing or Perfetto
+		 *
+		 * @param std::string fname Path of the trace file
+		 * @param const std::vector<std::string> &process_events Exported events per process (see exportEvents())
+		 */
+		static void writeFile( std::string fname, const std::vector<std::string> &process_events );
+};
+
+/**
+ * Event covering the lifetime of the object. Does nothing if tracing is disabled
+ */
+class TraceScope {
+	private:
+		const char *name;
+		long long start;
+		long long arg;
+
+	public:
+		/**
+		 * Constructor. Starts the event
+		 *
+		 * @param const char* name Event name. Should be a string literal
+		 * @param long long arg Optional. Integer argument of the event, or -1 for none
+		 */
+		TraceScope( const char *name, long long arg = -1 ) : name(name), start(Trace::isEnabled() ? Trace::now() : 0), arg(arg) {}
+
+		/**
+		 * Destructor. Records the event
+		 */
+		~TraceScope() {
+			if ( start != 0 ) {
+				Trace::record( name, start, Trace::now(), arg );
+			}
+		}
+};
+
+#endif
@@ -0,0 +1,143 @@
+// Includes
+// ==========
+// STL includes
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+
+// Program includes
+#include "ThreadTransport.h"
+#include "../Process/const.h"
+
+/**
+ * Sleep with exponential backoff while waiting for other workers, capped at the maximum sleep time of the coordinator
+ *
+ * @param int &sleep_time Time to sleep in microseconds, doubled after sleeping
+ */
+void sleepWithBackoff( int &sleep_time ) {
+	std::this_thread::sleep_for( std::chrono::microseconds( sleep_time ) );
+	sleep_time = std::min( sleep_time * 2, COORDINATOR_MAX_SLEEP_TIME );
+}
+
+ThreadTransportState::ThreadTransportState( int num_workers, int help_match_policy ) : num_workers(num_workers), help_match_policy(help_match_policy), statuses(new std::atomic<int>[ num_workers ]), num_active(num_workers), mailboxes(new std::atomic<HelpTask *>[ num_workers ]), completed(false), next_index(0), records(num_workers), num_records(0) {
+	for ( int i = 0; i < num_workers; i++ ) {
+		statuses[ i ] = PROCESS_RUNNING;
+		mailboxes[ i ] = NULL;
+	}
+}
+
+ThreadTransportState::~ThreadTransportState() {
+	for ( int i = 0; i < num_workers; i++ ) {
+		delete mailboxes[ i ].load();
+	}
+}
+
+bool ThreadTransport::claimWorker( int helper_id ) {
+	if ( helper_id == worker_id || state->statuses[ helper_id ].load( std::memory_order_relaxed ) != PROCESS_IDLE ) {
+		return false;
+	}
+
+	int expected = PROCESS_IDLE;
+
+	if ( ! state->statuses[ helper_id ].compare_exchange_strong( expected, PROCESS_HELPING ) ) {
+		return false;
+	}
+
+	// The requesting worker is active itself, so the number of active workers cannot have reached 0 in the meantime
+	state->num_active.fetch_add( 1 );
+
+	return true;
+}
+
+int ThreadTransport::requestHelper() {
+	int num_workers = state->num_workers;
+
+	if ( state->help_match_policy == HELP_MATCH_NEAREST ) {
+		// The idle worker with the ID closest to that of the requesting worker
+		for ( int distance = 1; distance < num_workers; distance++ ) {
+			if ( worker_id - distance >= 0 && claimWorker( worker_id - distance ) ) {
+				return worker_id - distance;
+			}
+
+			if ( worker_id + distance < num_workers && claimWorker( worker_id + distance ) ) {
+				return worker_id + distance;
+			}
+		}
+
+		return -1;
+	}
+
+	// The first idle worker, searching from the lowest ID or, with round-robin, from after the previous helper
+	int start_index = ( state->help_match_policy == HELP_MATCH_ROUND_ROBIN ) ? state->next_index.load( std::memory_order_relaxed ) : 0;
+
+	for ( int i = 0; i < num_workers; i++ ) {
+		int index = ( start_index + i ) % num_workers;
+
+		if ( claimWorker( index ) ) {
+			state->next_index.store( ( index + 1 ) % num_workers, std::memory_order_relaxed );
+
+			return index;
+		}
+	}
+
+	return -1;
+}
+
+void ThreadTransport::sendHelpTask( int helper_id, HelpTask &task ) {
+	task.requester_id = worker_id;
+	state->mailboxes[ helper_id ].store( new HelpTask( std::move( task ) ) );
+}
+
+bool ThreadTransport::receiveHelpTask( HelpTask &task ) {
+	int sleep_time = 1;
+
+	while ( true ) {
+		HelpTask *received_task = state->mailboxes[ worker_id ].exchange( NULL );
+
+		if ( received_task != NULL ) {
+			task = std::move( *received_task );
+			delete received_task;
+
+			return true;
+		}
+
+		// A claimed worker counts as active until it completes its help task, so processing cannot be completed while
+		// a help task is on its way to this worker
+		if ( state->completed.load() ) {
+			return false;
+		}
+
+		sleepWithBackoff( sleep_time );
+	}
+}
+
+void ThreadTransport::reportDone() {
+	state->statuses[ worker_id ].store( PROCESS_IDLE );
+
+	if ( state->num_active.fetch_sub( 1 ) == 1 ) {
+		state->completed.store( true );
+	}
+}
+
+std::vector<long long> ThreadTransport::reduceResults( std::vector<long long> record ) {
+	state->records[ worker_id ] = record;
+	state->num_records.fetch_add( 1 );
+
+	// Wait for the records of all other workers
+	int sleep_time = 1;
+
+	while ( state->num_records.load() < state->num_workers ) {
+		sleepWithBackoff( sleep_time );
+	}
+
+	std::vector<long long> record_total;
+
+	if ( worker_id == 0 ) {
+		for ( const auto &worker_record : state->records ) {
+			combineResultRecords( worker_record, record_total );
+		}
+	}
+
+	return record_total;
+}
@@ -0,0 +1,144 @@
+#ifndef THREADTRANSPORT_H
+#define THREADTRANSPORT_H
+
+// Includes
+// ==========
+// STL includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Program includes
+#include "Transport.h"
+
+/**
+ * State shared by the workers of a shared-memory computation, one worker per thread. All fields used while searching
+ * are atomics, so that matching help requests and handing over help tasks never takes a lock
+ */
+class ThreadTransportState {
+	public:
+		/**
+		 * Number of workers
+		 */
+		int num_workers;
+
+		/**
+		 * Policy for choosing an idle worker to help a worker requesting help, see HELP_MATCH_* in const.h
+		 */
+		int help_match_policy;
+
+		/**
+		 * Status per worker, PROCESS_IDLE, PROCESS_RUNNING or PROCESS_HELPING
+		 */
+		std::unique_ptr<std::atomic<int>[]> statuses;
+
+		/**
+		 * Number of workers that are not idle. Reaches 0 once, when all processing is completed
+		 */
+		std::atomic<int> num_active;
+
+		/**
+		 * Help task handed over to each worker, or NULL. Tasks are handed over by pointer, so that their node lists are
+		 * never copied
+		 */
+		std::unique_ptr<std::atomic<HelpTask *>[]> mailboxes;
+
+		/**
+		 * Whether all processing is completed
+		 */
+		std::atomic<bool> completed;
+
+		/**
+		 * Index of the worker to start searching from for an idle worker, used by HELP_MATCH_ROUND_ROBIN
+		 */
+		std::atomic<int> next_index;
+
+		/**
+		 * Result record per worker, and the number of workers that stored their record
+		 */
+		std::vector<std::vector<long long> > records;
+		std::atomic<int> num_records;
+
+		/**
+		 * Constructor. All workers start running their assigned subtask
+		 *
+		 * @param int num_workers Number of workers
+		 * @param int help_match_policy Policy for choosing an idle worker, see HELP_MATCH_* in const.h
+		 */
+		ThreadTransportState( int num_workers, int help_match_policy );
+
+		/**
+		 * Destructor. Frees help tasks that were never received
+		 */
+		~ThreadTransportState();
+};
+
+/**
+ * Transport between workers running as threads in a single process, sharing their state through atomics
+ */
+class ThreadTransport : public Transport {
+	protected:
+		/**
+		 * State shared by all workers
+		 */
+		ThreadTransportState *state;
+
+		/**
+		 * ID of the worker using this transport
+		 */
+		int worker_id;
+
+		/**
+		 * Try to claim the worker with the given ID if it is idle
+		 *
+		 * @param int helper_id ID of the worker to claim
+		 * @return bool Whether the worker was idle and is now claimed
+		 */
+		bool claimWorker( int helper_id );
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param ThreadTransportState *state State shared by all workers
+		 * @param int worker_id ID of the worker using this transport
+		 */
+		ThreadTransport( ThreadTransportState *state, int worker_id ) : state(state), worker_id(worker_id) {}
+
+		/**
+		 * Claim an idle worker according to the help match policy, without locking
+		 *
+		 * @see Transport::requestHelper()
+		 */
+		int requestHelper();
+
+		/**
+		 * Hand over the help task by storing a pointer to it in the mailbox of the helping worker
+		 *
+		 * @see Transport::sendHelpTask()
+		 */
+		void sendHelpTask( int helper_id, HelpTask &task );
+
+		/**
+		 * Wait for a help task in the mailbox of this worker, sleeping with exponential backoff
+		 *
+		 * @see Transport::receiveHelpTask()
+		 */
+		bool receiveHelpTask( HelpTask &task );
+
+		/**
+		 * Mark this worker as idle, and mark all processing as completed if it was the last active worker
+		 *
+		 * @see Transport::reportDone()
+		 */
+		void reportDone();
+
+		/**
+		 * Store the result record of this worker, and wait for the records of all other workers
+		 *
+		 * @see Transport::reduceResults()
+		 */
+		std::vector<long long> reduceResults( std::vector<long long> record );
+};
+
+#endif
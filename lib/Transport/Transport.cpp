@@ -0,0 +1,23 @@
+// Includes
+// ==========
+// STL includes
+#include <algorithm>
+
+// Program includes
+#include "Transport.h"
+#include "../Process/const.h"
+
+void combineResultRecords( const std::vector<long long> &record_in, std::vector<long long> &record_inout ) {
+	if ( record_inout.size() < record_in.size() ) {
+		record_inout.resize( record_in.size(), 0 );
+	}
+
+	for ( unsigned int i = 0; i < record_in.size(); i++ ) {
+		if ( i == RESULT_BUSY_TIME_MAX ) {
+			record_inout[ i ] = std::max( record_inout[ i ], record_in[ i ] );
+		}
+		else {
+			record_inout[ i ] += record_in[ i ];
+		}
+	}
+}
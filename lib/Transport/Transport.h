@@ -0,0 +1,85 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+/**
+ * Part of a branch of the search handed over to a helping worker: the candidate nodes from start up to end of the
+ * candidate nodes of the branch
+ */
+struct HelpTask {
+	int depth;
+	std::vector<int> base_nodes;
+	std::vector<int> potential_nodes;
+	int start;
+	int end;
+
+	// ID of the worker that handed over the task, set by the transport of the receiving worker
+	int requester_id;
+
+	// Checkpoint epoch of the worker that handed over the task, if checkpointing is enabled
+	int checkpoint_epoch = 0;
+};
+
+/**
+ * Messaging between the workers taking part in the computation: help requests, handing over help tasks, signalling
+ * completion of subtasks and combining results. Implemented with MPI by ProcessSlave, and with threads in a single
+ * process by ThreadTransport
+ */
+class Transport {
+	public:
+		virtual ~Transport() {}
+
+		/**
+		 * Request help from another worker. If another worker is available, it is reserved, and the request should be
+		 * followed by handing over a help task through sendHelpTask()
+		 *
+		 * @return int ID of the helping worker, or -1 if no worker is available
+		 */
+		virtual int requestHelper() = 0;
+
+		/**
+		 * Hand over a help task to the worker reserved by requestHelper(). The task may be moved from
+		 *
+		 * @param int helper_id ID of the helping worker
+		 * @param HelpTask &task Help task
+		 */
+		virtual void sendHelpTask( int helper_id, HelpTask &task ) = 0;
+
+		/**
+		 * Wait for a help task from another worker
+		 *
+		 * @param HelpTask &task Received help task
+		 * @return bool Whether a task was received (true), or all processing is completed (false)
+		 */
+		virtual bool receiveHelpTask( HelpTask &task ) = 0;
+
+		/**
+		 * Signal that this worker has completed its initially assigned subtask or the help task it was working on, and
+		 * is available for helping other workers
+		 */
+		virtual void reportDone() = 0;
+
+		/**
+		 * Combine the result records of all workers (see RESULT_* in const.h) by summing all fields, except for the
+		 * maximum busy time. Should be called by all workers
+		 *
+		 * @param std::vector<long long> record Result record of this worker
+		 * @return std::vector<long long> Combined result record. Only valid at the first worker (the master process)
+		 */
+		virtual std::vector<long long> reduceResults( std::vector<long long> record ) = 0;
+};
+
+/**
+ * Combine two result records (see RESULT_* in const.h). All fields are summed, except for the maximum busy time of a
+ * worker. Records of different lengths are padded with zeroes
+ *
+ * @param const std::vector<long long> &record_in Input result record
+ * @param std::vector<long long> &record_inout Input and output result record
+ */
+void combineResultRecords( const std::vector<long long> &record_in, std::vector<long long> &record_inout );
+
+#endif
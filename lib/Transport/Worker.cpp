@@ -0,0 +1,140 @@
+// Includes
+// ==========
+// STL includes
+#include <algorithm>
+#include <utility>
+
+// Program includes
+#include "Worker.h"
+#include "../Process/const.h"
+#include "../Trace/Trace.h"
+
+void Worker::setCliqueFinder( CliqueFinder *cliquefinder ) {
+	this->cliquefinder = cliquefinder;
+}
+
+void Worker::setCheckpointer( Checkpointer *checkpointer ) {
+	this->checkpointer = checkpointer;
+}
+
+void Worker::findCliques() {
+	// Perform clique finding on subtask assigned to this worker
+	double start_time = pm.getCurrentClockTime();
+
+	if ( checkpointer != NULL ) {
+		checkpointer->start();
+	}
+
+	{
+		TraceScope trace_scope( "root tasks" );
+		cliquefinder->findAllCliquesDFS();
+	}
+
+	busy_time += pm.getCurrentClockTime() - start_time;
+	cliquefinder->publishProgress( true );
+
+	if ( checkpointer != NULL && ! cliquefinder->isDeadlineReached() ) {
+		checkpointer->setIdle( cliquefinder->getCheckpointSnapshot() );
+	}
+
+	// Relay that this worker has completed its subtask
+	transport->reportDone();
+
+	// Wait for help requests from other workers, and take over the part of their subtask they send, until all
+	// processing is completed
+	while ( help_enabled ) {
+		HelpTask task;
+
+		long long standby_start_time = Trace::isEnabled() ? Trace::now() : 0;
+		bool received = transport->receiveHelpTask( task );
+		Trace::record( "idle standby", standby_start_time, Trace::now() );
+
+		if ( ! received ) {
+			break;
+		}
+
+		if ( checkpointer != NULL ) {
+			checkpointer->taskReceived( task );
+		}
+
+		// Perform operations requested by other worker
+		double help_start_time = pm.getCurrentClockTime();
+
+		{
+			TraceScope trace_scope( "help", task.requester_id );
+			cliquefinder->temporarilyDisableHelp();
+			cliquefinder->beginTask();
+			cliquefinder->findCliquesDFS( task.depth, task.base_nodes, task.potential_nodes, task.start, task.end );
+			cliquefinder->endTask();
+			cliquefinder->setHelpEnabled( true );
+		}
+
+		busy_time += pm.getCurrentClockTime() - help_start_time;
+		cliquefinder->publishProgress( true );
+
+		if ( checkpointer != NULL && ! cliquefinder->isDeadlineReached() ) {
+			checkpointer->setIdle( cliquefinder->getCheckpointSnapshot() );
+		}
+
+		// Relay that the subtask this worker was helping with is done
+		transport->reportDone();
+	}
+}
+
+bool Worker::requestHelp() {
+	TraceScope trace_scope( "help request" );
+
+	helper_id = transport->requestHelper();
+
+	return helper_id >= 0;
+}
+
+void Worker::grantHelp( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int helper_start, int helper_end ) {
+	TraceScope trace_scope( "help transfer", helper_id );
+	SEARCH_STATS( cliquefinder->stats.help_bytes_sent += ( 3 + base_nodes.size() + potential_nodes.size() ) * sizeof( int ) );
+
+	HelpTask task;
+	task.depth = depth;
+	task.base_nodes = std::move( base_nodes );
+	task.potential_nodes = std::move( potential_nodes );
+	task.start = helper_start;
+	task.end = helper_end;
+
+	if ( checkpointer != NULL ) {
+		checkpointer->taskSent( task, helper_id );
+	}
+
+	transport->sendHelpTask( helper_id, task );
+}
+
+std::vector<long long> Worker::getResultRecord() {
+	std::vector<long long> cliques_counts = cliquefinder->getCliquesCountsVector();
+	std::vector<long long> record( RESULT_CLIQUE_COUNTS + cliques_counts.size(), 0 );
+
+	record[ RESULT_HELP_REQUESTS_SENT ] = cliquefinder->getNumHelpRequestsSent();
+	record[ RESULT_HELP_REQUESTS_SENT_ACCEPTED ] = cliquefinder->getNumHelpRequestsSentAccepted();
+	record[ RESULT_HELP_REQUESTS_SENT_REJECTED ] = cliquefinder->getNumHelpRequestsSentRejected();
+	record[ RESULT_BUSY_TIME_MAX ] = (long long) ( busy_time * 1000000 );
+	record[ RESULT_BUSY_TIME_TOTAL ] = (long long) ( busy_time * 1000000 );
+
+	if ( checkpointer != NULL ) {
+		record[ RESULT_CHECKPOINTS_WRITTEN ] = checkpointer->getNumWritten();
+		record[ RESULT_CHECKPOINT_TIME_TOTAL ] = (long long) ( checkpointer->getBlockedTime() * 1000000 );
+		record[ RESULT_CHECKPOINT_WRITE_TIME_TOTAL ] = (long long) ( checkpointer->getWriteTime() * 1000000 );
+	}
+
+	std::vector<long long> progress = cliquefinder->getProgressRecord();
+	record[ RESULT_DEADLINE_REACHED ] = cliquefinder->isDeadlineReached();
+	record[ RESULT_ROOTS_TOTAL ] = progress[ PROGRESS_ROOTS_TOTAL ];
+	record[ RESULT_ROOTS_COMPLETED ] = progress[ PROGRESS_ROOTS_COMPLETED ];
+	record[ RESULT_WORK_TOTAL ] = progress[ PROGRESS_WORK_TOTAL ];
+	record[ RESULT_WORK_COMPLETED ] = progress[ PROGRESS_WORK_COMPLETED ];
+
+	std::copy( cliques_counts.begin(), cliques_counts.end(), record.begin() + RESULT_CLIQUE_COUNTS );
+
+	return record;
+}
+
+double Worker::getBusyTime() {
+	return busy_time;
+}
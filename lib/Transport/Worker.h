@@ -0,0 +1,113 @@
+#ifndef WORKER_H
+#define WORKER_H
+
+// Includes
+// ==========
+// STL includes
+#include <vector>
+
+// Program includes
+#include "Transport.h"
+#include "../CliqueFinder/CliqueFinder.h"
+#include "../CliqueFinder/HelpChannel.h"
+#include "../ProgressMonitor/ProgressMonitor.h"
+#include "../Checkpoint/Checkpointer.h"
+
+/**
+ * Worker taking part in the computation: finds the cliques in its assigned subtask, hands over parts of its search to
+ * other workers on request of its clique finder, and helps other workers until all processing is completed. Messaging
+ * goes through a transport, so that the same worker runs as an MPI process and as a thread
+ */
+class Worker : public HelpChannel {
+	protected:
+		/**
+		 * Transport connecting this worker with the other workers
+		 */
+		Transport *transport;
+
+		/**
+		 * The object implementing the clique finding
+		 */
+		CliqueFinder *cliquefinder = NULL;
+
+		/**
+		 * Checkpointer recording the help tasks sent and received by this worker, and its state while it is idle, or
+		 * NULL if checkpointing is disabled
+		 */
+		Checkpointer *checkpointer = NULL;
+
+		/**
+		 * Whether this worker helps other workers after completing its assigned subtask
+		 */
+		bool help_enabled;
+
+		/**
+		 * ID of the worker currently helping or available for helping complete this worker's subtask
+		 */
+		int helper_id = -1;
+
+		/**
+		 * Time (in seconds) this worker spent finding cliques in its assigned subtask and in the subtasks it helped with
+		 */
+		double busy_time = 0;
+
+		/**
+		 * Progress monitor for measuring busy time
+		 */
+		ProgressMonitor pm;
+
+	public:
+		/**
+		 * Constructor
+		 *
+		 * @param Transport *transport Transport connecting this worker with the other workers
+		 * @param bool help_enabled Whether this worker helps other workers after completing its assigned subtask
+		 */
+		Worker( Transport *transport, bool help_enabled ) : transport(transport), help_enabled(help_enabled) {}
+
+		/**
+		 * Set the clique finder performing the search of this worker
+		 *
+		 * @param CliqueFinder *cliquefinder Clique finder
+		 */
+		void setCliqueFinder( CliqueFinder *cliquefinder );
+
+		/**
+		 * Set the checkpointer of this worker, which should also be set for its clique finder
+		 *
+		 * @param Checkpointer *checkpointer Checkpointer
+		 */
+		void setCheckpointer( Checkpointer *checkpointer );
+
+		/**
+		 * Find the cliques in the subtask assigned to this worker, and help other workers until all processing is
+		 * completed
+		 */
+		void findCliques();
+
+		/**
+		 * @see HelpChannel::requestHelp()
+		 */
+		bool requestHelp();
+
+		/**
+		 * @see HelpChannel::grantHelp()
+		 */
+		void grantHelp( int depth, std::vector<int> base_nodes, std::vector<int> potential_nodes, int helper_start, int helper_end );
+
+		/**
+		 * Get the result record of this worker (see RESULT_* in const.h)
+		 *
+		 * @return std::vector<long long> Result record
+		 */
+		std::vector<long long> getResultRecord();
+
+		/**
+		 * Get the time this worker spent finding cliques
+		 *
+		 * @return double Busy time in seconds
+		 */
+		double getBusyTime();
+};
+
+#endif
@@ -2,17 +2,29 @@
 // ==========
 // STL includes
 #include <iostream>
-#include <mpi.h>
 #include <string>
 #include <fstream>
 
+// MPI includes
+#ifndef NOMPI
+#include <mpi.h>
+#endif
+
 // Boost includes
 #include <boost/algorithm/string/join.hpp>
 
 // Program includes
 #include "lib/Process/const.h"
+#include "lib/ParallelCliques/ParallelCliques.h"
+#include "lib/ProgressMonitor/ProgressMonitor.h"
+#include "lib/Trace/Trace.h"
+#include "lib/Planner/WorkPlanner.h"
+#include "lib/Incremental/IncrementalCounter.h"
+
+#ifndef NOMPI
 #include "lib/Process/ProcessMaster.h"
 #include "lib/Process/ProcessSlave.h"
+#endif
 
 /**
  * Get command-line argument to program run.
@@ -31,6 +43,485 @@ std::string getCommandArg( std::string arg, int argc, char* argv[] ) {
 	return "";
 }
 
+/**
+ * Get the checkpoint directory from the command-line arguments. Checkpoints only cover exact clique counts, so
+ * checkpointing is disabled if the number of cliques is estimated, or if node clique counts are recorded or cliques are
+ * listed.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ * @return std::string Checkpoint directory, or empty if checkpointing is disabled
+ */
+std::string getCheckpointDir( int argc, char* argv[] ) {
+	if ( getCommandArg( "approx", argc, argv ) != "" || getCommandArg( "nodecounts", argc, argv ) != "" || getCommandArg( "cliques", argc, argv ) != "" ) {
+		return "";
+	}
+
+	return getCommandArg( "checkpoint", argc, argv );
+}
+
+/**
+ * Report that checkpointing was requested but is disabled, see getCheckpointDir().
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+void reportCheckpointingDisabled( int argc, char* argv[] ) {
+	if ( getCommandArg( "checkpoint", argc, argv ) != "" && getCheckpointDir( argc, argv ) == "" ) {
+		printf( "Checkpoints only cover exact clique counts; checkpointing is disabled with -approx, -nodecounts and -cliques.\n" );
+	}
+}
+
+/**
+ * Check whether classes of twins are collapsed into single nodes after reading the graph, from the command-line
+ * arguments. Collapsed twins are counted combinatorially, so that twins are not collapsed if node clique counts are
+ * recorded or cliques are listed.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ * @return bool Whether twins are collapsed
+ */
+bool getTwinCompression( int argc, char* argv[] ) {
+	return getCommandArg( "twins", argc, argv ) == "1" && getCommandArg( "nodecounts", argc, argv ) == "" && getCommandArg( "cliques", argc, argv ) == "";
+}
+
+/**
+ * Report that collapsing twins was requested but is disabled, see getTwinCompression().
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+void reportTwinCompressionDisabled( int argc, char* argv[] ) {
+	if ( getCommandArg( "twins", argc, argv ) == "1" && ! getTwinCompression( argc, argv ) ) {
+		printf( "Collapsed twins are only counted combinatorially; collapsing twins is disabled with -nodecounts and -cliques.\n" );
+	}
+}
+
+/**
+ * Get the order in which the nodes are renumbered after reading the graph from the command-line arguments.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ * @return int Order, see NODE_ORDER_*, or -1 for an unknown order
+ */
+int getNodeOrder( int argc, char* argv[] ) {
+	return NodeOrder::parse( getCommandArg( "order", argc, argv ) );
+}
+
+/**
+ * Apply the command-line settings of the search, which are shared by the MPI and shared-memory computations.
+ *
+ * @param Computation* computation Process or shared-memory computation
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+template <typename Computation>
+void applySearchSettings( Computation *computation, int argc, char* argv[] ) {
+	// Settings regarding dynamic load balancing
+	bool help_enabled = ( getCommandArg( "h", argc, argv ) != "0" );
+	computation->setEnableDynamicLoadBalancing( help_enabled );
+
+	if ( help_enabled ) {
+		// Help request degree threshold for requesting help from other processes
+		computation->setHelpRequestThreshold( atoi( getCommandArg( "t", argc, argv ).c_str() ) );
+
+		// Whether to adjust the help request threshold at runtime. With a root cost profile, the root tasks are balanced
+		// up front and nearly all help requests would be rejected, so that requests back off by default
+		std::string adaptive = getCommandArg( "a", argc, argv );
+		computation->setHelpRequestThresholdAdaptive( adaptive != "" ? adaptive == "1" : getCommandArg( "profile", argc, argv ) != "" );
+	}
+
+	// Policy for choosing an idle process to help a process requesting help
+	if ( getCommandArg( "p", argc, argv ) == "round-robin" ) {
+		computation->setHelpMatchPolicy( HELP_MATCH_ROUND_ROBIN );
+	}
+	else if ( getCommandArg( "p", argc, argv ) == "nearest" ) {
+		computation->setHelpMatchPolicy( HELP_MATCH_NEAREST );
+	}
+
+	// Root tasks of the search: single nodes (default) or oriented edges
+	computation->setEnableEdgeRoots( getCommandArg( "r", argc, argv ) == "edge" );
+
+	// Order in which the nodes are renumbered after reading the graph
+	computation->setNodeOrder( getNodeOrder( argc, argv ) );
+
+	// Whether classes of twins are collapsed into single nodes before the nodes are renumbered
+	computation->setTwinCompression( getTwinCompression( argc, argv ) );
+
+	// Range of clique sizes to count
+	computation->setCliqueSizeRange( atoi( getCommandArg( "kmin", argc, argv ).c_str() ), atoi( getCommandArg( "kmax", argc, argv ).c_str() ) );
+
+	// Estimation of the number of cliques by sampling root tasks, with a target relative error
+	std::string confidence = getCommandArg( "confidence", argc, argv );
+	computation->setSampling( atof( getCommandArg( "approx", argc, argv ).c_str() ), confidence != "" ? atof( confidence.c_str() ) : 0.95, atoi( getCommandArg( "seed", argc, argv ).c_str() ) );
+
+	// Listing of the cliques found, to one file per worker
+	computation->setCliqueOutput( getCommandArg( "cliques", argc, argv ), getCommandArg( "cliques-format", argc, argv ) == "text" ? CLIQUE_OUTPUT_TEXT : CLIQUE_OUTPUT_BINARY );
+
+	// Periodic checkpoints of the search, from which an interrupted search can be resumed
+	std::string checkpoint_interval = getCommandArg( "checkpoint-interval", argc, argv );
+	computation->setCheckpointing( getCheckpointDir( argc, argv ), checkpoint_interval != "" ? atof( checkpoint_interval.c_str() ) : CHECKPOINT_DEFAULT_INTERVAL, getCommandArg( "resume", argc, argv ) == "1" );
+
+	// Time budget of the search, after which the counts of the completed root tasks are reported
+	computation->setDeadline( atof( getCommandArg( "deadline", argc, argv ).c_str() ) );
+
+	// Partitioning of the root tasks by the root task costs recorded in an earlier run
+	computation->setRootProfileFileName( getCommandArg( "profile", argc, argv ) );
+
+	// Live progress lines while the search runs
+	computation->setProgressInterval( atof( getCommandArg( "progress", argc, argv ).c_str() ) );
+}
+
+/**
+ * Get the results output file name from the command-line arguments.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+std::string getResultsOutputFileName( int argc, char* argv[] ) {
+	std::string output_fname = getCommandArg( "o", argc, argv );
+
+	if ( output_fname == "1" ) {
+		output_fname = "log/log.txt";
+	}
+
+	return output_fname;
+}
+
+/**
+ * Get the node clique counts output format from the command-line arguments.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+int getNodeCountsOutputFormat( int argc, char* argv[] ) {
+	return ( getCommandArg( "nodecounts-format", argc, argv ) == "binary" ) ? NODE_COUNTS_OUTPUT_BINARY : NODE_COUNTS_OUTPUT_TSV;
+}
+
+/**
+ * Run the computation in this process only, with one worker per thread, through the parallelcliques library.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+int runCliqueCounter( int argc, char* argv[] ) {
+	ProgressMonitor pm_run;
+	bool verbose = ( getCommandArg( "v", argc, argv ) != "0" );
+	std::string trace_output_fname = getCommandArg( "trace", argc, argv );
+	std::string root_costs_output_fname = getCommandArg( "costs", argc, argv );
+	std::string node_counts_output_fname = getCommandArg( "nodecounts", argc, argv );
+
+	if ( trace_output_fname != "" ) {
+		Trace::enable();
+		Trace::setThreadName( "main" );
+		Trace::resetEpoch();
+	}
+
+	// Read graph
+	Graph graph;
+
+	{
+		TraceScope trace_scope( "graph load" );
+		ProgressMonitor pm;
+
+		std::string input_fname = getCommandArg( "f", argc, argv );
+
+		if ( input_fname == "" ) {
+			input_fname = "data/input/" + getCommandArg( "d", argc, argv ) + ".tsv";
+		}
+
+		if ( ! graph.readEdgeList( input_fname ) ) {
+			return 1;
+		}
+
+		if ( verbose ) {
+			printf( "Read graph: %d nodes, %d edges, estimated power-law exponent %.2f\n", graph.getNumNodes(), graph.getNumEdges(), graph.getPowerLawExponent() );
+			printf( "Reading graph took %.2f seconds.\n", pm.lap() );
+		}
+	}
+
+	// Count cliques
+	CliqueCounter counter;
+	counter.setNumThreads( atoi( getCommandArg( "threads", argc, argv ).c_str() ) );
+	counter.setVerbose( verbose );
+	counter.setRecordRootCosts( root_costs_output_fname != "" );
+	counter.setRecordNodeCounts( node_counts_output_fname != "" );
+	applySearchSettings( &counter, argc, argv );
+	reportCheckpointingDisabled( argc, argv );
+	reportTwinCompressionDisabled( argc, argv );
+
+	ResultsReport report = counter.countCliques( &graph );
+
+	// Report results
+	report.time_past = pm_run.stop();
+	report.verbose = verbose;
+	report.results_output_fname = getResultsOutputFileName( argc, argv );
+	report.root_costs_output_fname = root_costs_output_fname;
+	report.node_counts_output_fname = node_counts_output_fname;
+	report.node_counts_output_format = getNodeCountsOutputFormat( argc, argv );
+	report.write();
+
+	if ( trace_output_fname != "" ) {
+		Trace::writeFile( trace_output_fname, std::vector<std::string>( 1, Trace::exportEvents( 0 ) ) );
+
+		if ( verbose ) {
+			printf( "Trace written to \"%s\" (%lld events dropped).\n", trace_output_fname.c_str(), Trace::getNumDroppedEvents() );
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Estimate the work of the search and predict its running time for a range of worker counts, in this process only,
+ * without running the search.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+int runWorkPlanner( int argc, char* argv[] ) {
+	bool verbose = ( getCommandArg( "v", argc, argv ) != "0" );
+	std::string max_workers = getCommandArg( "estimate-workers", argc, argv );
+
+	// Read graph, which every worker does before the search
+	Graph graph;
+	ProgressMonitor pm;
+
+	std::string input_fname = getCommandArg( "f", argc, argv );
+
+	if ( input_fname == "" ) {
+		input_fname = "data/input/" + getCommandArg( "d", argc, argv ) + ".tsv";
+	}
+
+	if ( ! graph.readEdgeList( input_fname ) ) {
+		return 1;
+	}
+
+	if ( verbose ) {
+		printf( "Read graph: %d nodes, %d edges, estimated power-law exponent %.2f\n", graph.getNumNodes(), graph.getNumEdges(), graph.getPowerLawExponent() );
+	}
+
+	// Collapsing twins and the node order determine the graph searched and its higher-ID neighbours, and thereby the
+	// work of the search
+	if ( getTwinCompression( argc, argv ) ) {
+		TwinCompression::apply( &graph, verbose );
+	}
+
+	NodeOrder::apply( &graph, getNodeOrder( argc, argv ), verbose );
+
+	// Estimate the work of the search with the same root tasks and clique size range as the search itself
+	WorkPlanner planner( &graph );
+	planner.setGraphLoadTime( pm.lap() );
+	planner.setEdgeRoots( getCommandArg( "r", argc, argv ) == "edge" );
+	planner.setCliqueSizeRange( atoi( getCommandArg( "kmin", argc, argv ).c_str() ), atoi( getCommandArg( "kmax", argc, argv ).c_str() ) );
+	planner.estimate( atoi( getCommandArg( "seed", argc, argv ).c_str() ) );
+	planner.write( atof( getCommandArg( "estimate", argc, argv ).c_str() ), max_workers != "" ? atoi( max_workers.c_str() ) : 1024, verbose );
+
+	return 0;
+}
+
+/**
+ * Sum the clique counts of all processes at the master process. Counts of different lengths are padded with zeroes.
+ *
+ * @param std::vector<long long>& cliques_counts Number of cliques per clique size of this process, replaced by the sum
+ * of all processes at the master process
+ * @param int num_processes Number of processes
+ */
+void reduceCliquesCounts( std::vector<long long> &cliques_counts, int num_processes ) {
+#ifndef NOMPI
+	if ( num_processes == 1 ) {
+		return;
+	}
+
+	int num_sizes = cliques_counts.size();
+	int num_sizes_max;
+	MPI_Allreduce( &num_sizes, &num_sizes_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+
+	cliques_counts.resize( num_sizes_max, 0 );
+	std::vector<long long> cliques_counts_total( num_sizes_max, 0 );
+	MPI_Reduce( cliques_counts.data(), cliques_counts_total.data(), num_sizes_max, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+
+	cliques_counts = cliques_counts_total;
+#endif
+}
+
+/**
+ * Count the cliques of the graph, then keep the counts up to date under a stream of edge insertions and removals. The
+ * master process reads the updates in batches and sends them to all processes, which apply all updates but count the
+ * cliques of their own share of every batch.
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ * @param int process_id ID of this process
+ * @param int num_processes Number of processes
+ */
+int runIncremental( int argc, char* argv[], int process_id, int num_processes ) {
+	ProgressMonitor pm_run;
+	bool is_master = ( process_id == 0 );
+	bool verbose = is_master && ( getCommandArg( "v", argc, argv ) != "0" );
+	std::string updates_fname = getCommandArg( "updates", argc, argv );
+	int batch_size = std::max( atoi( getCommandArg( "batch", argc, argv ).c_str() ), 0 );
+
+	if ( batch_size == 0 ) {
+		batch_size = 256;
+	}
+
+	// Read graph
+	Graph graph;
+	std::string input_fname = getCommandArg( "f", argc, argv );
+
+	if ( input_fname == "" ) {
+		input_fname = "data/input/" + getCommandArg( "d", argc, argv ) + ".tsv";
+	}
+
+	if ( ! graph.readEdgeList( input_fname ) ) {
+		return 1;
+	}
+
+	NodeOrder::apply( &graph, getNodeOrder( argc, argv ), verbose );
+
+	// Count the cliques of the base graph
+	ProgressMonitor pm;
+	IncrementalCounter counter( &graph );
+	counter.setPartition( process_id, num_processes );
+	counter.setCliqueSizeRange( atoi( getCommandArg( "kmin", argc, argv ).c_str() ), atoi( getCommandArg( "kmax", argc, argv ).c_str() ) );
+
+	std::vector<long long> cliques_counts = counter.countCliques();
+	double busy_time = pm.getCurrentClockTime() - pm.getStartTime();
+	reduceCliquesCounts( cliques_counts, num_processes );
+
+	if ( verbose ) {
+		long long num_cliques_total = 0;
+
+		for ( long long count : cliques_counts ) {
+			num_cliques_total += count;
+		}
+
+		printf( "Base graph: %d nodes, %d edges, %lld cliques, counted in %.5f seconds\n", graph.getNumNodes(), graph.getNumEdges(), num_cliques_total, pm.lap() );
+	}
+
+	// Open the update stream at the master process
+	std::ifstream fh_updates;
+
+	if ( is_master && updates_fname != "-" ) {
+		fh_updates.open( updates_fname );
+
+		if ( ! fh_updates ) {
+			printf( "ERROR: The updates file '%s' does not exist.\n", updates_fname.c_str() );
+		}
+	}
+
+	std::istream &input = ( updates_fname == "-" ) ? std::cin : fh_updates;
+
+	// Apply updates in batches, until the stream ends
+	long long num_updates = 0;
+	long long num_ignored = 0;
+	long long num_invalid = 0;
+
+	for ( int batch = 0; ; batch++ ) {
+		std::vector<EdgeUpdate> updates;
+
+		if ( is_master && input ) {
+			num_invalid += IncrementalCounter::readUpdates( input, batch_size, updates );
+		}
+
+#ifndef NOMPI
+		// Send the batch to all processes as the operation, source and target node ID of every update
+		if ( num_processes > 1 ) {
+			int num_batch_updates = updates.size();
+			MPI_Bcast( &num_batch_updates, 1, MPI_INT, 0, MPI_COMM_WORLD );
+
+			std::vector<long long> updates_buffer( 3 * num_batch_updates );
+
+			for ( unsigned int i = 0; i < updates.size(); i++ ) {
+				updates_buffer[ 3 * i ] = updates[ i ].insert;
+				updates_buffer[ 3 * i + 1 ] = updates[ i ].node_source;
+				updates_buffer[ 3 * i + 2 ] = updates[ i ].node_target;
+			}
+
+			MPI_Bcast( updates_buffer.data(), updates_buffer.size(), MPI_LONG_LONG, 0, MPI_COMM_WORLD );
+			updates.resize( num_batch_updates );
+
+			for ( int i = 0; i < num_batch_updates; i++ ) {
+				updates[ i ].insert = updates_buffer[ 3 * i ];
+				updates[ i ].node_source = updates_buffer[ 3 * i + 1 ];
+				updates[ i ].node_target = updates_buffer[ 3 * i + 2 ];
+			}
+		}
+#endif
+
+		if ( updates.empty() ) {
+			break;
+		}
+
+		// Every process applies all updates, and counts the cliques containing the edges of its own updates
+		std::vector<long long> cliques_counts_change;
+		double batch_start_time = pm.getCurrentClockTime();
+		int num_batch_ignored = counter.applyUpdates( updates, cliques_counts_change );
+		busy_time += pm.getCurrentClockTime() - batch_start_time;
+		reduceCliquesCounts( cliques_counts_change, num_processes );
+
+		num_updates += updates.size();
+		num_ignored += num_batch_ignored;
+
+		if ( ! is_master ) {
+			continue;
+		}
+
+		long long num_cliques_change = 0;
+		cliques_counts.resize( std::max( cliques_counts.size(), cliques_counts_change.size() ), 0 );
+
+		for ( unsigned int size = 0; size < cliques_counts_change.size(); size++ ) {
+			cliques_counts[ size ] += cliques_counts_change[ size ];
+			num_cliques_change += cliques_counts_change[ size ];
+		}
+
+		if ( verbose ) {
+			double batch_time = pm.lap();
+			printf( "Batch %d: %d updates (%d ignored), %+lld cliques, %.5f milliseconds per update\n", batch, (int) updates.size(), num_batch_ignored, num_cliques_change, batch_time * 1000 / updates.size() );
+			fflush( stdout );
+		}
+	}
+
+	// Combine the time each process spent counting cliques
+	double busy_time_max = busy_time;
+	double busy_time_total = busy_time;
+
+#ifndef NOMPI
+	if ( num_processes > 1 ) {
+		MPI_Reduce( &busy_time, &busy_time_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+		MPI_Reduce( &busy_time, &busy_time_total, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+	}
+#endif
+
+	if ( ! is_master ) {
+		return 0;
+	}
+
+	if ( verbose ) {
+		printf( "Applied %lld updates (%lld ignored, %lld invalid lines skipped).\n", num_updates - num_ignored, num_ignored, num_invalid );
+	}
+
+	// Report the clique counts of the final graph
+	while ( ! cliques_counts.empty() && cliques_counts.back() == 0 ) {
+		cliques_counts.pop_back();
+	}
+
+	ResultsReport report;
+	report.record.resize( RESULT_CLIQUE_COUNTS, 0 );
+	report.record[ RESULT_BUSY_TIME_MAX ] = (long long) ( busy_time_max * 1000000 );
+	report.record[ RESULT_BUSY_TIME_TOTAL ] = (long long) ( busy_time_total * 1000000 );
+	report.record.insert( report.record.end(), cliques_counts.begin(), cliques_counts.end() );
+	report.num_processes = num_processes;
+	report.num_workers = num_processes;
+	report.time_past = pm_run.stop();
+	report.verbose = verbose;
+	report.results_output_fname = getResultsOutputFileName( argc, argv );
+	report.write();
+
+	return 0;
+}
+
 /**
  * Main program.
  *
@@ -38,6 +529,29 @@ std::string getCommandArg( std::string arg, int argc, char* argv[] ) {
  * @param char* argv[] Program call arguments
  */
 int main( int argc, char* argv[] ) {
+	// Reject unknown settings before any graph is read
+	if ( getNodeOrder( argc, argv ) == -1 ) {
+		printf( "ERROR: Unknown node order '%s'.\n", getCommandArg( "order", argc, argv ).c_str() );
+		return 1;
+	}
+
+	// Work estimation only, which runs in a single process
+	if ( getCommandArg( "estimate", argc, argv ) != "" ) {
+		return runWorkPlanner( argc, argv );
+	}
+
+	// Shared-memory computation with one worker per thread, which is the only option when built without MPI
+#ifdef NOMPI
+	if ( getCommandArg( "updates", argc, argv ) != "" ) {
+		return runIncremental( argc, argv, 0, 1 );
+	}
+
+	return runCliqueCounter( argc, argv );
+#else
+	if ( getCommandArg( "transport", argc, argv ) == "threads" ) {
+		return getCommandArg( "updates", argc, argv ) != "" ? runIncremental( argc, argv, 0, 1 ) : runCliqueCounter( argc, argv );
+	}
+
 	// Root process ID and process ID of current MPI process
 	const int root_process_id = 0;
 	int process_id;
@@ -45,11 +559,23 @@ int main( int argc, char* argv[] ) {
 	// Number of processes in use
 	int num_processes;
 
-	// Initialize MPI and fetch process ID
-	MPI_Init( &argc, &argv );
+	// Level of thread support provided by MPI
+	int thread_support;
+
+	// Initialize MPI and fetch process ID. Full thread support allows the master process to run its coordinator
+	// duties on a separate thread while taking part in the computation
+	MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &thread_support );
 	MPI_Comm_rank( MPI_COMM_WORLD, &process_id );
 	MPI_Comm_size( MPI_COMM_WORLD, &num_processes );
 
+	// Incremental clique counting under edge updates, with the updates of every batch split over the processes
+	if ( getCommandArg( "updates", argc, argv ) != "" ) {
+		int status = runIncremental( argc, argv, process_id, num_processes );
+		MPI_Finalize();
+
+		return status;
+	}
+
 	// Create process
 	Process* process;
 
@@ -72,29 +598,63 @@ int main( int argc, char* argv[] ) {
 		process->setVerbose( verbose );
 	}
 
-	// Settings regarding dynamic load balancing
-	bool help_enabled = ( getCommandArg( "h", argc, argv ) != "0" );
-	process->setEnableDynamicLoadBalancing( help_enabled );
+	// Whether the master process takes part in the computation
+	bool master_computes = ( getCommandArg( "m", argc, argv ) != "0" );
 
-	if ( help_enabled ) {
-		// Help request degree threshold for requesting help from other processes
-		int help_request_threshold = atoi( getCommandArg( "t", argc, argv ).c_str() );
-		process->setHelpRequestThreshold( help_request_threshold );
+	if ( master_computes && thread_support < MPI_THREAD_MULTIPLE ) {
+		master_computes = false;
 
-		if ( process_id == 1 && verbose ) {
-			printf( "Degree threshold: %d\n", help_request_threshold );
+		if ( process->isMaster() && verbose ) {
+			printf( "MPI_THREAD_MULTIPLE is not supported; the master process will not take part in the computation.\n" );
 		}
 	}
 
-	// Output file
-	if ( process->isMaster() ) {
-		std::string output_fname = getCommandArg( "o", argc, argv );
+	process->setMasterComputes( master_computes );
 
-		if ( output_fname == "1" ) {
-			output_fname = "log/log.txt";
+	// Mechanism for matching help requests with idle processes: through the master process (default), or through a
+	// registry in one-sided MPI memory
+	if ( getCommandArg( "b", argc, argv ) == "rma" ) {
+		process->setLoadBalancer( LOAD_BALANCER_RMA );
+	}
+
+	// Alternatively, match help requests through a broker per host, and through the master process across hosts. Host
+	// brokers run on a separate thread
+	if ( getCommandArg( "b", argc, argv ) == "host" ) {
+		if ( thread_support < MPI_THREAD_MULTIPLE ) {
+			if ( process->isMaster() && verbose ) {
+				printf( "MPI_THREAD_MULTIPLE is not supported; help requests will be matched through the master process.\n" );
+			}
 		}
+		else {
+			process->setLoadBalancer( LOAD_BALANCER_HOST );
+			process->setHostSize( atoi( getCommandArg( "H", argc, argv ).c_str() ) );
+		}
+	}
+
+	// Settings of the search
+	applySearchSettings( process, argc, argv );
+
+	if ( process_id == 1 && verbose && getCommandArg( "h", argc, argv ) != "0" ) {
+		printf( "Degree threshold: %d\n", atoi( getCommandArg( "t", argc, argv ).c_str() ) );
+	}
+
+	if ( process->isMaster() ) {
+		reportCheckpointingDisabled( argc, argv );
+		reportTwinCompressionDisabled( argc, argv );
+	}
+
+	// Output files
+	if ( process->isMaster() ) {
+		process->setResultsOutputFileName( getResultsOutputFileName( argc, argv ) );
+
+		// Trace output file
+		process->setTraceOutputFileName( getCommandArg( "trace", argc, argv ) );
+
+		// Root task costs output file
+		process->setRootCostsOutputFileName( getCommandArg( "costs", argc, argv ) );
 
-		process->setResultsOutputFileName( output_fname );
+		// Node clique counts output file
+		process->setNodeCountsOutput( getCommandArg( "nodecounts", argc, argv ), getNodeCountsOutputFormat( argc, argv ) );
 	}
 
 	// Input file path
@@ -108,4 +668,5 @@ int main( int argc, char* argv[] ) {
 	MPI_Finalize();
 
 	return 0;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Includes
+// ==========
+// STL includes
+#include <vector>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Program includes
+#include "lib/Process/const.h"
+#include "lib/Simulator/Simulator.h"
+
+/**
+ * Get command-line argument to program run.
+ *
+ * @param std::string arg Argument name (should be preceeded by a dash in the command line)
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ * @param std::string default_value Optional. Value if the argument is not given
+ */
+std::string getCommandArg( std::string arg, int argc, char* argv[], std::string default_value = "" ) {
+	for ( int i = 1; i + 1 < argc; i += 1 ) {
+		if ( argv[ i ] == "-" + arg ) {
+			return argv[ i + 1 ];
+		}
+	}
+
+	return default_value;
+}
+
+/**
+ * Split a comma-separated list of values
+ *
+ * @param std::string list Comma-separated values
+ * @return std::vector<std::string> Values
+ */
+std::vector<std::string> splitList( std::string list ) {
+	std::vector<std::string> values;
+	std::istringstream list_stream( list );
+
+	for ( std::string value; std::getline( list_stream, value, ',' ); ) {
+		values.push_back( value );
+	}
+
+	return values;
+}
+
+/**
+ * Simulate the dynamic load balancing protocol for replayed root task costs, recorded with the -costs argument of the
+ * main program, for every combination of the given settings. Lists of settings are comma-separated.
+ *
+ * Usage: simulate -f costs_file [-n num_processes] [-t thresholds] [-h help_enabled] [-l latency_us]
+ *                 [-c coordinator_time_us] [-P modulo|block|cost] [-p first|round-robin|nearest]
+ *
+ * @param int argc Number of program call arguments
+ * @param char* argv[] Program call arguments
+ */
+int main( int argc, char* argv[] ) {
+	std::vector<RootTask> roots;
+
+	if ( getCommandArg( "f", argc, argv ) == "" ) {
+		printf( "Usage: %s -f costs_file [-n num_processes] [-t thresholds] [-h help_enabled] [-l latency_us] [-c coordinator_time_us] [-P modulo|block|cost] [-p first|round-robin|nearest]\n", argv[0] );
+		return 1;
+	}
+
+	if ( ! Simulator::readRootCosts( getCommandArg( "f", argc, argv ), roots ) ) {
+		return 1;
+	}
+
+	Simulator simulator( roots );
+	simulator.setLatency( atof( getCommandArg( "l", argc, argv, "5" ).c_str() ) / 1000000 );
+	simulator.setCoordinatorTime( atof( getCommandArg( "c", argc, argv, "1" ).c_str() ) / 1000000 );
+
+	printf( "processes\tthreshold\thelp\tpartitioner\tpolicy\tmakespan\tspeedup\tefficiency\tsent\taccepted\trejected\tbusy_max\tbusy_avg\tevents\tsimulation_time\n" );
+
+	for ( std::string num_processes : splitList( getCommandArg( "n", argc, argv, "1,2,4,8,16,32,64,128,256,512,1024" ) ) ) {
+		for ( std::string threshold : splitList( getCommandArg( "t", argc, argv, "10" ) ) ) {
+			for ( std::string help_enabled : splitList( getCommandArg( "h", argc, argv, "1" ) ) ) {
+				for ( std::string partitioner : splitList( getCommandArg( "P", argc, argv, "modulo" ) ) ) {
+					for ( std::string policy : splitList( getCommandArg( "p", argc, argv, "first" ) ) ) {
+						simulator.setNumProcesses( atoi( num_processes.c_str() ) );
+						simulator.setHelpRequestThreshold( atoi( threshold.c_str() ) );
+						simulator.setHelpEnabled( help_enabled != "0" );
+						simulator.setPartitioner( partitioner == "block" ? PARTITION_BLOCK : ( partitioner == "cost" ? PARTITION_COST : PARTITION_MODULO ) );
+						simulator.setHelpMatchPolicy( policy == "round-robin" ? HELP_MATCH_ROUND_ROBIN : ( policy == "nearest" ? HELP_MATCH_NEAREST : HELP_MATCH_FIRST ) );
+
+						auto start = std::chrono::steady_clock::now();
+						SimulationResult result = simulator.run();
+						double simulation_time = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+						double speedup = result.total_cost / result.makespan;
+
+						printf( "%s\t%s\t%s\t%s\t%s\t%.6f\t%.2f\t%.3f\t%lld\t%lld\t%lld\t%.6f\t%.6f\t%lld\t%.3f\n", num_processes.c_str(), threshold.c_str(), help_enabled.c_str(), partitioner.c_str(), policy.c_str(), result.makespan, speedup, speedup / atoi( num_processes.c_str() ), result.num_help_requests_sent, result.num_help_requests_sent_accepted, result.num_help_requests_sent_rejected, result.busy_time_max, result.busy_time_average, result.num_events, simulation_time );
+					}
+				}
+			}
+		}
+	}
+
+	return 0;
+}